@@ -0,0 +1,137 @@
+/*
+ * Copyright 2013-2020 Real Logic Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "benchlet.h"
+#include "sbec.h"
+
+#define MAX_ELEMENTS (4 * 1024)
+
+class ByteOrderViewBench : public Benchmark
+{
+public:
+    virtual void setUp(void)
+    {
+        encoded_ = static_cast<char *>(malloc(MAX_ELEMENTS * sizeof(uint64_t)));
+        decoded_ = static_cast<char *>(malloc(MAX_ELEMENTS * sizeof(uint64_t)));
+
+        for (uint64_t i = 0; i < MAX_ELEMENTS * sizeof(uint64_t); i++)
+        {
+            encoded_[i] = static_cast<char>(i * 7);
+        }
+
+        std::cout << "ELEMENTS = " << MAX_ELEMENTS << " [per run]" << std::endl;
+    };
+
+    virtual void tearDown(void)
+    {
+        free(encoded_);
+        free(decoded_);
+    };
+
+    template<typename T, typename View>
+    View view(void)
+    {
+        View view;
+        view.data = encoded_;
+        view.length = MAX_ELEMENTS * sizeof(uint64_t) / sizeof(T);
+        return view;
+    }
+
+    template<typename T>
+    T *decoded(void)
+    {
+        return reinterpret_cast<T *>(decoded_);
+    }
+
+    template<typename T>
+    static T byteSwap(T value);
+
+    // one element at a time, as the range views did before bulk swapping
+    template<typename T>
+    void scalarGetRange(const void *src, T *dst, uint64_t len)
+    {
+        for (uint64_t i = 0; i < len; i++)
+        {
+            T tmp;
+            memcpy(&tmp, static_cast<const T *>(src) + i, sizeof(tmp));
+            dst[i] = byteSwap(tmp);
+        }
+    }
+
+    char *encoded_;
+    char *decoded_;
+};
+
+template<>
+uint16_t ByteOrderViewBench::byteSwap(uint16_t value)
+{
+    return SBE_BIG_ENDIAN_ENCODE_16(value);
+}
+
+template<>
+uint32_t ByteOrderViewBench::byteSwap(uint32_t value)
+{
+    return SBE_BIG_ENDIAN_ENCODE_32(value);
+}
+
+template<>
+uint64_t ByteOrderViewBench::byteSwap(uint64_t value)
+{
+    return SBE_BIG_ENDIAN_ENCODE_64(value);
+}
+
+static struct Benchmark::Config cfg[] = {
+    { Benchmark::ITERATIONS, "100000" },
+    { Benchmark::BATCHES, "20" }
+};
+
+BENCHMARK_CONFIG(ByteOrderViewBench, RunScalarGetRange16, cfg)
+{
+    scalarGetRange(encoded_, decoded<uint16_t>(), MAX_ELEMENTS * 4);
+}
+
+BENCHMARK_CONFIG(ByteOrderViewBench, RunBulkGetRange16, cfg)
+{
+    sbe_uint16_view_be_get_range_unsafe(
+        view<uint16_t, sbe_uint16_view_be>(), decoded<uint16_t>(), 0, MAX_ELEMENTS * 4);
+}
+
+BENCHMARK_CONFIG(ByteOrderViewBench, RunScalarGetRange32, cfg)
+{
+    scalarGetRange(encoded_, decoded<uint32_t>(), MAX_ELEMENTS * 2);
+}
+
+BENCHMARK_CONFIG(ByteOrderViewBench, RunBulkGetRange32, cfg)
+{
+    sbe_uint32_view_be_get_range_unsafe(
+        view<uint32_t, sbe_uint32_view_be>(), decoded<uint32_t>(), 0, MAX_ELEMENTS * 2);
+}
+
+BENCHMARK_CONFIG(ByteOrderViewBench, RunScalarGetRange64, cfg)
+{
+    scalarGetRange(encoded_, decoded<uint64_t>(), MAX_ELEMENTS);
+}
+
+BENCHMARK_CONFIG(ByteOrderViewBench, RunBulkGetRange64, cfg)
+{
+    sbe_uint64_view_be_get_range_unsafe(
+        view<uint64_t, sbe_uint64_view_be>(), decoded<uint64_t>(), 0, MAX_ELEMENTS);
+}
+
+BENCHMARK_CONFIG(ByteOrderViewBench, RunBulkSetRange64, cfg)
+{
+    sbe_uint64_view_be_set_range_unsafe(
+        view<uint64_t, sbe_uint64_view_be>(), decoded<uint64_t>(), 0, MAX_ELEMENTS);
+}
@@ -23,6 +23,7 @@
 #include "baseline/baseline_cpp.h"
 
 #include "otf/IrDecoder.h"
+#include "otf/EnumIndex.h"
 #include "otf/OtfHeaderDecoder.h"
 #include "otf/OtfMessageDecoder.h"
 
@@ -178,37 +179,22 @@ public:
         std::uint64_t actingVersion)
     {
         const Token& typeToken = tokens.at(fromIndex + 1);
-        const Encoding& encoding = typeToken.encoding();
+        const EnumIndex *enumIndex = tokens.at(fromIndex).enumIndex();
 
         printScope();
         std::cout << fieldToken.name() << "=";
 
-        for (size_t i = fromIndex + 1; i < toIndex; i++)
+        if (typeToken.isConstantEncoding())
         {
-            const Token &token = tokens.at(i);
-            const PrimitiveValue constValue = token.encoding().constValue();
-
-            if (typeToken.isConstantEncoding())
-            {
-                std::cout << token.name();
-                break;
-            }
+            std::cout << typeToken.name();
+        }
+        else if (nullptr != enumIndex)
+        {
+            const Token *validValue = enumIndex->find(tokens, buffer);
 
-            if (encoding.primitiveType() == PrimitiveType::CHAR)
+            if (nullptr != validValue)
             {
-                if (encoding.getAsInt(buffer) == constValue.getAsInt())
-                {
-                    std::cout << token.name();
-                    break;
-                }
-            }
-            else if (encoding.primitiveType() == PrimitiveType::UINT8)
-            {
-                if (encoding.getAsUInt(buffer) == constValue.getAsUInt())
-                {
-                    std::cout << token.name();
-                    break;
-                }
+                std::cout << validValue->name();
             }
         }
 
@@ -0,0 +1,246 @@
+/*
+ * Copyright 2013-2020 Real Logic Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _OTF_BITSETDECODER_H
+#define _OTF_BITSETDECODER_H
+
+#include <cstdint>
+#include <vector>
+#include <stdexcept>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+#include "Token.h"
+
+namespace sbe { namespace otf {
+
+/*
+ * Decodes every choice of a set at once, given the tokens and indices passed to onBitSet.
+ *
+ * The result of choiceMask has bit i set when the ith choice is non zero. When every choice is a single bit, as they
+ * are in sets without lsb/msb bit fields, this is a PEXT on BMI2 builds when the choices are in ascending bit order and
+ * otherwise an OR of one lookup per byte of the set holding a choice. encode is the inverse, a PDEP on BMI2 builds.
+ */
+class BitSetDecoder
+{
+public:
+    BitSetDecoder(const std::vector<Token>& tokens, std::size_t fromIndex, std::size_t toIndex) :
+        m_encoding(tokens.at(fromIndex).encoding()),
+        m_choiceBits(0),
+        m_isSingleBit(true),
+        m_isAscending(true)
+    {
+        for (std::size_t i = fromIndex + 1; i < toIndex; i++)
+        {
+            const Token& token = tokens.at(i);
+
+            if (Signal::CHOICE == token.signal())
+            {
+                m_choices.push_back(&token);
+            }
+        }
+
+        if (m_choices.size() > 64)
+        {
+            throw std::runtime_error("set has more than 64 choices");
+        }
+
+        std::int64_t lastBit = -1;
+
+        for (std::size_t i = 0; i < m_choices.size(); i++)
+        {
+            const Encoding& encoding = m_choices[i]->encoding();
+            const std::uint64_t bit = UINT64_C(1) << encoding.bitShift();
+
+            if (1 != encoding.bitLength() || 0 != (m_choiceBits & bit))
+            {
+                m_isSingleBit = false;
+                break;
+            }
+
+            if (static_cast<std::int64_t>(encoding.bitShift()) < lastBit)
+            {
+                m_isAscending = false;
+            }
+
+            lastBit = encoding.bitShift();
+            m_choiceBits |= bit;
+        }
+
+        if (m_isSingleBit)
+        {
+            buildByteTables();
+        }
+    }
+
+    inline std::size_t choiceCount() const
+    {
+        return m_choices.size();
+    }
+
+    inline const Token& choiceToken(std::size_t index) const
+    {
+        return *m_choices[index];
+    }
+
+    inline bool isSingleBit() const
+    {
+        return m_isSingleBit;
+    }
+
+    /// Read the encoded set from the buffer in the byte order of the set.
+    inline std::uint64_t getEncodedValue(const char *buffer) const
+    {
+        return m_encoding.getAsUInt(buffer);
+    }
+
+    /// Bit i of the result is set when the ith choice of the set is non zero.
+    std::uint64_t choiceMask(std::uint64_t encodedValue) const
+    {
+#if defined(__BMI2__)
+        if (m_isSingleBit && m_isAscending)
+        {
+            return _pext_u64(encodedValue, m_choiceBits);
+        }
+#endif
+        std::uint64_t mask = 0;
+
+        if (m_isSingleBit)
+        {
+            for (std::size_t i = 0; i < m_byteTables.size(); i++)
+            {
+                const ByteTable& table = m_byteTables[i];
+                mask |= table.choices[(encodedValue >> table.shift) & 0xFF];
+            }
+        }
+        else
+        {
+            for (std::size_t i = 0; i < m_choices.size(); i++)
+            {
+                if (0 != m_choices[i]->encoding().getBits(encodedValue))
+                {
+                    mask |= UINT64_C(1) << i;
+                }
+            }
+        }
+
+        return mask;
+    }
+
+    inline std::uint64_t choiceMask(const char *buffer) const
+    {
+        return choiceMask(getEncodedValue(buffer));
+    }
+
+    /// Store the value of each choice, in choice order, into values which must hold choiceCount elements.
+    void decode(std::uint64_t encodedValue, std::uint64_t *values) const
+    {
+        if (m_isSingleBit)
+        {
+            const std::uint64_t mask = choiceMask(encodedValue);
+
+            for (std::size_t i = 0; i < m_choices.size(); i++)
+            {
+                values[i] = (mask >> i) & 1u;
+            }
+        }
+        else
+        {
+            for (std::size_t i = 0; i < m_choices.size(); i++)
+            {
+                values[i] = m_choices[i]->encoding().getBits(encodedValue);
+            }
+        }
+    }
+
+    /// Inverse of choiceMask for sets of single bit choices.
+    std::uint64_t encode(std::uint64_t choiceMask) const
+    {
+        if (!m_isSingleBit)
+        {
+            throw std::runtime_error("encode requires a set of single bit choices");
+        }
+
+#if defined(__BMI2__)
+        if (m_isAscending)
+        {
+            return _pdep_u64(choiceMask, m_choiceBits);
+        }
+#endif
+        std::uint64_t encodedValue = 0;
+
+        for (std::size_t i = 0; i < m_choices.size(); i++)
+        {
+            if (0 != ((choiceMask >> i) & 1u))
+            {
+                encodedValue |= UINT64_C(1) << m_choices[i]->encoding().bitShift();
+            }
+        }
+
+        return encodedValue;
+    }
+
+private:
+    struct ByteTable
+    {
+        std::uint32_t shift;
+        std::uint64_t choices[256];
+    };
+
+    const Encoding& m_encoding;
+    std::vector<const Token *> m_choices;
+    std::vector<ByteTable> m_byteTables;
+    std::uint64_t m_choiceBits;
+    bool m_isSingleBit;
+    bool m_isAscending;
+
+    void buildByteTables()
+    {
+        for (std::uint32_t shift = 0; shift < 64; shift += 8)
+        {
+            if (0 == ((m_choiceBits >> shift) & 0xFF))
+            {
+                continue;
+            }
+
+            ByteTable table;
+            table.shift = shift;
+
+            for (std::uint32_t byte = 0; byte < 256; byte++)
+            {
+                const std::uint64_t encodedValue = static_cast<std::uint64_t>(byte) << shift;
+                std::uint64_t mask = 0;
+
+                for (std::size_t i = 0; i < m_choices.size(); i++)
+                {
+                    if (0 != ((encodedValue >> m_choices[i]->encoding().bitShift()) & 1u))
+                    {
+                        mask |= UINT64_C(1) << i;
+                    }
+                }
+
+                table.choices[byte] = mask;
+            }
+
+            m_byteTables.push_back(table);
+        }
+    }
+};
+
+}}
+
+#endif
@@ -0,0 +1,884 @@
+/*
+ * Copyright 2013-2020 Real Logic Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _OTF_COLUMNAREXPORTER_H
+#define _OTF_COLUMNAREXPORTER_H
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "DecodePlan.h"
+#include "OtfMessageDecoder.h"
+#include "OtfStreamDecoder.h"
+
+namespace sbe { namespace otf {
+
+/// Physical layout of a Column
+enum ColumnLayout
+{
+    /// Fixed width values, arrayLength elements of the primitive type per row (Arrow primitive, FixedSizeList or
+    /// FixedSizeBinary for char arrays).
+        COLUMN_FIXED_WIDTH = 0,
+    /// Variable length bytes per row delimited by rowCount + 1 offsets (Arrow LargeBinary).
+        COLUMN_BINARY = 1
+};
+
+/*
+ * A contiguous column of values in the Arrow in memory layout. Values are in native byte order, the buffer is 8 byte
+ * aligned, and rows are null when they have a clear bit in the validity bitmap (least significant bit first). The
+ * bitmap is only materialised once the first null is appended, until then validity() is nullptr as all rows are valid.
+ */
+class Column
+{
+public:
+    Column(
+        std::string name,
+        PrimitiveType primitiveType,
+        ColumnLayout layout,
+        std::size_t arrayLength) :
+        m_name(std::move(name)),
+        m_primitiveType(primitiveType),
+        m_layout(layout),
+        m_arrayLength(arrayLength),
+        m_valueWidth(lengthOfType(primitiveType) * arrayLength),
+        m_valuesLength(0),
+        m_rowCount(0),
+        m_nullCount(0)
+    {
+        if (COLUMN_BINARY == m_layout)
+        {
+            m_offsets.push_back(0);
+        }
+    }
+
+    inline const std::string& name() const
+    {
+        return m_name;
+    }
+
+    inline PrimitiveType primitiveType() const
+    {
+        return m_primitiveType;
+    }
+
+    inline ColumnLayout layout() const
+    {
+        return m_layout;
+    }
+
+    /// Number of primitive elements in each row of a COLUMN_FIXED_WIDTH column.
+    inline std::size_t arrayLength() const
+    {
+        return m_arrayLength;
+    }
+
+    /// Bytes in each row of a COLUMN_FIXED_WIDTH column.
+    inline std::size_t valueWidth() const
+    {
+        return m_valueWidth;
+    }
+
+    inline std::size_t rowCount() const
+    {
+        return m_rowCount;
+    }
+
+    inline std::size_t nullCount() const
+    {
+        return m_nullCount;
+    }
+
+    inline const std::uint8_t *data() const
+    {
+        return reinterpret_cast<const std::uint8_t *>(m_values.data());
+    }
+
+    inline std::size_t dataLength() const
+    {
+        return m_valuesLength;
+    }
+
+    template<typename T>
+    inline const T *values() const
+    {
+        return reinterpret_cast<const T *>(m_values.data());
+    }
+
+    /// rowCount + 1 offsets into data() for a COLUMN_BINARY column.
+    inline const std::int64_t *offsets() const
+    {
+        return m_offsets.data();
+    }
+
+    inline const std::uint8_t *validity() const
+    {
+        return 0 == m_nullCount ? nullptr : m_validity.data();
+    }
+
+    inline bool isNull(std::size_t row) const
+    {
+        return 0 != m_nullCount && 0 == (m_validity[row >> 3] & (1u << (row & 7)));
+    }
+
+private:
+    friend class ColumnarExporter;
+
+    std::string m_name;
+    PrimitiveType m_primitiveType;
+    ColumnLayout m_layout;
+    std::size_t m_arrayLength;
+    std::size_t m_valueWidth;
+    std::vector<std::uint64_t> m_values;
+    std::size_t m_valuesLength;
+    std::vector<std::int64_t> m_offsets;
+    std::vector<std::uint8_t> m_validity;
+    std::size_t m_rowCount;
+    std::size_t m_nullCount;
+
+    std::uint8_t *appendValues(std::size_t length)
+    {
+        const std::size_t newLength = m_valuesLength + length;
+        const std::size_t words = (newLength + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+        if (words > m_values.size())
+        {
+            m_values.resize(words > m_values.size() * 2 ? words : m_values.size() * 2);
+        }
+
+        std::uint8_t *values = reinterpret_cast<std::uint8_t *>(m_values.data()) + m_valuesLength;
+        m_valuesLength = newLength;
+
+        return values;
+    }
+
+    void appendValidity(bool isValid)
+    {
+        if (isValid && 0 == m_nullCount)
+        {
+            m_rowCount++;
+            return;
+        }
+
+        if (0 == m_nullCount)
+        {
+            m_validity.assign((m_rowCount >> 3) + 1, 0xFF);
+        }
+        else if ((m_rowCount >> 3) >= m_validity.size())
+        {
+            m_validity.push_back(0);
+        }
+
+        std::uint8_t& bits = m_validity[m_rowCount >> 3];
+        const std::uint8_t mask = static_cast<std::uint8_t>(1u << (m_rowCount & 7));
+
+        if (isValid)
+        {
+            bits |= mask;
+        }
+        else
+        {
+            bits &= static_cast<std::uint8_t>(~mask);
+            m_nullCount++;
+        }
+
+        m_rowCount++;
+    }
+
+    void clear()
+    {
+        m_valuesLength = 0;
+        m_rowCount = 0;
+        m_nullCount = 0;
+        m_validity.clear();
+
+        if (COLUMN_BINARY == m_layout)
+        {
+            m_offsets.resize(1);
+        }
+    }
+};
+
+/*
+ * The columns for the fields of a message, or of the elements of a repeating group. A group table has one row per
+ * element and parentRowIndices() gives the row of the enclosing table each element belongs to.
+ */
+class ColumnTable
+{
+public:
+    ColumnTable(std::string name, std::int32_t parentTableIndex) :
+        m_name(std::move(name)),
+        m_parentTableIndex(parentTableIndex),
+        m_rowCount(0),
+        m_isFixedLength(true)
+    {
+    }
+
+    /// Message name, or the dotted path of a group from the message, e.g. "performanceFigures.acceleration".
+    inline const std::string& name() const
+    {
+        return m_name;
+    }
+
+    /// Index of the enclosing table, or -1 for the message table.
+    inline std::int32_t parentTableIndex() const
+    {
+        return m_parentTableIndex;
+    }
+
+    inline std::size_t rowCount() const
+    {
+        return m_rowCount;
+    }
+
+    inline const std::vector<Column>& columns() const
+    {
+        return m_columns;
+    }
+
+    /// Column by field name, with composite members as "composite.member", or nullptr if there is none.
+    const Column *column(const std::string& name) const
+    {
+        for (std::vector<Column>::const_iterator it = m_columns.begin(); it != m_columns.end(); ++it)
+        {
+            if (it->name() == name)
+            {
+                return &*it;
+            }
+        }
+
+        return nullptr;
+    }
+
+    inline const std::vector<std::int64_t>& parentRowIndices() const
+    {
+        return m_parentRowIndices;
+    }
+
+private:
+    friend class ColumnarExporter;
+
+    struct FieldBinding
+    {
+        std::size_t columnIndex;
+        std::uint32_t offset;
+        std::uint32_t width;
+        std::uint32_t elementSize;
+        std::int32_t version;
+        ByteOrder byteOrder;
+        bool isFloatingPoint;
+        bool isNullable;
+        std::uint64_t nullValue;
+    };
+
+    struct StructureBinding
+    {
+        std::uint32_t instructionIndex;
+        std::size_t index;
+    };
+
+    std::string m_name;
+    std::int32_t m_parentTableIndex;
+    std::size_t m_rowCount;
+    bool m_isFixedLength;
+    std::vector<Column> m_columns;
+    std::vector<std::int64_t> m_parentRowIndices;
+    std::vector<FieldBinding> m_fields;
+    std::vector<StructureBinding> m_structure;
+};
+
+/*
+ * Appends messages of a single template to typed columns, one per primitive field, enum, set, and var data element,
+ * copying values straight from the buffer using the offsets of a DecodePlan. Each repeating group has its own table.
+ *
+ * The extent of each message is checked before anything is appended so the tables always hold whole messages. Groups
+ * of fixed length elements are appended a column at a time. Fields absent from the acting version are null, as are
+ * optional scalar fields holding their null value.
+ */
+class ColumnarExporter
+{
+public:
+    explicit ColumnarExporter(const DecodePlan& plan) :
+        m_plan(plan)
+    {
+        const std::vector<DecodeInstruction>& instructions = m_plan.instructions();
+
+        m_tables.push_back(ColumnTable(m_plan.beginMessageToken().name(), -1));
+        compileTable(0, 0, instructions.size(), "");
+    }
+
+    inline const DecodePlan& plan() const
+    {
+        return m_plan;
+    }
+
+    /// Message table at index 0 followed by a table for each group in schema order.
+    inline const std::vector<ColumnTable>& tables() const
+    {
+        return m_tables;
+    }
+
+    /// Table by message name or group path, or nullptr if there is none.
+    const ColumnTable *table(const std::string& name) const
+    {
+        for (std::vector<ColumnTable>::const_iterator it = m_tables.begin(); it != m_tables.end(); ++it)
+        {
+            if (it->name() == name)
+            {
+                return &*it;
+            }
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * Append one message as a row of the message table. Returns the length of the message.
+     */
+    std::size_t append(
+        const char *buffer,
+        const std::size_t length,
+        std::uint64_t actingVersion,
+        std::size_t blockLength)
+    {
+        std::size_t messageLength = 0;
+
+        if (!OtfMessageDecoder::encodedLength(buffer, length, actingVersion, blockLength, m_plan, messageLength))
+        {
+            throw std::runtime_error("length too short for message");
+        }
+
+        appendBlock(0, buffer, 0, blockLength, actingVersion, -1);
+
+        return messageLength;
+    }
+
+    /// Remove all rows, retaining the memory of the columns for the next batch.
+    void clear()
+    {
+        for (std::vector<ColumnTable>::iterator table = m_tables.begin(); table != m_tables.end(); ++table)
+        {
+            table->m_rowCount = 0;
+            table->m_parentRowIndices.clear();
+
+            for (std::vector<Column>::iterator column = table->m_columns.begin(); column != table->m_columns.end(); ++column)
+            {
+                column->clear();
+            }
+        }
+    }
+
+private:
+    const DecodePlan m_plan;
+    std::vector<ColumnTable> m_tables;
+
+    std::string compositeName(const DecodeInstruction& instruction, bool isCompositeMember) const
+    {
+        const std::vector<Token>& tokens = m_plan.tokens();
+
+        return tokens[isCompositeMember ? instruction.typeTokenIndex : instruction.fieldTokenIndex].name();
+    }
+
+    void addField(std::size_t tableIndex, const DecodeInstruction& instruction, const std::string& name)
+    {
+        const std::vector<Token>& tokens = m_plan.tokens();
+        const Token& fieldToken = tokens[instruction.fieldTokenIndex];
+        const Token& typeToken = tokens[instruction.typeTokenIndex];
+        const Encoding& encoding = typeToken.encoding();
+        const std::size_t elementSize = lengthOfType(encoding.primitiveType());
+
+        if (Presence::SBE_CONSTANT == encoding.presence() || fieldToken.isConstantEncoding() ||
+            0 == elementSize || typeToken.encodedLength() <= 0)
+        {
+            return;
+        }
+
+        ColumnTable& table = m_tables[tableIndex];
+        const std::size_t arrayLength = static_cast<std::size_t>(typeToken.encodedLength()) / elementSize;
+
+        ColumnTable::FieldBinding binding = {};
+        binding.columnIndex = table.m_columns.size();
+        binding.offset = instruction.offset;
+        binding.width = static_cast<std::uint32_t>(elementSize * arrayLength);
+        binding.elementSize = static_cast<std::uint32_t>(elementSize);
+        binding.version = fieldToken.tokenVersion() > typeToken.tokenVersion() ?
+            fieldToken.tokenVersion() : typeToken.tokenVersion();
+        binding.byteOrder = encoding.byteOrder();
+        binding.isFloatingPoint = Encoding::isDouble(encoding.primitiveType());
+        binding.isNullable = Presence::SBE_OPTIONAL == encoding.presence() && 1 == arrayLength;
+        binding.nullValue = binding.isNullable ? nativeNullValue(encoding) : 0;
+
+        table.m_columns.push_back(Column(name, encoding.primitiveType(), COLUMN_FIXED_WIDTH, arrayLength));
+        table.m_fields.push_back(binding);
+    }
+
+    static std::uint64_t nativeNullValue(const Encoding& encoding)
+    {
+        const PrimitiveValue& nullValue = encoding.nullValue();
+        std::uint64_t value = 0;
+
+        if (PrimitiveType::NONE == nullValue.primitiveType())
+        {
+            return value;
+        }
+
+        switch (encoding.primitiveType())
+        {
+            case PrimitiveType::CHAR:
+            case PrimitiveType::INT8:
+            {
+                const std::int8_t typed = static_cast<std::int8_t>(nullValue.getAsInt());
+                std::memcpy(&value, &typed, sizeof(typed));
+                break;
+            }
+
+            case PrimitiveType::INT16:
+            {
+                const std::int16_t typed = static_cast<std::int16_t>(nullValue.getAsInt());
+                std::memcpy(&value, &typed, sizeof(typed));
+                break;
+            }
+
+            case PrimitiveType::INT32:
+            {
+                const std::int32_t typed = static_cast<std::int32_t>(nullValue.getAsInt());
+                std::memcpy(&value, &typed, sizeof(typed));
+                break;
+            }
+
+            case PrimitiveType::INT64:
+            {
+                const std::int64_t typed = nullValue.getAsInt();
+                std::memcpy(&value, &typed, sizeof(typed));
+                break;
+            }
+
+            case PrimitiveType::UINT8:
+            {
+                const std::uint8_t typed = static_cast<std::uint8_t>(nullValue.getAsUInt());
+                std::memcpy(&value, &typed, sizeof(typed));
+                break;
+            }
+
+            case PrimitiveType::UINT16:
+            {
+                const std::uint16_t typed = static_cast<std::uint16_t>(nullValue.getAsUInt());
+                std::memcpy(&value, &typed, sizeof(typed));
+                break;
+            }
+
+            case PrimitiveType::UINT32:
+            {
+                const std::uint32_t typed = static_cast<std::uint32_t>(nullValue.getAsUInt());
+                std::memcpy(&value, &typed, sizeof(typed));
+                break;
+            }
+
+            case PrimitiveType::UINT64:
+                value = nullValue.getAsUInt();
+                break;
+
+            default:
+                break;
+        }
+
+        return value;
+    }
+
+    void compileTable(std::size_t tableIndex, std::size_t index, std::size_t end, const std::string& prefix)
+    {
+        const std::vector<DecodeInstruction>& instructions = m_plan.instructions();
+        const std::vector<Token>& tokens = m_plan.tokens();
+        std::vector<std::string> compositeNames;
+
+        while (index < end)
+        {
+            const DecodeInstruction& instruction = instructions[index];
+            const std::string fieldPrefix = compositeNames.empty() ? std::string() : compositeNames.back() + ".";
+
+            switch (instruction.opCode)
+            {
+                case OP_ENCODING:
+                case OP_ENUM:
+                case OP_SET:
+                    addField(
+                        tableIndex,
+                        instruction,
+                        fieldPrefix + tokens[compositeNames.empty() ?
+                            instruction.fieldTokenIndex : instruction.typeTokenIndex].name());
+                    break;
+
+                case OP_BEGIN_COMPOSITE:
+                    compositeNames.push_back(
+                        fieldPrefix + compositeName(instruction, instruction.fieldTokenIndex + 1u != instruction.typeTokenIndex));
+                    break;
+
+                case OP_END_COMPOSITE:
+                    compositeNames.pop_back();
+                    break;
+
+                case OP_GROUP:
+                {
+                    const std::string path = prefix + tokens[instruction.fieldTokenIndex].name();
+                    const std::size_t childIndex = m_tables.size();
+
+                    m_tables.push_back(ColumnTable(path, static_cast<std::int32_t>(tableIndex)));
+                    m_tables[tableIndex].m_isFixedLength = false;
+                    m_tables[tableIndex].m_structure.push_back({ static_cast<std::uint32_t>(index), childIndex });
+                    compileTable(childIndex, index + 1, instruction.next, path + ".");
+
+                    index = instruction.next;
+                    continue;
+                }
+
+                case OP_VAR_DATA:
+                {
+                    ColumnTable& table = m_tables[tableIndex];
+                    const Token& dataToken = tokens[instruction.typeTokenIndex];
+
+                    table.m_isFixedLength = false;
+                    table.m_structure.push_back({ static_cast<std::uint32_t>(index), table.m_columns.size() });
+                    table.m_columns.push_back(Column(
+                        tokens[instruction.fieldTokenIndex].name(),
+                        dataToken.encoding().primitiveType(),
+                        COLUMN_BINARY,
+                        1));
+                    break;
+                }
+
+                default:
+                    break;
+            }
+
+            index++;
+        }
+    }
+
+    static inline void copyToNative(
+        std::uint8_t *dst, const char *src, std::uint32_t width, std::uint32_t elementSize, ByteOrder byteOrder)
+    {
+        switch (elementSize)
+        {
+            case 2:
+                for (std::uint32_t i = 0; i < width; i += 2)
+                {
+                    std::uint16_t value;
+                    std::memcpy(&value, src + i, sizeof(value));
+                    value = SBE_OTF_BYTE_ORDER_16(byteOrder, value);
+                    std::memcpy(dst + i, &value, sizeof(value));
+                }
+                break;
+
+            case 4:
+                for (std::uint32_t i = 0; i < width; i += 4)
+                {
+                    std::uint32_t value;
+                    std::memcpy(&value, src + i, sizeof(value));
+                    value = SBE_OTF_BYTE_ORDER_32(byteOrder, value);
+                    std::memcpy(dst + i, &value, sizeof(value));
+                }
+                break;
+
+            case 8:
+                for (std::uint32_t i = 0; i < width; i += 8)
+                {
+                    std::uint64_t value;
+                    std::memcpy(&value, src + i, sizeof(value));
+                    value = SBE_OTF_BYTE_ORDER_64(byteOrder, value);
+                    std::memcpy(dst + i, &value, sizeof(value));
+                }
+                break;
+
+            default:
+                std::memcpy(dst, src, width);
+                break;
+        }
+    }
+
+    static inline bool isNullValue(const ColumnTable::FieldBinding& field, const std::uint8_t *value)
+    {
+        if (field.isFloatingPoint)
+        {
+            if (4 == field.elementSize)
+            {
+                float fp;
+                std::memcpy(&fp, value, sizeof(fp));
+                return std::isnan(fp);
+            }
+
+            double fp;
+            std::memcpy(&fp, value, sizeof(fp));
+            return std::isnan(fp);
+        }
+
+        return 0 == std::memcmp(value, &field.nullValue, field.elementSize);
+    }
+
+    /*
+     * Append rowCount consecutive blocks, each blockLength apart starting at bufferIndex, to the fields of a table.
+     */
+    static void appendFields(
+        ColumnTable& table,
+        const char *buffer,
+        std::size_t bufferIndex,
+        std::size_t blockLength,
+        std::size_t rowCount,
+        std::uint64_t actingVersion)
+    {
+        for (std::vector<ColumnTable::FieldBinding>::const_iterator it = table.m_fields.begin();
+            it != table.m_fields.end();
+            ++it)
+        {
+            const ColumnTable::FieldBinding& field = *it;
+            Column& column = table.m_columns[field.columnIndex];
+            std::uint8_t *values = column.appendValues(field.width * rowCount);
+            const bool isPresent = field.version <= static_cast<std::int32_t>(actingVersion) &&
+                (field.offset + field.width) <= blockLength;
+
+            if (!isPresent)
+            {
+                std::memset(values, 0, field.width * rowCount);
+
+                for (std::size_t i = 0; i < rowCount; i++)
+                {
+                    column.appendValidity(false);
+                }
+
+                continue;
+            }
+
+            const char *src = buffer + bufferIndex + field.offset;
+
+            for (std::size_t i = 0; i < rowCount; i++)
+            {
+                copyToNative(values, src, field.width, field.elementSize, field.byteOrder);
+                column.appendValidity(!field.isNullable || !isNullValue(field, values));
+
+                values += field.width;
+                src += blockLength;
+            }
+        }
+    }
+
+    std::size_t appendBlock(
+        std::size_t tableIndex,
+        const char *buffer,
+        std::size_t bufferIndex,
+        std::size_t blockLength,
+        std::uint64_t actingVersion,
+        std::int64_t parentRowIndex)
+    {
+        const std::vector<DecodeInstruction>& instructions = m_plan.instructions();
+        ColumnTable& table = m_tables[tableIndex];
+        const std::int64_t rowIndex = static_cast<std::int64_t>(table.m_rowCount);
+        std::size_t position = bufferIndex + blockLength;
+
+        appendFields(table, buffer, bufferIndex, blockLength, 1, actingVersion);
+
+        if (parentRowIndex >= 0)
+        {
+            table.m_parentRowIndices.push_back(parentRowIndex);
+        }
+
+        table.m_rowCount++;
+
+        for (std::size_t i = 0; i < table.m_structure.size(); i++)
+        {
+            const ColumnTable::StructureBinding structure = m_tables[tableIndex].m_structure[i];
+            const DecodeInstruction& instruction = instructions[structure.instructionIndex];
+            const bool isPresent = instruction.version <= static_cast<std::int32_t>(actingVersion);
+
+            if (OP_GROUP == instruction.opCode)
+            {
+                std::uint64_t groupBlockLength = isPresent ? Encoding::getUInt(
+                    static_cast<PrimitiveType>(instruction.primitiveType),
+                    static_cast<ByteOrder>(instruction.byteOrder),
+                    buffer + position + instruction.offset) : 0;
+                std::uint64_t numInGroup = isPresent ? Encoding::getUInt(
+                    static_cast<PrimitiveType>(instruction.secondaryPrimitiveType),
+                    static_cast<ByteOrder>(instruction.secondaryByteOrder),
+                    buffer + position + instruction.secondaryOffset) : 0;
+
+                if (isPresent)
+                {
+                    position += instruction.headerLength;
+                }
+
+                ColumnTable& child = m_tables[structure.index];
+
+                if (child.m_isFixedLength)
+                {
+                    const std::size_t rowCount = static_cast<std::size_t>(numInGroup);
+
+                    appendFields(
+                        child, buffer, position, static_cast<std::size_t>(groupBlockLength), rowCount, actingVersion);
+                    child.m_parentRowIndices.insert(child.m_parentRowIndices.end(), rowCount, rowIndex);
+                    child.m_rowCount += rowCount;
+                    position += static_cast<std::size_t>(groupBlockLength * numInGroup);
+                }
+                else
+                {
+                    for (std::uint64_t j = 0; j < numInGroup; j++)
+                    {
+                        position = appendBlock(
+                            structure.index,
+                            buffer,
+                            position,
+                            static_cast<std::size_t>(groupBlockLength),
+                            actingVersion,
+                            rowIndex);
+                    }
+                }
+            }
+            else
+            {
+                Column& column = m_tables[tableIndex].m_columns[structure.index];
+                std::uint64_t dataLength = isPresent ? Encoding::getUInt(
+                    static_cast<PrimitiveType>(instruction.primitiveType),
+                    static_cast<ByteOrder>(instruction.byteOrder),
+                    buffer + position + instruction.offset) : 0;
+
+                if (isPresent)
+                {
+                    position += instruction.dataOffset;
+
+                    if (dataLength > 0)
+                    {
+                        std::memcpy(
+                            column.appendValues(static_cast<std::size_t>(dataLength)), buffer + position, dataLength);
+                        position += static_cast<std::size_t>(dataLength);
+                    }
+                }
+
+                column.m_offsets.push_back(static_cast<std::int64_t>(column.m_valuesLength));
+                column.appendValidity(isPresent);
+            }
+        }
+
+        return position;
+    }
+};
+
+/*
+ * Appends a buffer of header prefixed messages to a ColumnarExporter per template and version, created on first use.
+ */
+class ColumnarStreamExporter
+{
+public:
+    explicit ColumnarStreamExporter(DecodePlanRegistry& registry) :
+        m_registry(registry)
+    {
+    }
+
+    /// Exporters in the order their templates were first seen.
+    inline const std::vector<std::unique_ptr<ColumnarExporter>>& exporters() const
+    {
+        return m_exporters;
+    }
+
+    /**
+     * Append whole messages from the buffer, stopping at the first message which is incomplete or has an unknown
+     * templateId in the same way as OtfMessageDecoder::decodeStream.
+     */
+    StreamDecodeResult append(const char *buffer, const std::size_t length)
+    {
+        const OtfHeaderDecoder& headerDecoder = m_registry.headerDecoder();
+        const std::size_t headerLength = headerDecoder.encodedLength();
+        StreamDecodeResult result = { STREAM_COMPLETE, 0, length, 0 };
+        std::size_t position = 0;
+
+        while (position < length)
+        {
+            const char *headerBuffer = buffer + position;
+
+            if ((length - position) < headerLength)
+            {
+                result.status = STREAM_TRUNCATED;
+                break;
+            }
+
+            const OtfHeaderFields header = headerDecoder.getFields(headerBuffer);
+            const std::uint64_t templateId = header.templateId;
+            const std::uint64_t actingVersion = header.schemaVersion;
+            const std::size_t blockLength = static_cast<std::size_t>(header.blockLength);
+            const DecodePlan *plan = m_registry.plan(templateId, actingVersion);
+
+            if (nullptr == plan)
+            {
+                result.status = STREAM_UNKNOWN_TEMPLATE;
+                break;
+            }
+
+            const char *messageBuffer = headerBuffer + headerLength;
+            const std::size_t messageBufferLength = length - position - headerLength;
+            std::size_t messageLength = 0;
+
+            if (!OtfMessageDecoder::encodedLength(
+                messageBuffer, messageBufferLength, actingVersion, blockLength, *plan, messageLength))
+            {
+                result.status = STREAM_TRUNCATED;
+                break;
+            }
+
+            exporter(plan).append(messageBuffer, messageLength, actingVersion, blockLength);
+
+            position += headerLength + messageLength;
+            result.messageCount++;
+        }
+
+        result.consumedLength = position;
+        result.remainingLength = length - position;
+
+        return result;
+    }
+
+    /// Remove all rows from every exporter, retaining their memory for the next batch.
+    void clear()
+    {
+        for (std::size_t i = 0; i < m_exporters.size(); i++)
+        {
+            m_exporters[i]->clear();
+        }
+    }
+
+private:
+    DecodePlanRegistry& m_registry;
+    std::vector<std::unique_ptr<ColumnarExporter>> m_exporters;
+    std::unordered_map<const DecodePlan *, ColumnarExporter *> m_exportersByPlan;
+
+    ColumnarExporter& exporter(const DecodePlan *plan)
+    {
+        std::unordered_map<const DecodePlan *, ColumnarExporter *>::const_iterator it = m_exportersByPlan.find(plan);
+
+        if (it != m_exportersByPlan.end())
+        {
+            return *it->second;
+        }
+
+        m_exporters.push_back(std::unique_ptr<ColumnarExporter>(new ColumnarExporter(*plan)));
+        m_exportersByPlan.insert(std::make_pair(plan, m_exporters.back().get()));
+
+        return *m_exporters.back();
+    }
+};
+
+}}
+
+#endif
@@ -0,0 +1,377 @@
+/*
+ * Copyright 2013-2020 Real Logic Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _OTF_DECODEPLAN_H
+#define _OTF_DECODEPLAN_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <limits>
+#include <stdexcept>
+
+#include "Token.h"
+
+namespace sbe { namespace otf {
+
+/// Operations executed by OtfMessageDecoder when decoding with a DecodePlan
+enum DecodeOpCode : std::uint8_t
+{
+    /// Primitive encoding at a fixed offset within the current block.
+        OP_ENCODING = 0,
+    /// Enum at a fixed offset within the current block.
+        OP_ENUM = 1,
+    /// Bit set at a fixed offset within the current block.
+        OP_SET = 2,
+    /// Begins a composite. Its members follow as instructions with offsets already resolved.
+        OP_BEGIN_COMPOSITE = 3,
+    /// Ends a composite.
+        OP_END_COMPOSITE = 4,
+    /// Repeating group. Its body is the instructions up to, but not including, next.
+        OP_GROUP = 5,
+    /// Variable length data element.
+        OP_VAR_DATA = 6,
+    /// Repeating group walked without raising events to find where it ends. Used by FieldProjection.
+        OP_SKIP_GROUP = 7,
+    /// Repeating group with fixed length elements skipped as blockLength * numInGroup. Used by FieldProjection.
+        OP_SKIP_FIXED_GROUP = 8,
+    /// Variable length data element skipped without raising events. Used by FieldProjection.
+        OP_SKIP_VAR_DATA = 9
+};
+
+/*
+ * A single step of a DecodePlan with all offsets, types, and byte orders resolved from the tokens, packed into 32
+ * bytes so two fit in a cache line. Names and metadata stay with the tokens, which are only touched to hand them to
+ * the listener.
+ *
+ * For OP_GROUP the primary type describes the blockLength and the secondary type the numInGroup of the
+ * dimensions, both offset from the start of the dimensions. For OP_VAR_DATA the primary type describes the
+ * length field and dataOffset is where the data begins relative to the length field. Types and byte orders hold
+ * PrimitiveType and ByteOrder values.
+ */
+struct DecodeInstruction
+{
+    DecodeOpCode opCode;
+    std::uint8_t primitiveType;
+    std::uint8_t byteOrder;
+    std::uint8_t secondaryPrimitiveType;
+    std::uint8_t secondaryByteOrder;
+    std::uint16_t headerLength;
+    std::uint16_t secondaryOffset;
+    std::uint16_t dataOffset;
+    std::int32_t version;
+    std::uint32_t offset;
+    std::uint32_t fieldTokenIndex;
+    std::uint32_t typeTokenIndex;
+    union
+    {
+        /// Last token of an enum, set or composite, which begins at typeTokenIndex.
+        std::uint32_t toIndex;
+        /// Instruction following the body of a group.
+        std::uint32_t next;
+    };
+};
+
+/*
+ * Message tokens compiled into a flat array of instructions for OtfMessageDecoder.
+ *
+ * A plan is built once per message and never modified afterwards, so it may be shared between threads. The tokens
+ * are kept alive by the plan and handed to the listener by reference so no reference counts are touched per message.
+ */
+class DecodePlan
+{
+public:
+    explicit DecodePlan(const std::shared_ptr<std::vector<Token>>& msgTokens) :
+        m_tokens(msgTokens),
+        m_isFixedLength(true)
+    {
+        std::vector<Token>& tokens = *m_tokens;
+        const std::size_t numTokens = tokens.size();
+
+        if (numTokens < 2 || Signal::BEGIN_MESSAGE != tokens[0].signal())
+        {
+            throw std::runtime_error("tokens must begin with BEGIN_MESSAGE");
+        }
+
+        std::size_t tokenIndex = compileFields(tokens, 1, numTokens);
+        tokenIndex = compileGroups(tokens, tokenIndex, numTokens);
+        compileData(tokens, tokenIndex, numTokens);
+
+        for (std::size_t i = 0; i < m_instructions.size(); i++)
+        {
+            if (OP_GROUP == m_instructions[i].opCode || OP_VAR_DATA == m_instructions[i].opCode)
+            {
+                m_isFixedLength = false;
+            }
+        }
+    }
+
+    inline const std::vector<DecodeInstruction>& instructions() const
+    {
+        return m_instructions;
+    }
+
+    inline std::vector<Token>& tokens() const
+    {
+        return *m_tokens;
+    }
+
+    inline const std::shared_ptr<std::vector<Token>>& tokensPtr() const
+    {
+        return m_tokens;
+    }
+
+    inline Token& beginMessageToken() const
+    {
+        return m_tokens->front();
+    }
+
+    inline Token& endMessageToken() const
+    {
+        return m_tokens->back();
+    }
+
+    inline std::int32_t templateId() const
+    {
+        return m_tokens->front().fieldId();
+    }
+
+    inline std::int32_t version() const
+    {
+        return m_tokens->front().tokenVersion();
+    }
+
+    inline std::int32_t blockLength() const
+    {
+        return m_tokens->front().encodedLength();
+    }
+
+    /// True if the message has no groups or var data so its encoded length is always its blockLength.
+    inline bool isFixedLength() const
+    {
+        return m_isFixedLength;
+    }
+
+private:
+    std::shared_ptr<std::vector<Token>> m_tokens;
+    std::vector<DecodeInstruction> m_instructions;
+    bool m_isFixedLength;
+
+    static DecodeInstruction newInstruction(DecodeOpCode opCode)
+    {
+        DecodeInstruction instruction = {};
+        instruction.opCode = opCode;
+        instruction.primitiveType = PrimitiveType::NONE;
+        instruction.byteOrder = ByteOrder::SBE_LITTLE_ENDIAN;
+        instruction.secondaryPrimitiveType = PrimitiveType::NONE;
+        instruction.secondaryByteOrder = ByteOrder::SBE_LITTLE_ENDIAN;
+
+        return instruction;
+    }
+
+    static std::uint16_t toUInt16(std::int32_t value)
+    {
+        if (value < 0 || value > std::numeric_limits<std::uint16_t>::max())
+        {
+            throw std::runtime_error("offset within dimensions or var data header out of range");
+        }
+
+        return static_cast<std::uint16_t>(value);
+    }
+
+    void addFieldInstruction(
+        DecodeOpCode opCode,
+        std::size_t fieldTokenIndex,
+        std::size_t typeTokenIndex,
+        std::size_t offset,
+        std::size_t toIndex)
+    {
+        DecodeInstruction instruction = newInstruction(opCode);
+        const Encoding& encoding = m_tokens->at(typeTokenIndex).encoding();
+
+        instruction.primitiveType = encoding.primitiveType();
+        instruction.byteOrder = encoding.byteOrder();
+        instruction.offset = static_cast<std::uint32_t>(offset);
+        instruction.fieldTokenIndex = static_cast<std::uint32_t>(fieldTokenIndex);
+        instruction.typeTokenIndex = static_cast<std::uint32_t>(typeTokenIndex);
+        instruction.toIndex = static_cast<std::uint32_t>(toIndex);
+
+        m_instructions.push_back(instruction);
+    }
+
+    void compileComposite(
+        std::vector<Token>& tokens,
+        std::size_t fieldTokenIndex,
+        std::size_t compositeOffset,
+        std::size_t tokenIndex,
+        std::size_t toIndex)
+    {
+        addFieldInstruction(OP_BEGIN_COMPOSITE, fieldTokenIndex, tokenIndex, compositeOffset, toIndex);
+
+        for (std::size_t i = tokenIndex + 1; i < toIndex;)
+        {
+            Token& token = tokens.at(i);
+            const std::size_t nextFieldIndex = i + token.componentTokenCount();
+            const std::size_t offset = compositeOffset + static_cast<std::size_t>(token.offset());
+
+            switch (token.signal())
+            {
+                case Signal::BEGIN_COMPOSITE:
+                    compileComposite(tokens, fieldTokenIndex, offset, i, nextFieldIndex - 1);
+                    break;
+
+                case Signal::BEGIN_ENUM:
+                    addFieldInstruction(OP_ENUM, fieldTokenIndex, i, offset, nextFieldIndex - 1);
+                    break;
+
+                case Signal::BEGIN_SET:
+                    addFieldInstruction(OP_SET, fieldTokenIndex, i, offset, nextFieldIndex - 1);
+                    break;
+
+                case Signal::ENCODING:
+                    addFieldInstruction(OP_ENCODING, i, i, offset, i);
+                    break;
+
+                default:
+                    throw std::runtime_error("incorrect signal type in decodeComposite");
+            }
+
+            i += token.componentTokenCount();
+        }
+
+        addFieldInstruction(OP_END_COMPOSITE, fieldTokenIndex, tokenIndex, compositeOffset, toIndex);
+    }
+
+    std::size_t compileFields(std::vector<Token>& tokens, std::size_t tokenIndex, const std::size_t numTokens)
+    {
+        while (tokenIndex < numTokens)
+        {
+            Token& fieldToken = tokens.at(tokenIndex);
+            if (Signal::BEGIN_FIELD != fieldToken.signal())
+            {
+                break;
+            }
+
+            const std::size_t fieldTokenIndex = tokenIndex;
+            const std::size_t nextFieldIndex = tokenIndex + fieldToken.componentTokenCount();
+            tokenIndex++;
+
+            Token& typeToken = tokens.at(tokenIndex);
+            const std::size_t offset = static_cast<std::size_t>(typeToken.offset());
+
+            switch (typeToken.signal())
+            {
+                case Signal::BEGIN_COMPOSITE:
+                    compileComposite(tokens, fieldTokenIndex, offset, tokenIndex, nextFieldIndex - 2);
+                    break;
+
+                case Signal::BEGIN_ENUM:
+                    addFieldInstruction(OP_ENUM, fieldTokenIndex, tokenIndex, offset, nextFieldIndex - 2);
+                    break;
+
+                case Signal::BEGIN_SET:
+                    addFieldInstruction(OP_SET, fieldTokenIndex, tokenIndex, offset, nextFieldIndex - 2);
+                    break;
+
+                case Signal::ENCODING:
+                    addFieldInstruction(OP_ENCODING, fieldTokenIndex, tokenIndex, offset, tokenIndex);
+                    break;
+
+                default:
+                    throw std::runtime_error("incorrect signal type in decodeFields");
+            }
+
+            tokenIndex = nextFieldIndex;
+        }
+
+        return tokenIndex;
+    }
+
+    std::size_t compileGroups(std::vector<Token>& tokens, std::size_t tokenIndex, const std::size_t numTokens)
+    {
+        while (tokenIndex < numTokens)
+        {
+            Token& token = tokens.at(tokenIndex);
+            if (Signal::BEGIN_GROUP != token.signal())
+            {
+                break;
+            }
+
+            Token& dimensionsTypeComposite = tokens.at(tokenIndex + 1);
+            Token& blockLengthToken = tokens.at(tokenIndex + 2);
+            Token& numInGroupToken = tokens.at(tokenIndex + 3);
+
+            DecodeInstruction instruction = newInstruction(OP_GROUP);
+            instruction.primitiveType = blockLengthToken.encoding().primitiveType();
+            instruction.byteOrder = blockLengthToken.encoding().byteOrder();
+            instruction.offset = static_cast<std::uint32_t>(blockLengthToken.offset());
+            instruction.secondaryPrimitiveType = numInGroupToken.encoding().primitiveType();
+            instruction.secondaryByteOrder = numInGroupToken.encoding().byteOrder();
+            instruction.secondaryOffset = toUInt16(numInGroupToken.offset());
+            instruction.headerLength = toUInt16(dimensionsTypeComposite.encodedLength());
+            instruction.version = token.tokenVersion();
+            instruction.fieldTokenIndex = static_cast<std::uint32_t>(tokenIndex);
+            instruction.typeTokenIndex = static_cast<std::uint32_t>(tokenIndex + 1);
+
+            const std::size_t groupInstructionIndex = m_instructions.size();
+            m_instructions.push_back(instruction);
+
+            std::size_t bodyIndex = tokenIndex + dimensionsTypeComposite.componentTokenCount() + 1;
+            bodyIndex = compileFields(tokens, bodyIndex, numTokens);
+            bodyIndex = compileGroups(tokens, bodyIndex, numTokens);
+            compileData(tokens, bodyIndex, numTokens);
+
+            m_instructions[groupInstructionIndex].next = static_cast<std::uint32_t>(m_instructions.size());
+
+            tokenIndex += token.componentTokenCount();
+        }
+
+        return tokenIndex;
+    }
+
+    std::size_t compileData(std::vector<Token>& tokens, std::size_t tokenIndex, const std::size_t numTokens)
+    {
+        while (tokenIndex < numTokens)
+        {
+            Token& token = tokens.at(tokenIndex);
+            if (Signal::BEGIN_VAR_DATA != token.signal())
+            {
+                break;
+            }
+
+            Token& lengthToken = tokens.at(tokenIndex + 2);
+            Token& dataToken = tokens.at(tokenIndex + 3);
+
+            DecodeInstruction instruction = newInstruction(OP_VAR_DATA);
+            instruction.primitiveType = lengthToken.encoding().primitiveType();
+            instruction.byteOrder = lengthToken.encoding().byteOrder();
+            instruction.offset = static_cast<std::uint32_t>(lengthToken.offset());
+            instruction.dataOffset = toUInt16(dataToken.offset());
+            instruction.version = token.tokenVersion();
+            instruction.fieldTokenIndex = static_cast<std::uint32_t>(tokenIndex);
+            instruction.typeTokenIndex = static_cast<std::uint32_t>(tokenIndex + 3);
+
+            m_instructions.push_back(instruction);
+
+            tokenIndex += token.componentTokenCount();
+        }
+
+        return tokenIndex;
+    }
+};
+
+}}
+
+#endif
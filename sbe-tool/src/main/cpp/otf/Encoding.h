@@ -19,6 +19,12 @@
 #include <cstdint>
 #include <string>
 
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+#include "StringPool.h"
+
 #if defined(WIN32) || defined(_WIN32)
 #    define SBE_OTF_BSWAP_16(v) _byteswap_ushort(v)
 #    define SBE_OTF_BSWAP_32(v) _byteswap_ulong(v)
@@ -157,7 +163,8 @@ class PrimitiveValue
 {
 public:
     PrimitiveValue(PrimitiveType type, std::uint64_t valueLength, const char *value) :
-        m_type(type)
+        m_type(type),
+        m_arrayValue(StringPool::empty())
     {
         if (0 == valueLength)
         {
@@ -172,7 +179,7 @@ public:
             {
                 if (valueLength > 1)
                 {
-                    m_arrayValue = std::string(value, static_cast<size_t>(valueLength));
+                    m_arrayValue = StringPool::intern(value, static_cast<size_t>(valueLength));
                     m_size = static_cast<size_t>(valueLength);
                 }
                 else
@@ -299,7 +306,7 @@ public:
 
     inline const char *getArray() const
     {
-        return m_arrayValue.c_str(); // in C++11 data() and c_str() are equivalent and are null terminated after length
+        return m_arrayValue->c_str(); // in C++11 data() and c_str() are equivalent and are null terminated after length
     }
 
     inline std::size_t size() const
@@ -321,7 +328,7 @@ private:
         std::uint64_t asUInt;
         double asDouble;
     } m_value;
-    std::string m_arrayValue;  // use this to store all the types, not just char arrays
+    const std::string *m_arrayValue; // interned char array values, otherwise empty
 };
 
 class Encoding
@@ -337,24 +344,51 @@ public:
         PrimitiveValue constValue,
         PrimitiveValue lsbValue,
         PrimitiveValue msbValue,
-        std::string characterEncoding,
-        std::string epoch,
-        std::string timeUnit,
-        std::string semanticType)
-        :
+        const std::string& characterEncoding,
+        const std::string& epoch,
+        const std::string& timeUnit,
+        const std::string& semanticType) :
+        Encoding(
+            type, presence, byteOrder, minValue, maxValue, nullValue, constValue, lsbValue, msbValue,
+            StringPool::intern(characterEncoding),
+            StringPool::intern(epoch),
+            StringPool::intern(timeUnit),
+            StringPool::intern(semanticType))
+    {
+    }
+
+    /// As above with strings already interned into the StringPool, as done by the IrDecoder.
+    Encoding(
+        PrimitiveType type,
+        Presence presence,
+        ByteOrder byteOrder,
+        const PrimitiveValue& minValue,
+        const PrimitiveValue& maxValue,
+        const PrimitiveValue& nullValue,
+        const PrimitiveValue& constValue,
+        const PrimitiveValue& lsbValue,
+        const PrimitiveValue& msbValue,
+        const std::string *characterEncoding,
+        const std::string *epoch,
+        const std::string *timeUnit,
+        const std::string *semanticType) :
         m_presence(presence),
         m_primitiveType(type),
         m_byteOrder(byteOrder),
-        m_minValue(std::move(minValue)),
-        m_maxValue(std::move(maxValue)),
-        m_nullValue(std::move(nullValue)),
-        m_constValue(std::move(constValue)),
-        m_lsbValue(std::move(lsbValue)),
-        m_msbValue(std::move(msbValue)),
-        m_characterEncoding(std::move(characterEncoding)),
-        m_epoch(std::move(epoch)),
-        m_timeUnit(std::move(timeUnit)),
-        m_semanticType(std::move(semanticType))
+        m_minValue(minValue),
+        m_maxValue(maxValue),
+        m_nullValue(nullValue),
+        m_constValue(constValue),
+        m_lsbValue(lsbValue),
+        m_msbValue(msbValue),
+        m_characterEncoding(characterEncoding),
+        m_epoch(epoch),
+        m_timeUnit(timeUnit),
+        m_semanticType(semanticType),
+        m_bitShift(bitShift(m_constValue, m_lsbValue, m_msbValue)),
+        m_bitLength(bitLength(m_constValue, m_lsbValue, m_msbValue)),
+        m_bitMask(m_bitLength >= 64 ? ~UINT64_C(0) : (UINT64_C(1) << m_bitLength) - 1),
+        m_isBitReversed(isBitReversed(m_constValue, m_lsbValue, m_msbValue))
     {
     }
 
@@ -583,6 +617,40 @@ public:
         return b;
     }
 
+    /* Function to reverse the low length bits of a value, a byte at a time */
+    static inline std::uint64_t reverseBits(std::uint64_t bits, std::uint32_t length)
+    {
+        static const std::uint8_t reversedBytes[256] =
+        {
+            0x00, 0x80, 0x40, 0xC0, 0x20, 0xA0, 0x60, 0xE0, 0x10, 0x90, 0x50, 0xD0, 0x30, 0xB0, 0x70, 0xF0,
+            0x08, 0x88, 0x48, 0xC8, 0x28, 0xA8, 0x68, 0xE8, 0x18, 0x98, 0x58, 0xD8, 0x38, 0xB8, 0x78, 0xF8,
+            0x04, 0x84, 0x44, 0xC4, 0x24, 0xA4, 0x64, 0xE4, 0x14, 0x94, 0x54, 0xD4, 0x34, 0xB4, 0x74, 0xF4,
+            0x0C, 0x8C, 0x4C, 0xCC, 0x2C, 0xAC, 0x6C, 0xEC, 0x1C, 0x9C, 0x5C, 0xDC, 0x3C, 0xBC, 0x7C, 0xFC,
+            0x02, 0x82, 0x42, 0xC2, 0x22, 0xA2, 0x62, 0xE2, 0x12, 0x92, 0x52, 0xD2, 0x32, 0xB2, 0x72, 0xF2,
+            0x0A, 0x8A, 0x4A, 0xCA, 0x2A, 0xAA, 0x6A, 0xEA, 0x1A, 0x9A, 0x5A, 0xDA, 0x3A, 0xBA, 0x7A, 0xFA,
+            0x06, 0x86, 0x46, 0xC6, 0x26, 0xA6, 0x66, 0xE6, 0x16, 0x96, 0x56, 0xD6, 0x36, 0xB6, 0x76, 0xF6,
+            0x0E, 0x8E, 0x4E, 0xCE, 0x2E, 0xAE, 0x6E, 0xEE, 0x1E, 0x9E, 0x5E, 0xDE, 0x3E, 0xBE, 0x7E, 0xFE,
+            0x01, 0x81, 0x41, 0xC1, 0x21, 0xA1, 0x61, 0xE1, 0x11, 0x91, 0x51, 0xD1, 0x31, 0xB1, 0x71, 0xF1,
+            0x09, 0x89, 0x49, 0xC9, 0x29, 0xA9, 0x69, 0xE9, 0x19, 0x99, 0x59, 0xD9, 0x39, 0xB9, 0x79, 0xF9,
+            0x05, 0x85, 0x45, 0xC5, 0x25, 0xA5, 0x65, 0xE5, 0x15, 0x95, 0x55, 0xD5, 0x35, 0xB5, 0x75, 0xF5,
+            0x0D, 0x8D, 0x4D, 0xCD, 0x2D, 0xAD, 0x6D, 0xED, 0x1D, 0x9D, 0x5D, 0xDD, 0x3D, 0xBD, 0x7D, 0xFD,
+            0x03, 0x83, 0x43, 0xC3, 0x23, 0xA3, 0x63, 0xE3, 0x13, 0x93, 0x53, 0xD3, 0x33, 0xB3, 0x73, 0xF3,
+            0x0B, 0x8B, 0x4B, 0xCB, 0x2B, 0xAB, 0x6B, 0xEB, 0x1B, 0x9B, 0x5B, 0xDB, 0x3B, 0xBB, 0x7B, 0xFB,
+            0x07, 0x87, 0x47, 0xC7, 0x27, 0xA7, 0x67, 0xE7, 0x17, 0x97, 0x57, 0xD7, 0x37, 0xB7, 0x77, 0xF7,
+            0x0F, 0x8F, 0x4F, 0xCF, 0x2F, 0xAF, 0x6F, 0xEF, 0x1F, 0x9F, 0x5F, 0xDF, 0x3F, 0xBF, 0x7F, 0xFF
+        };
+        std::uint64_t reversed = 0;
+        std::uint32_t i = 0;
+
+        for (; i < length; i += 8)
+        {
+            reversed = (reversed << 8) | reversedBytes[bits & 0xFF];
+            bits >>= 8;
+        }
+
+        return reversed >> (i - length);
+    }
+
     /* Function to reverse bits of uint64_t */
     static inline std::uint64_t reverseBitsUint64(std::uint64_t b)
     {
@@ -660,23 +728,35 @@ public:
         return m_msbValue;
     }
 
+    /// Lowest bit of the choice or lsb/msb bit field, or 0 for other encodings.
+    inline std::uint32_t bitShift() const
+    {
+        return m_bitShift;
+    }
+
+    /// Number of bits in the choice or lsb/msb bit field, or 64 for other encodings.
+    inline std::uint32_t bitLength() const
+    {
+        return m_bitLength;
+    }
+
+    /// Mask of the bit field once shifted down by bitShift.
+    inline std::uint64_t bitMask() const
+    {
+        return m_bitMask;
+    }
+
+    /// True when lsb is above msb, so the bits of the field read downwards.
+    inline bool isBitReversed() const
+    {
+        return m_isBitReversed;
+    }
+
     inline uint64_t getBits(uint64_t encodedValue) const
     {
-        int64_t lsb = isChoice() ? m_constValue.getAsInt() : m_lsbValue.getAsInt();
-        int64_t msb = isChoice() ? m_constValue.getAsInt() : m_msbValue.getAsInt();
-        int64_t len = std::abs(msb - lsb) + 1;
-        uint64_t mask = (UINT64_C(1) << len) - 1;
-        uint64_t resultValue;
-        if (lsb <= msb)
-        {
-            resultValue = (encodedValue >> lsb) & mask;
-        }
-        else
-        {
-            uint64_t reversed = reverseBitsUint64(encodedValue);
-            resultValue = (reversed >> (63 - lsb)) & mask;
-        }
-        return resultValue;
+        const std::uint64_t bits = (encodedValue >> m_bitShift) & m_bitMask;
+
+        return m_isBitReversed ? reverseBits(bits, m_bitLength) : bits;
     }
 
     inline std::string bitsToString(uint64_t bits)
@@ -697,24 +777,46 @@ public:
 
     inline const std::string& characterEncoding() const
     {
-        return m_characterEncoding;
+        return *m_characterEncoding;
     }
 
     inline const std::string& epoch() const
     {
-        return m_epoch;
+        return *m_epoch;
     }
 
     inline const std::string& timeUnit() const
     {
-        return m_timeUnit;
+        return *m_timeUnit;
     }
 
     inline const std::string& semanticType() const
     {
-        return m_semanticType;
+        return *m_semanticType;
     }
 
+#if __cplusplus >= 201703L
+    inline std::string_view characterEncodingView() const
+    {
+        return *m_characterEncoding;
+    }
+
+    inline std::string_view epochView() const
+    {
+        return *m_epoch;
+    }
+
+    inline std::string_view timeUnitView() const
+    {
+        return *m_timeUnit;
+    }
+
+    inline std::string_view semanticTypeView() const
+    {
+        return *m_semanticType;
+    }
+#endif
+
 private:
     const Presence m_presence;
     const PrimitiveType m_primitiveType;
@@ -727,10 +829,62 @@ private:
     const PrimitiveValue m_lsbValue;
     const PrimitiveValue m_msbValue;
 
-    const std::string m_characterEncoding;
-    const std::string m_epoch;
-    const std::string m_timeUnit;
-    const std::string m_semanticType;
+    const std::string *const m_characterEncoding;
+    const std::string *const m_epoch;
+    const std::string *const m_timeUnit;
+    const std::string *const m_semanticType;
+
+    const std::uint32_t m_bitShift;
+    const std::uint32_t m_bitLength;
+    const std::uint64_t m_bitMask;
+    const bool m_isBitReversed;
+
+    static bool isIntegral(const PrimitiveValue& value)
+    {
+        return (isInt(value.primitiveType()) || isUInt(value.primitiveType())) && value.size() <= sizeof(std::uint64_t);
+    }
+
+    static std::int64_t bitPosition(const PrimitiveValue& constValue, const PrimitiveValue& bitValue)
+    {
+        if (isIntegral(constValue) && constValue.getAsInt() != SBE_NULLVALUE_UINT8)
+        {
+            return constValue.getAsInt();
+        }
+
+        return isIntegral(bitValue) ? bitValue.getAsInt() : -1;
+    }
+
+    static bool hasBitField(std::int64_t lsb, std::int64_t msb)
+    {
+        return lsb >= 0 && lsb < 64 && msb >= 0 && msb < 64;
+    }
+
+    static std::uint32_t bitShift(
+        const PrimitiveValue& constValue, const PrimitiveValue& lsbValue, const PrimitiveValue& msbValue)
+    {
+        const std::int64_t lsb = bitPosition(constValue, lsbValue);
+        const std::int64_t msb = bitPosition(constValue, msbValue);
+
+        return hasBitField(lsb, msb) ? static_cast<std::uint32_t>(lsb < msb ? lsb : msb) : 0;
+    }
+
+    static std::uint32_t bitLength(
+        const PrimitiveValue& constValue, const PrimitiveValue& lsbValue, const PrimitiveValue& msbValue)
+    {
+        const std::int64_t lsb = bitPosition(constValue, lsbValue);
+        const std::int64_t msb = bitPosition(constValue, msbValue);
+
+        return hasBitField(lsb, msb) ? static_cast<std::uint32_t>((lsb < msb ? msb - lsb : lsb - msb) + 1) : 64;
+    }
+
+    static bool isBitReversed(
+        const PrimitiveValue& constValue, const PrimitiveValue& lsbValue, const PrimitiveValue& msbValue)
+    {
+        const std::int64_t lsb = bitPosition(constValue, lsbValue);
+        const std::int64_t msb = bitPosition(constValue, msbValue);
+
+        return hasBitField(lsb, msb) && lsb > msb;
+    }
 };
 
 }}
@@ -0,0 +1,246 @@
+/*
+ * Copyright 2013-2020 Real Logic Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _OTF_ENUMINDEX_H
+#define _OTF_ENUMINDEX_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Token.h"
+
+namespace sbe { namespace otf {
+
+/*
+ * Finds the VALID_VALUE token of an encoded enum value without scanning the tokens of the enum.
+ *
+ * Values spanning a range no more than a few times the number of values, such as char codes or small counts, index a
+ * dense table directly. Sparse values are found in an open addressed hash table. The IrDecoder builds one for each
+ * BEGIN_ENUM token of a message and attaches it to the token, so an onEnum listener may resolve the value with
+ * tokens[fromIndex].enumIndex()->find(tokens, buffer).
+ */
+class EnumIndex
+{
+public:
+    EnumIndex(const std::vector<Token>& tokens, std::size_t fromIndex, std::size_t toIndex) :
+        m_primitiveType(tokens.at(fromIndex).encoding().primitiveType()),
+        m_byteOrder(tokens.at(fromIndex).encoding().byteOrder()),
+        m_toIndex(static_cast<std::uint32_t>(toIndex)),
+        m_minValue(0),
+        m_hashShift(64)
+    {
+        std::vector<Entry> entries;
+
+        for (std::size_t i = fromIndex + 1; i < toIndex; i++)
+        {
+            const Token& token = tokens.at(i);
+
+            if (Signal::VALID_VALUE == token.signal())
+            {
+                Entry entry = { token.encoding().constValue().getAsInt(), static_cast<std::uint32_t>(i) };
+                entries.push_back(entry);
+            }
+        }
+
+        if (entries.empty())
+        {
+            return;
+        }
+
+        std::int64_t minValue = entries[0].value;
+        std::int64_t maxValue = entries[0].value;
+
+        for (std::size_t i = 1; i < entries.size(); i++)
+        {
+            minValue = entries[i].value < minValue ? entries[i].value : minValue;
+            maxValue = entries[i].value > maxValue ? entries[i].value : maxValue;
+        }
+
+        const std::uint64_t span = static_cast<std::uint64_t>(maxValue) - static_cast<std::uint64_t>(minValue);
+
+        if (span < 256 || span < entries.size() * 4)
+        {
+            m_minValue = minValue;
+            m_dense.assign(static_cast<std::size_t>(span) + 1, m_toIndex);
+
+            for (std::size_t i = entries.size(); i > 0; i--)
+            {
+                const Entry& entry = entries[i - 1];
+                m_dense[static_cast<std::size_t>(
+                    static_cast<std::uint64_t>(entry.value) - static_cast<std::uint64_t>(minValue))] = entry.tokenIndex;
+            }
+        }
+        else
+        {
+            std::uint32_t bits = 1;
+
+            while ((std::size_t(1) << bits) < entries.size() * 2)
+            {
+                bits++;
+            }
+
+            const Entry empty = { 0, m_toIndex };
+            m_hashShift = 64 - bits;
+            m_hashed.assign(std::size_t(1) << bits, empty);
+
+            for (std::size_t i = 0; i < entries.size(); i++)
+            {
+                std::size_t slot = hash(entries[i].value);
+
+                while (m_hashed[slot].tokenIndex != m_toIndex && m_hashed[slot].value != entries[i].value)
+                {
+                    slot = (slot + 1) & (m_hashed.size() - 1);
+                }
+
+                if (m_hashed[slot].tokenIndex == m_toIndex)
+                {
+                    m_hashed[slot] = entries[i];
+                }
+            }
+        }
+    }
+
+    /**
+     * Index of the VALID_VALUE token with the given value, compared as constValue().getAsInt(), or toIndex if no
+     * value of the enum matches.
+     */
+    inline std::size_t find(std::int64_t value) const
+    {
+        if (!m_dense.empty())
+        {
+            const std::uint64_t slot = static_cast<std::uint64_t>(value) - static_cast<std::uint64_t>(m_minValue);
+
+            return slot < m_dense.size() ? m_dense[static_cast<std::size_t>(slot)] : m_toIndex;
+        }
+
+        if (!m_hashed.empty())
+        {
+            std::size_t slot = hash(value);
+
+            while (m_hashed[slot].tokenIndex != m_toIndex)
+            {
+                if (m_hashed[slot].value == value)
+                {
+                    return m_hashed[slot].tokenIndex;
+                }
+
+                slot = (slot + 1) & (m_hashed.size() - 1);
+            }
+        }
+
+        return m_toIndex;
+    }
+
+    /// Read the encoded enum from the buffer and find its VALID_VALUE token.
+    inline std::size_t findEncoded(const char *buffer) const
+    {
+        return find(encodedValue(buffer));
+    }
+
+    /// VALID_VALUE token of the encoded enum in the buffer, or nullptr if no value of the enum matches.
+    inline const Token *find(const std::vector<Token>& tokens, const char *buffer) const
+    {
+        const std::size_t index = findEncoded(buffer);
+
+        return index != m_toIndex ? &tokens[index] : nullptr;
+    }
+
+    inline std::int64_t encodedValue(const char *buffer) const
+    {
+        return encodedValue(m_primitiveType, m_byteOrder, buffer);
+    }
+
+    static std::int64_t encodedValue(PrimitiveType primitiveType, ByteOrder byteOrder, const char *buffer)
+    {
+        return Encoding::isUInt(primitiveType) ?
+            static_cast<std::int64_t>(Encoding::getUInt(primitiveType, byteOrder, buffer)) :
+            Encoding::getInt(primitiveType, byteOrder, buffer);
+    }
+
+    /// VALID_VALUE token of the encoded enum found by scanning the tokens, for enums which have no index attached.
+    static const Token *scan(
+        const std::vector<Token>& tokens, std::size_t fromIndex, std::size_t toIndex, const char *buffer)
+    {
+        const Encoding& encoding = tokens[fromIndex].encoding();
+        const std::int64_t value = encodedValue(encoding.primitiveType(), encoding.byteOrder(), buffer);
+
+        for (std::size_t i = fromIndex + 1; i < toIndex; i++)
+        {
+            const Token& token = tokens[i];
+
+            if (Signal::VALID_VALUE == token.signal() && token.encoding().constValue().getAsInt() == value)
+            {
+                return &token;
+            }
+        }
+
+        return nullptr;
+    }
+
+    inline std::size_t toIndex() const
+    {
+        return m_toIndex;
+    }
+
+    /// Build an index for each BEGIN_ENUM token in the tokens and attach it to the token.
+    static void indexEnums(std::vector<Token>& tokens)
+    {
+        for (std::size_t i = 0; i < tokens.size(); i++)
+        {
+            if (Signal::BEGIN_ENUM != tokens[i].signal())
+            {
+                continue;
+            }
+
+            std::size_t endIndex = i + 1;
+
+            while (endIndex < tokens.size() && Signal::END_ENUM != tokens[endIndex].signal())
+            {
+                endIndex++;
+            }
+
+            if (endIndex < tokens.size())
+            {
+                tokens[i].enumIndex(std::make_shared<const EnumIndex>(tokens, i, endIndex));
+                i = endIndex;
+            }
+        }
+    }
+
+private:
+    struct Entry
+    {
+        std::int64_t value;
+        std::uint32_t tokenIndex;
+    };
+
+    PrimitiveType m_primitiveType;
+    ByteOrder m_byteOrder;
+    std::uint32_t m_toIndex;
+    std::int64_t m_minValue;
+    std::uint32_t m_hashShift;
+    std::vector<std::uint32_t> m_dense;
+    std::vector<Entry> m_hashed;
+
+    inline std::size_t hash(std::int64_t value) const
+    {
+        return static_cast<std::size_t>((static_cast<std::uint64_t>(value) * UINT64_C(0x9E3779B97F4A7C15)) >> m_hashShift);
+    }
+};
+
+}}
+
+#endif
@@ -0,0 +1,284 @@
+/*
+ * Copyright 2013-2020 Real Logic Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _OTF_FIELDACCESSOR_H
+#define _OTF_FIELDACCESSOR_H
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include "Token.h"
+
+namespace sbe { namespace otf {
+
+namespace detail {
+
+template<std::size_t Size>
+struct FieldWord;
+
+template<>
+struct FieldWord<1>
+{
+    typedef std::uint8_t type;
+
+    static inline type toNative(ByteOrder byteOrder, type value)
+    {
+        return value;
+    }
+};
+
+template<>
+struct FieldWord<2>
+{
+    typedef std::uint16_t type;
+
+    static inline type toNative(ByteOrder byteOrder, type value)
+    {
+        return SBE_OTF_BYTE_ORDER_16(byteOrder, value);
+    }
+};
+
+template<>
+struct FieldWord<4>
+{
+    typedef std::uint32_t type;
+
+    static inline type toNative(ByteOrder byteOrder, type value)
+    {
+        return SBE_OTF_BYTE_ORDER_32(byteOrder, value);
+    }
+};
+
+template<>
+struct FieldWord<8>
+{
+    typedef std::uint64_t type;
+
+    static inline type toNative(ByteOrder byteOrder, type value)
+    {
+        return SBE_OTF_BYTE_ORDER_64(byteOrder, value);
+    }
+};
+
+template<typename T, ByteOrder byteOrder>
+inline T loadField(const char *buffer)
+{
+    typedef FieldWord<sizeof(T)> Word;
+
+    typename Word::type bits;
+    std::memcpy(&bits, buffer, sizeof(bits));
+    bits = Word::toNative(byteOrder, bits);
+
+    T value;
+    std::memcpy(&value, &bits, sizeof(value));
+
+    return value;
+}
+
+template<typename T, ByteOrder byteOrder>
+std::int64_t getIntField(const char *buffer)
+{
+    return static_cast<std::int64_t>(loadField<T, byteOrder>(buffer));
+}
+
+template<typename T, ByteOrder byteOrder>
+std::uint64_t getUIntField(const char *buffer)
+{
+    return static_cast<std::uint64_t>(loadField<T, byteOrder>(buffer));
+}
+
+template<typename T, ByteOrder byteOrder>
+double getDoubleField(const char *buffer)
+{
+    return static_cast<double>(loadField<T, byteOrder>(buffer));
+}
+
+inline std::int64_t getIntMismatch(const char *buffer)
+{
+    throw std::runtime_error("incorrect type for Encoding::getInt");
+}
+
+inline std::uint64_t getUIntMismatch(const char *buffer)
+{
+    throw std::runtime_error("incorrect type for Encoding::getUInt");
+}
+
+inline double getDoubleMismatch(const char *buffer)
+{
+    throw std::runtime_error("incorrect type for Encoding::getDouble");
+}
+
+}
+
+/*
+ * Reads a primitive field through functions resolved once for its PrimitiveType and ByteOrder, so each read is a
+ * direct load plus a byte swap only where the byte order differs from the platform. Reads of the wrong kind throw as
+ * the equivalent Encoding::getAsInt, getAsUInt, or getAsDouble would.
+ */
+class FieldAccessor
+{
+public:
+    typedef std::int64_t (*get_int_t)(const char *buffer);
+    typedef std::uint64_t (*get_uint_t)(const char *buffer);
+    typedef double (*get_double_t)(const char *buffer);
+
+    FieldAccessor() :
+        FieldAccessor(PrimitiveType::NONE, ByteOrder::SBE_LITTLE_ENDIAN, 0)
+    {
+    }
+
+    FieldAccessor(PrimitiveType primitiveType, ByteOrder byteOrder, std::int32_t offset = 0) :
+        m_getInt(resolveInt(primitiveType, byteOrder)),
+        m_getUInt(resolveUInt(primitiveType, byteOrder)),
+        m_getDouble(resolveDouble(primitiveType, byteOrder)),
+        m_offset(offset),
+        m_primitiveType(primitiveType),
+        m_byteOrder(byteOrder)
+    {
+    }
+
+    /// Accessor for the encoding of a token at the offset of the token.
+    explicit FieldAccessor(const Token& token) :
+        FieldAccessor(token.encoding().primitiveType(), token.encoding().byteOrder(), token.offset())
+    {
+    }
+
+    inline std::int64_t getAsInt(const char *buffer) const
+    {
+        return m_getInt(buffer + m_offset);
+    }
+
+    inline std::uint64_t getAsUInt(const char *buffer) const
+    {
+        return m_getUInt(buffer + m_offset);
+    }
+
+    inline double getAsDouble(const char *buffer) const
+    {
+        return m_getDouble(buffer + m_offset);
+    }
+
+    inline std::int32_t offset() const
+    {
+        return m_offset;
+    }
+
+    inline PrimitiveType primitiveType() const
+    {
+        return m_primitiveType;
+    }
+
+    inline ByteOrder byteOrder() const
+    {
+        return m_byteOrder;
+    }
+
+private:
+    get_int_t m_getInt;
+    get_uint_t m_getUInt;
+    get_double_t m_getDouble;
+    std::int32_t m_offset;
+    PrimitiveType m_primitiveType;
+    ByteOrder m_byteOrder;
+
+    template<ByteOrder byteOrder>
+    static get_int_t resolveInt(PrimitiveType primitiveType)
+    {
+        switch (primitiveType)
+        {
+            case PrimitiveType::CHAR:
+                return &detail::getIntField<char, byteOrder>;
+
+            case PrimitiveType::INT8:
+                return &detail::getIntField<std::int8_t, byteOrder>;
+
+            case PrimitiveType::INT16:
+                return &detail::getIntField<std::int16_t, byteOrder>;
+
+            case PrimitiveType::INT32:
+                return &detail::getIntField<std::int32_t, byteOrder>;
+
+            case PrimitiveType::INT64:
+                return &detail::getIntField<std::int64_t, byteOrder>;
+
+            default:
+                return &detail::getIntMismatch;
+        }
+    }
+
+    template<ByteOrder byteOrder>
+    static get_uint_t resolveUInt(PrimitiveType primitiveType)
+    {
+        switch (primitiveType)
+        {
+            case PrimitiveType::UINT8:
+                return &detail::getUIntField<std::uint8_t, byteOrder>;
+
+            case PrimitiveType::UINT16:
+                return &detail::getUIntField<std::uint16_t, byteOrder>;
+
+            case PrimitiveType::UINT32:
+                return &detail::getUIntField<std::uint32_t, byteOrder>;
+
+            case PrimitiveType::UINT64:
+                return &detail::getUIntField<std::uint64_t, byteOrder>;
+
+            default:
+                return &detail::getUIntMismatch;
+        }
+    }
+
+    template<ByteOrder byteOrder>
+    static get_double_t resolveDouble(PrimitiveType primitiveType)
+    {
+        switch (primitiveType)
+        {
+            case PrimitiveType::FLOAT:
+                return &detail::getDoubleField<float, byteOrder>;
+
+            case PrimitiveType::DOUBLE:
+                return &detail::getDoubleField<double, byteOrder>;
+
+            default:
+                return &detail::getDoubleMismatch;
+        }
+    }
+
+    static get_int_t resolveInt(PrimitiveType primitiveType, ByteOrder byteOrder)
+    {
+        return ByteOrder::SBE_BIG_ENDIAN == byteOrder ?
+            resolveInt<ByteOrder::SBE_BIG_ENDIAN>(primitiveType) :
+            resolveInt<ByteOrder::SBE_LITTLE_ENDIAN>(primitiveType);
+    }
+
+    static get_uint_t resolveUInt(PrimitiveType primitiveType, ByteOrder byteOrder)
+    {
+        return ByteOrder::SBE_BIG_ENDIAN == byteOrder ?
+            resolveUInt<ByteOrder::SBE_BIG_ENDIAN>(primitiveType) :
+            resolveUInt<ByteOrder::SBE_LITTLE_ENDIAN>(primitiveType);
+    }
+
+    static get_double_t resolveDouble(PrimitiveType primitiveType, ByteOrder byteOrder)
+    {
+        return ByteOrder::SBE_BIG_ENDIAN == byteOrder ?
+            resolveDouble<ByteOrder::SBE_BIG_ENDIAN>(primitiveType) :
+            resolveDouble<ByteOrder::SBE_LITTLE_ENDIAN>(primitiveType);
+    }
+};
+
+}}
+
+#endif
@@ -0,0 +1,423 @@
+/*
+ * Copyright 2013-2020 Real Logic Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _OTF_FIELDPROJECTION_H
+#define _OTF_FIELDPROJECTION_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <string>
+#include <stdexcept>
+
+#include "DecodePlan.h"
+#include "OtfMessageDecoder.h"
+
+namespace sbe { namespace otf {
+
+/*
+ * A DecodePlan cut down to a set of dotted field paths, e.g. "entries.mdEntryPx.mantissa".
+ *
+ * Paths are relative to the message and may optionally begin with the message name. A path naming a composite or
+ * group selects everything within it. Unselected fields are dropped, unselected groups of fixed length elements are
+ * skipped as blockLength * numInGroup, and other unselected groups and var data are only walked to find where later
+ * selected data begins. Nothing is walked after the last selected item of the message.
+ */
+class FieldProjection
+{
+public:
+    FieldProjection(const DecodePlan& plan, const std::vector<std::string>& fieldPaths) :
+        m_tokens(plan.tokensPtr())
+    {
+        const std::string& messageName = plan.beginMessageToken().name();
+
+        for (std::vector<std::string>::const_iterator it = fieldPaths.begin(); it != fieldPaths.end(); ++it)
+        {
+            const std::string& path = *it;
+            const bool hasMessagePrefix =
+                path.size() > messageName.size() && path.compare(0, messageName.size(), messageName) == 0 &&
+                path[messageName.size()] == '.';
+
+            m_fieldPaths.push_back(hasMessagePrefix ? path.substr(messageName.size() + 1) : path);
+            m_matched.push_back(false);
+        }
+
+        const std::vector<DecodeInstruction>& planInstructions = plan.instructions();
+        compileBlock(planInstructions, 0, planInstructions.size(), "");
+        trimTrailingSkips();
+
+        for (std::size_t i = 0; i < m_fieldPaths.size(); i++)
+        {
+            if (!m_matched[i])
+            {
+                throw std::runtime_error("field path not found in message: " + fieldPaths[i]);
+            }
+        }
+    }
+
+    inline const std::vector<DecodeInstruction>& instructions() const
+    {
+        return m_instructions;
+    }
+
+    inline std::vector<Token>& tokens() const
+    {
+        return *m_tokens;
+    }
+
+    inline Token& beginMessageToken() const
+    {
+        return m_tokens->front();
+    }
+
+    inline Token& endMessageToken() const
+    {
+        return m_tokens->back();
+    }
+
+private:
+    std::shared_ptr<std::vector<Token>> m_tokens;
+    std::vector<std::string> m_fieldPaths;
+    std::vector<bool> m_matched;
+    std::vector<DecodeInstruction> m_instructions;
+    std::vector<std::size_t> m_topLevelIndices;
+
+    bool isSelected(const std::string& path)
+    {
+        bool selected = false;
+
+        for (std::size_t i = 0; i < m_fieldPaths.size(); i++)
+        {
+            if (m_fieldPaths[i] == path)
+            {
+                m_matched[i] = true;
+                selected = true;
+            }
+        }
+
+        if (selected)
+        {
+            const std::string prefix = path + ".";
+
+            for (std::size_t i = 0; i < m_fieldPaths.size(); i++)
+            {
+                if (m_fieldPaths[i].compare(0, prefix.size(), prefix) == 0)
+                {
+                    m_matched[i] = true;
+                }
+            }
+        }
+
+        return selected;
+    }
+
+    bool hasSelectedWithin(const std::string& path) const
+    {
+        const std::string prefix = path + ".";
+
+        for (std::size_t i = 0; i < m_fieldPaths.size(); i++)
+        {
+            if (m_fieldPaths[i].compare(0, prefix.size(), prefix) == 0)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    std::string nameOf(const DecodeInstruction& instruction, bool isCompositeMember) const
+    {
+        const std::vector<Token>& tokens = *m_tokens;
+
+        if (OP_BEGIN_COMPOSITE == instruction.opCode)
+        {
+            return tokens[instruction.fieldTokenIndex + 1u == instruction.typeTokenIndex ?
+                instruction.fieldTokenIndex : instruction.typeTokenIndex].name();
+        }
+
+        return tokens[isCompositeMember ? instruction.typeTokenIndex : instruction.fieldTokenIndex].name();
+    }
+
+    static std::size_t endOfComposite(const std::vector<DecodeInstruction>& planInstructions, std::size_t index)
+    {
+        int depth = 0;
+
+        for (; index < planInstructions.size(); index++)
+        {
+            if (OP_BEGIN_COMPOSITE == planInstructions[index].opCode)
+            {
+                depth++;
+            }
+            else if (OP_END_COMPOSITE == planInstructions[index].opCode && --depth == 0)
+            {
+                break;
+            }
+        }
+
+        return index;
+    }
+
+    void copyInstructions(const std::vector<DecodeInstruction>& planInstructions, std::size_t from, std::size_t to)
+    {
+        const std::size_t base = m_instructions.size();
+
+        for (std::size_t i = from; i < to; i++)
+        {
+            DecodeInstruction instruction = planInstructions[i];
+
+            if (OP_GROUP == instruction.opCode)
+            {
+                instruction.next = static_cast<std::uint32_t>(instruction.next - from + base);
+            }
+
+            m_instructions.push_back(instruction);
+        }
+    }
+
+    void compileCompositeMembers(
+        const std::vector<DecodeInstruction>& planInstructions, std::size_t index, std::size_t end, const std::string& prefix)
+    {
+        while (index < end)
+        {
+            const DecodeInstruction& instruction = planInstructions[index];
+            const std::string path = prefix + nameOf(instruction, true);
+
+            if (OP_BEGIN_COMPOSITE == instruction.opCode)
+            {
+                const std::size_t endIndex = endOfComposite(planInstructions, index);
+
+                if (isSelected(path))
+                {
+                    copyInstructions(planInstructions, index, endIndex + 1);
+                }
+                else if (hasSelectedWithin(path))
+                {
+                    compileCompositeMembers(planInstructions, index + 1, endIndex, path + ".");
+                }
+
+                index = endIndex + 1;
+                continue;
+            }
+
+            if (isSelected(path))
+            {
+                m_instructions.push_back(instruction);
+            }
+
+            index++;
+        }
+    }
+
+    void compileBlock(
+        const std::vector<DecodeInstruction>& planInstructions, std::size_t index, std::size_t end, const std::string& prefix)
+    {
+        const bool isTopLevel = prefix.empty();
+
+        while (index < end)
+        {
+            const DecodeInstruction& instruction = planInstructions[index];
+            const std::string path = prefix + nameOf(instruction, false);
+
+            if (isTopLevel)
+            {
+                m_topLevelIndices.push_back(m_instructions.size());
+            }
+
+            switch (instruction.opCode)
+            {
+                case OP_BEGIN_COMPOSITE:
+                {
+                    const std::size_t endIndex = endOfComposite(planInstructions, index);
+
+                    if (isSelected(path))
+                    {
+                        copyInstructions(planInstructions, index, endIndex + 1);
+                    }
+                    else if (hasSelectedWithin(path))
+                    {
+                        compileCompositeMembers(planInstructions, index + 1, endIndex, path + ".");
+                    }
+
+                    index = endIndex + 1;
+                    break;
+                }
+
+                case OP_GROUP:
+                {
+                    if (isSelected(path))
+                    {
+                        copyInstructions(planInstructions, index, instruction.next);
+                    }
+                    else
+                    {
+                        const bool isProjected = hasSelectedWithin(path);
+                        const std::size_t groupIndex = m_instructions.size();
+                        m_instructions.push_back(instruction);
+
+                        if (isProjected)
+                        {
+                            compileBlock(planInstructions, index + 1, instruction.next, path + ".");
+                        }
+                        else
+                        {
+                            compileSkippedGroupBody(planInstructions, index + 1, instruction.next);
+                        }
+
+                        DecodeInstruction& groupInstruction = m_instructions[groupIndex];
+                        groupInstruction.next = static_cast<std::uint32_t>(m_instructions.size());
+
+                        if (!isProjected)
+                        {
+                            groupInstruction.opCode = groupInstruction.next == groupIndex + 1 ?
+                                OP_SKIP_FIXED_GROUP : OP_SKIP_GROUP;
+                        }
+                    }
+
+                    index = instruction.next;
+                    break;
+                }
+
+                case OP_VAR_DATA:
+                {
+                    m_instructions.push_back(instruction);
+
+                    if (!isSelected(path))
+                    {
+                        m_instructions.back().opCode = OP_SKIP_VAR_DATA;
+                    }
+
+                    index++;
+                    break;
+                }
+
+                default:
+                {
+                    if (isSelected(path))
+                    {
+                        m_instructions.push_back(instruction);
+                    }
+
+                    index++;
+                    break;
+                }
+            }
+
+            if (isTopLevel && m_topLevelIndices.back() == m_instructions.size())
+            {
+                m_topLevelIndices.pop_back();
+            }
+        }
+    }
+
+    void compileSkippedGroupBody(const std::vector<DecodeInstruction>& planInstructions, std::size_t index, std::size_t end)
+    {
+        while (index < end)
+        {
+            const DecodeInstruction& instruction = planInstructions[index];
+
+            if (OP_GROUP == instruction.opCode)
+            {
+                const std::size_t groupIndex = m_instructions.size();
+                m_instructions.push_back(instruction);
+                compileSkippedGroupBody(planInstructions, index + 1, instruction.next);
+
+                DecodeInstruction& groupInstruction = m_instructions[groupIndex];
+                groupInstruction.next = static_cast<std::uint32_t>(m_instructions.size());
+                groupInstruction.opCode = groupInstruction.next == groupIndex + 1 ? OP_SKIP_FIXED_GROUP : OP_SKIP_GROUP;
+
+                index = instruction.next;
+                continue;
+            }
+
+            if (OP_VAR_DATA == instruction.opCode)
+            {
+                m_instructions.push_back(instruction);
+                m_instructions.back().opCode = OP_SKIP_VAR_DATA;
+            }
+
+            index++;
+        }
+    }
+
+    void trimTrailingSkips()
+    {
+        while (!m_topLevelIndices.empty())
+        {
+            const DecodeOpCode opCode = m_instructions[m_topLevelIndices.back()].opCode;
+
+            if (OP_SKIP_GROUP != opCode && OP_SKIP_FIXED_GROUP != opCode && OP_SKIP_VAR_DATA != opCode)
+            {
+                break;
+            }
+
+            m_instructions.resize(m_topLevelIndices.back());
+            m_topLevelIndices.pop_back();
+        }
+    }
+};
+
+namespace OtfMessageDecoder {
+
+/**
+ * Entry point for decoder raising events only for the fields selected by a FieldProjection. Returns the length of the
+ * message up to the end of the last selected group or var data, or the blockLength if none are selected.
+ */
+template<typename TokenListener>
+std::size_t decode(
+    const char *buffer,
+    const std::size_t length,
+    std::uint64_t actingVersion,
+    size_t blockLength,
+    const FieldProjection& projection,
+    TokenListener& listener)
+{
+    const std::uint32_t interest = TokenListenerTraits<TokenListener>::interest;
+
+    if (interest & INTEREST_BEGIN_MESSAGE)
+    {
+        listener.onBeginMessage(projection.beginMessageToken());
+    }
+
+    if (length < blockLength)
+    {
+        throw std::runtime_error("length too short for message blockLength");
+    }
+
+    const std::size_t bufferIndex = decodePlanInstructions(
+        buffer,
+        0,
+        blockLength,
+        length,
+        actingVersion,
+        projection.tokens(),
+        projection.instructions().data(),
+        0,
+        projection.instructions().size(),
+        listener);
+
+    if (interest & INTEREST_END_MESSAGE)
+    {
+        listener.onEndMessage(projection.endMessageToken());
+    }
+
+    return bufferIndex;
+}
+
+}
+
+}}
+
+#endif
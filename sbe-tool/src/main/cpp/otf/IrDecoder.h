@@ -26,7 +26,9 @@
 #else
 #include <sys/types.h>
 #include <sys/uio.h>
+#include <sys/mman.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <sys/stat.h>
 #endif /* WIN32 */
 
@@ -36,9 +38,13 @@
 #include <functional>
 #include <algorithm>
 #include <iostream>
+#include <unordered_map>
+#include <mutex>
 
 #include "uk_co_real_logic_sbe_ir_generated/uk_co_real_logic_sbe_ir_generated_cpp.h"
 #include "Token.h"
+#include "StringPool.h"
+#include "EnumIndex.h"
 
 using namespace sbe::otf;
 
@@ -48,20 +54,45 @@ class IrDecoder
 {
 public:
     IrDecoder() :
-        m_length(0)
+        m_irBuffer(nullptr),
+        m_length(0),
+        m_id(0)
     {
     }
 
     int decode(char *irBuffer, std::uint64_t length)
     {
-        m_length = length;
-        if (m_length == 0)
+        if (length == 0)
         {
             return -1;
         }
-        std::unique_ptr<char[]> buffer(new char[static_cast<size_t>(m_length)]);
+
+        releaseBuffer();
+
+        std::unique_ptr<char[]> buffer(new char[static_cast<size_t>(length)]);
         m_buffer = std::move(buffer);
-        std::memcpy(m_buffer.get(), irBuffer, static_cast<size_t>(m_length));
+        std::memcpy(m_buffer.get(), irBuffer, static_cast<size_t>(length));
+        m_irBuffer = m_buffer.get();
+        m_length = length;
+
+        return decodeIr();
+    }
+
+    /*
+     * Decode IR held in memory owned by the caller without copying it. The buffer must remain valid and unchanged
+     * for as long as the decoder is used as message tokens are materialized from it on first lookup.
+     */
+    int decodeInPlace(const char *irBuffer, std::uint64_t length)
+    {
+        if (length == 0)
+        {
+            return -1;
+        }
+
+        releaseBuffer();
+
+        m_irBuffer = irBuffer;
+        m_length = length;
 
         return decodeIr();
     }
@@ -70,71 +101,98 @@ public:
     {
         long long fileSize = getFileSize(filename);
 
-        if (fileSize < 0)
+        if (fileSize <= 0)
         {
             return -1;
         }
 
-        m_length = static_cast<std::uint64_t>(fileSize);
-        if (m_length == 0)
+        releaseBuffer();
+
+        const std::uint64_t length = static_cast<std::uint64_t>(fileSize);
+
+#if defined(WIN32) || defined(_WIN32)
+        std::unique_ptr<char[]> buffer(new char[static_cast<size_t>(length)]);
+        m_buffer = std::move(buffer);
+
+        if (readFileIntoBuffer(m_buffer.get(), filename, length) < 0)
         {
             return -1;
         }
-        std::unique_ptr<char[]> buffer(new char[static_cast<size_t>(m_length)]);
-        m_buffer = std::move(buffer);
 
-        if (readFileIntoBuffer(m_buffer.get(), filename, m_length) < 0)
+        m_irBuffer = m_buffer.get();
+#else
+        m_mappedBuffer = mapFile(filename, length);
+
+        if (!m_mappedBuffer)
         {
             return -1;
         }
 
+        m_irBuffer = m_mappedBuffer.get();
+#endif
+        m_length = length;
+
         return decodeIr();
     }
 
-    std::shared_ptr<std::vector<Token>> header()
+    std::shared_ptr<std::vector<Token>> header() const
     {
         return m_headerTokens;
     }
 
-    std::vector<std::shared_ptr<std::vector<Token>>> messages()
+    const std::vector<std::shared_ptr<std::vector<Token>>>& messages() const
     {
+        for (std::size_t i = 0; i < m_messages.size(); i++)
+        {
+            materializeMessage(i);
+        }
+
         return m_messages;
     }
 
-    std::shared_ptr<std::vector<Token>> message(int id, int version)
+    std::shared_ptr<std::vector<Token>> message(int id, int version) const
     {
-        std::shared_ptr<std::vector<Token>> result;
+        const std::shared_ptr<std::vector<Token>> *tokens = findMessage(id, version);
 
-        std::for_each(m_messages.begin(), m_messages.end(),
-            [&](std::shared_ptr<std::vector<Token>> tokens)
-            {
-                Token& token = tokens->at(0);
+        return nullptr != tokens ? *tokens : std::shared_ptr<std::vector<Token>>();
+    }
 
-                if (token.signal() == Signal::BEGIN_MESSAGE && token.fieldId() == id && token.tokenVersion() == version)
-                {
-                    result = tokens;
-                }
-            });
+    std::shared_ptr<std::vector<Token>> message(int id) const
+    {
+        const std::shared_ptr<std::vector<Token>> *tokens = findMessage(id);
 
-        return result;
+        return nullptr != tokens ? *tokens : std::shared_ptr<std::vector<Token>>();
     }
 
-    std::shared_ptr<std::vector<Token>> message(int id)
+    /*
+     * Lookup of the tokens for a templateId without copying. The pointer remains valid until the next decode.
+     * When the same templateId appears more than once the last one in the IR is returned.
+     */
+    const std::shared_ptr<std::vector<Token>> *findMessage(int id) const
     {
-        std::shared_ptr<std::vector<Token>> result;
+        const TemplateEntry *entry = findTemplate(id);
 
-        std::for_each(m_messages.begin(), m_messages.end(),
-            [&](std::shared_ptr<std::vector<Token>> tokens)
+        return nullptr != entry ? &materializeMessage(entry->latest) : nullptr;
+    }
+
+    const std::shared_ptr<std::vector<Token>> *findMessage(int id, int version) const
+    {
+        const TemplateEntry *entry = findTemplate(id);
+
+        if (nullptr != entry)
+        {
+            for (std::size_t i = entry->versions.size(); i > 0; i--)
             {
-                Token& token = tokens->at(0);
+                const std::pair<int, std::size_t>& versionEntry = entry->versions[i - 1];
 
-                if (token.signal() == Signal::BEGIN_MESSAGE && token.fieldId() == id)
+                if (versionEntry.first == version)
                 {
-                    result = tokens;
+                    return &materializeMessage(versionEntry.second);
                 }
-            });
+            }
+        }
 
-        return result;
+        return nullptr;
     }
 
 protected:
@@ -178,32 +236,132 @@ protected:
         return remaining == 0 ? 0 : -1;
     }
 
+#if !defined(WIN32) && !defined(_WIN32)
+    struct FileUnmapper
+    {
+        std::uint64_t length;
+
+        void operator()(char *address) const
+        {
+            ::munmap(address, static_cast<size_t>(length));
+        }
+    };
+
+    typedef std::unique_ptr<char, FileUnmapper> MappedFile;
+
+    static MappedFile mapFile(const char *filename, std::uint64_t length)
+    {
+        int fd = ::open(filename, O_RDONLY);
+
+        if (fd < 0)
+        {
+            return MappedFile(nullptr, FileUnmapper{ 0 });
+        }
+
+        void *address = ::mmap(nullptr, static_cast<size_t>(length), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+
+        return MAP_FAILED != address ?
+            MappedFile(static_cast<char *>(address), FileUnmapper{ length }) : MappedFile(nullptr, FileUnmapper{ 0 });
+    }
+#endif
+
 private:
+    struct TemplateEntry
+    {
+        std::size_t latest;
+        std::vector<std::pair<int, std::size_t>> versions;
+    };
+
+    struct MessageExtent
+    {
+        std::uint64_t offset;
+        std::int32_t id;
+        std::int32_t version;
+        bool isMessage;
+    };
+
     std::shared_ptr<std::vector<Token>> m_headerTokens;
-    std::vector<std::shared_ptr<std::vector<Token>>> m_messages;
+    mutable std::vector<std::shared_ptr<std::vector<Token>>> m_messages;
+    mutable std::unique_ptr<std::once_flag[]> m_messageOnceFlags;
+    std::vector<MessageExtent> m_messageExtents;
+    std::vector<TemplateEntry> m_templates;
+    std::vector<std::int32_t> m_denseTemplateIndex;
+    std::unordered_map<int, std::size_t> m_sparseTemplateIndex;
     std::unique_ptr<char[]> m_buffer;
+    const char *m_irBuffer;
     std::uint64_t m_length;
+#if !defined(WIN32) && !defined(_WIN32)
+    MappedFile m_mappedBuffer;
+#endif
     int m_id;
 
+    /*
+     * Messages from a previous decode are materialized before their buffer goes away as they are retained.
+     */
+    void releaseBuffer()
+    {
+        for (std::size_t i = 0; i < m_messages.size(); i++)
+        {
+            materializeMessage(i);
+        }
+
+#if !defined(WIN32) && !defined(_WIN32)
+        m_mappedBuffer.reset();
+#endif
+        m_buffer.reset();
+        m_irBuffer = nullptr;
+        m_length = 0;
+    }
+
+    const std::shared_ptr<std::vector<Token>>& materializeMessage(std::size_t index) const
+    {
+        std::call_once(m_messageOnceFlags[index], [&]()
+        {
+            if (!m_messages[index])
+            {
+                std::shared_ptr<std::vector<Token>> tokensForMessage(new std::vector<Token>());
+                const std::uint64_t offset = m_messageExtents[index].offset;
+                std::uint64_t size = 0;
+
+                while (offset + size < m_length)
+                {
+                    size += decodeAndAddToken(tokensForMessage, offset + size);
+
+                    Token& token = tokensForMessage->back();
+
+                    if (token.signal() == Signal::END_MESSAGE)
+                    {
+                        break;
+                    }
+                }
+
+                EnumIndex::indexEnums(*tokensForMessage);
+                m_messages[index] = tokensForMessage;
+            }
+        });
+
+        return m_messages[index];
+    }
+
     int decodeIr()
     {
         using namespace uk::co::real_logic::sbe::ir::generated;
 
         FrameCodec frame;
         std::uint64_t offset = 0;
-        char tmp[256];
 
-        frame.wrapForDecode(m_buffer.get(), offset, frame.sbeBlockLength(), frame.sbeSchemaVersion(), m_length);
+        frame.wrapForDecode(const_cast<char *>(m_irBuffer), offset, frame.sbeBlockLength(), frame.sbeSchemaVersion(), m_length);
 
-        frame.getPackageName(tmp, sizeof(tmp));
+        frame.packageNameSkip();
 
         if (frame.irVersion() != 0)
         {
             return -1;
         }
 
-        frame.getNamespaceName(tmp, sizeof(tmp));
-        frame.getSemanticVersion(tmp, sizeof(tmp));
+        frame.namespaceNameSkip();
+        frame.semanticVersionSkip();
 
         offset += frame.encodedLength();
 
@@ -220,15 +378,116 @@ private:
             offset += readMessage(offset);
         }
 
+        std::unique_ptr<std::once_flag[]> onceFlags(new std::once_flag[m_messages.size()]);
+        m_messageOnceFlags = std::move(onceFlags);
+
+        buildTemplateIndex();
+
         return 0;
     }
 
-    std::uint64_t decodeAndAddToken(std::shared_ptr<std::vector<Token>>& tokens, std::uint64_t offset)
+    const TemplateEntry *findTemplate(int id) const
+    {
+        if (id >= 0 && static_cast<std::size_t>(id) < m_denseTemplateIndex.size())
+        {
+            const std::int32_t index = m_denseTemplateIndex[static_cast<std::size_t>(id)];
+
+            return index >= 0 ? &m_templates[static_cast<std::size_t>(index)] : nullptr;
+        }
+
+        if (m_sparseTemplateIndex.empty())
+        {
+            return nullptr;
+        }
+
+        std::unordered_map<int, std::size_t>::const_iterator it = m_sparseTemplateIndex.find(id);
+
+        return it != m_sparseTemplateIndex.end() ? &m_templates[it->second] : nullptr;
+    }
+
+    /*
+     * Template ids are usually small and contiguous so are indexed directly, anything outside of a table
+     * a few times the number of templates falls back to a hash lookup.
+     */
+    void buildTemplateIndex()
+    {
+        std::unordered_map<int, std::size_t> templateIndex;
+
+        m_templates.clear();
+        m_denseTemplateIndex.clear();
+        m_sparseTemplateIndex.clear();
+
+        for (std::size_t i = 0; i < m_messageExtents.size(); i++)
+        {
+            const MessageExtent& extent = m_messageExtents[i];
+
+            if (!extent.isMessage)
+            {
+                continue;
+            }
+
+            std::unordered_map<int, std::size_t>::iterator it = templateIndex.find(extent.id);
+            if (it == templateIndex.end())
+            {
+                it = templateIndex.insert(std::make_pair(extent.id, m_templates.size())).first;
+                m_templates.push_back(TemplateEntry());
+            }
+
+            TemplateEntry& entry = m_templates[it->second];
+            entry.latest = i;
+            entry.versions.push_back(std::make_pair(extent.version, i));
+        }
+
+        const std::size_t denseLimit = std::max<std::size_t>(256, 4 * m_templates.size());
+        std::size_t denseLength = 0;
+
+        for (std::unordered_map<int, std::size_t>::const_iterator it = templateIndex.begin(); it != templateIndex.end(); ++it)
+        {
+            if (it->first >= 0 && static_cast<std::size_t>(it->first) < denseLimit)
+            {
+                denseLength = std::max(denseLength, static_cast<std::size_t>(it->first) + 1);
+            }
+        }
+
+        m_denseTemplateIndex.assign(denseLength, -1);
+
+        for (std::unordered_map<int, std::size_t>::const_iterator it = templateIndex.begin(); it != templateIndex.end(); ++it)
+        {
+            if (it->first >= 0 && static_cast<std::size_t>(it->first) < denseLength)
+            {
+                m_denseTemplateIndex[static_cast<std::size_t>(it->first)] = static_cast<std::int32_t>(it->second);
+            }
+            else
+            {
+                m_sparseTemplateIndex.insert(*it);
+            }
+        }
+    }
+
+    static void skipVarData(uk::co::real_logic::sbe::ir::generated::TokenCodec& tokenCodec)
+    {
+        tokenCodec.nameSkip();
+        tokenCodec.constValueSkip();
+        tokenCodec.lsbValueSkip();
+        tokenCodec.msbValueSkip();
+        tokenCodec.minValueSkip();
+        tokenCodec.maxValueSkip();
+        tokenCodec.nullValueSkip();
+        tokenCodec.characterEncodingSkip();
+        tokenCodec.epochSkip();
+        tokenCodec.timeUnitSkip();
+        tokenCodec.semanticTypeSkip();
+        tokenCodec.descriptionSkip();
+        tokenCodec.referencedNameSkip();
+    }
+
+    std::uint64_t decodeAndAddToken(std::shared_ptr<std::vector<Token>>& tokens, std::uint64_t offset) const
     {
         using namespace uk::co::real_logic::sbe::ir::generated;
 
         TokenCodec tokenCodec;
-        tokenCodec.wrapForDecode(m_buffer.get(), offset, tokenCodec.sbeBlockLength(), tokenCodec.sbeSchemaVersion(), m_length);
+        tokenCodec.wrapForDecode(
+            const_cast<char *>(m_irBuffer), offset, tokenCodec.sbeBlockLength(), tokenCodec.sbeSchemaVersion(), m_length);
 
         Signal signal = static_cast<Signal>(tokenCodec.signal());
         PrimitiveType type = static_cast<PrimitiveType>(tokenCodec.primitiveType());
@@ -240,47 +499,48 @@ private:
         std::int32_t version = tokenCodec.tokenVersion();
         std::int32_t componentTokenCount = tokenCodec.componentTokenCount();
         std::int32_t arrayCapacity = tokenCodec.arrayCapacity();
-        char tmpBuffer[256];
         std::uint64_t tmpLen = 0;
 
-        tmpLen = tokenCodec.getName(tmpBuffer, sizeof(tmpBuffer));
-        std::string name(tmpBuffer, static_cast<std::size_t>(tmpLen));
+        tmpLen = tokenCodec.nameLength();
+        const std::string *name = StringPool::intern(tokenCodec.name(), static_cast<std::size_t>(tmpLen));
 
-        tmpLen = tokenCodec.getConstValue(tmpBuffer, sizeof(tmpBuffer));
-        PrimitiveValue constValue(type, tmpLen, tmpBuffer);
+        tmpLen = tokenCodec.constValueLength();
+        PrimitiveValue constValue(type, tmpLen, tokenCodec.constValue());
 
-        tmpLen = tokenCodec.getLsbValue(tmpBuffer, sizeof(tmpBuffer));
-        PrimitiveValue lsbValue(type, tmpLen, tmpBuffer);
+        tmpLen = tokenCodec.lsbValueLength();
+        PrimitiveValue lsbValue(type, tmpLen, tokenCodec.lsbValue());
 
-        tmpLen = tokenCodec.getMsbValue(tmpBuffer, sizeof(tmpBuffer));
-        PrimitiveValue msbValue(type, tmpLen, tmpBuffer);
+        tmpLen = tokenCodec.msbValueLength();
+        PrimitiveValue msbValue(type, tmpLen, tokenCodec.msbValue());
 
-        tmpLen = tokenCodec.getMinValue(tmpBuffer, sizeof(tmpBuffer));
-        PrimitiveValue minValue(type, tmpLen, tmpBuffer);
+        tmpLen = tokenCodec.minValueLength();
+        PrimitiveValue minValue(type, tmpLen, tokenCodec.minValue());
 
-        tmpLen = tokenCodec.getMaxValue(tmpBuffer, sizeof(tmpBuffer));
-        PrimitiveValue maxValue(type, tmpLen, tmpBuffer);
+        tmpLen = tokenCodec.maxValueLength();
+        PrimitiveValue maxValue(type, tmpLen, tokenCodec.maxValue());
 
-        tmpLen = tokenCodec.getNullValue(tmpBuffer, sizeof(tmpBuffer));
-        PrimitiveValue nullValue(type, tmpLen, tmpBuffer);
+        tmpLen = tokenCodec.nullValueLength();
+        PrimitiveValue nullValue(type, tmpLen, tokenCodec.nullValue());
 
-        tmpLen = tokenCodec.getCharacterEncoding(tmpBuffer, sizeof(tmpBuffer));
-        std::string characterEncoding(tmpBuffer, static_cast<size_t>(tmpLen));
+        tmpLen = tokenCodec.characterEncodingLength();
+        const std::string *characterEncoding = StringPool::intern(
+            tokenCodec.characterEncoding(), static_cast<std::size_t>(tmpLen));
 
-        tmpLen = tokenCodec.getEpoch(tmpBuffer, sizeof(tmpBuffer));
-        std::string epoch(tmpBuffer, static_cast<size_t>(tmpLen));
+        tmpLen = tokenCodec.epochLength();
+        const std::string *epoch = StringPool::intern(tokenCodec.epoch(), static_cast<std::size_t>(tmpLen));
 
-        tmpLen = tokenCodec.getTimeUnit(tmpBuffer, sizeof(tmpBuffer));
-        std::string timeUnit(tmpBuffer, static_cast<size_t>(tmpLen));
+        tmpLen = tokenCodec.timeUnitLength();
+        const std::string *timeUnit = StringPool::intern(tokenCodec.timeUnit(), static_cast<std::size_t>(tmpLen));
 
-        tmpLen = tokenCodec.getSemanticType(tmpBuffer, sizeof(tmpBuffer));
-        std::string semanticType(tmpBuffer, static_cast<size_t>(tmpLen));
+        tmpLen = tokenCodec.semanticTypeLength();
+        const std::string *semanticType = StringPool::intern(
+            tokenCodec.semanticType(), static_cast<std::size_t>(tmpLen));
 
-        tmpLen = tokenCodec.getDescription(tmpBuffer, sizeof(tmpBuffer));
-        std::string description(tmpBuffer, static_cast<size_t>(tmpLen));
+        tmpLen = tokenCodec.descriptionLength();
+        const std::string *description = StringPool::intern(
+            tokenCodec.description(), static_cast<std::size_t>(tmpLen));
 
-        tmpLen = tokenCodec.getReferencedName(tmpBuffer, sizeof(tmpBuffer));
-        std::string referencedName(tmpBuffer, static_cast<size_t>(tmpLen));
+        tokenCodec.referencedNameSkip();
 
         Encoding encoding(
             type, presence, byteOrder, minValue, maxValue, nullValue,
@@ -310,28 +570,52 @@ private:
             }
         }
 
+        EnumIndex::indexEnums(*m_headerTokens);
+
         return size;
     }
 
+    /*
+     * Only the fixed block of each token is read to find the extent of a message, its tokens are decoded
+     * on first lookup.
+     */
     std::uint64_t readMessage(std::uint64_t offset)
     {
-        std::uint64_t size = 0;
+        using namespace uk::co::real_logic::sbe::ir::generated;
 
-        std::shared_ptr<std::vector<Token>> tokensForMessage(new std::vector<Token>());
+        std::uint64_t size = 0;
+        MessageExtent extent = { offset, 0, 0, false };
 
         while (offset + size < m_length)
         {
-            size += decodeAndAddToken(tokensForMessage, offset + size);
+            TokenCodec tokenCodec;
+            tokenCodec.wrapForDecode(
+                const_cast<char *>(m_irBuffer),
+                offset + size,
+                tokenCodec.sbeBlockLength(),
+                tokenCodec.sbeSchemaVersion(),
+                m_length);
+
+            const Signal signal = static_cast<Signal>(tokenCodec.signal());
+
+            if (0 == size)
+            {
+                extent.id = tokenCodec.fieldId();
+                extent.version = tokenCodec.tokenVersion();
+                extent.isMessage = signal == Signal::BEGIN_MESSAGE;
+            }
 
-            Token& token = tokensForMessage->back();
+            skipVarData(tokenCodec);
+            size += tokenCodec.encodedLength();
 
-            if (token.signal() == Signal::END_MESSAGE)
+            if (signal == Signal::END_MESSAGE)
             {
                 break;
             }
         }
 
-        m_messages.push_back(tokensForMessage);
+        m_messages.push_back(std::shared_ptr<std::vector<Token>>());
+        m_messageExtents.push_back(extent);
 
         return size;
     }
@@ -17,6 +17,7 @@
 #define _OTF_HEADERDECODER_H
 
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <vector>
 #include <string>
@@ -27,6 +28,21 @@
 namespace sbe {
 namespace otf {
 
+/// Fields of a message header decoded together
+struct OtfHeaderFields
+{
+    std::uint64_t blockLength;
+    std::uint64_t templateId;
+    std::uint64_t schemaId;
+    std::uint64_t schemaVersion;
+};
+
+/*
+ * Decodes message headers using the offsets and types of the header tokens.
+ *
+ * A header of four little endian uint16 fields within its first 8 bytes, as with the standard messageHeader, is
+ * detected on construction and decoded with a single 64 bit load and shifts instead of a lookup per field.
+ */
 class OtfHeaderDecoder
 {
 public:
@@ -96,6 +112,16 @@ public:
         m_schemaVersionOffset = versionToken->offset();
         m_schemaVersionType = versionToken->encoding().primitiveType();
         m_schemaVersionByteOrder = versionToken->encoding().byteOrder();
+
+        m_isPackedUInt16 = m_encodedLength >= static_cast<std::int32_t>(sizeof(std::uint64_t)) &&
+            isPackedUInt16(*blockLengthToken) &&
+            isPackedUInt16(*templateIdToken) &&
+            isPackedUInt16(*schemaIdToken) &&
+            isPackedUInt16(*versionToken);
+        m_blockLengthShift = static_cast<std::uint32_t>(m_blockLengthOffset * 8);
+        m_templateIdShift = static_cast<std::uint32_t>(m_templateIdOffset * 8);
+        m_schemaIdShift = static_cast<std::uint32_t>(m_schemaIdOffset * 8);
+        m_schemaVersionShift = static_cast<std::uint32_t>(m_schemaVersionOffset * 8);
     }
 
     inline std::uint32_t encodedLength() const
@@ -109,24 +135,77 @@ public:
 
     std::uint64_t getTemplateId(const char *headerBuffer) const
     {
+        if (m_isPackedUInt16)
+        {
+            return (loadPacked(headerBuffer) >> m_templateIdShift) & 0xFFFF;
+        }
+
         return Encoding::getUInt(m_templateIdType, m_templateIdByteOrder, headerBuffer + m_templateIdOffset);
     }
 
     std::uint64_t getSchemaId(const char *headerBuffer) const
     {
+        if (m_isPackedUInt16)
+        {
+            return (loadPacked(headerBuffer) >> m_schemaIdShift) & 0xFFFF;
+        }
+
         return Encoding::getUInt(m_schemaIdType, m_schemaIdByteOrder, headerBuffer + m_schemaIdOffset);
     }
 
     std::uint64_t getSchemaVersion(const char *headerBuffer) const
     {
+        if (m_isPackedUInt16)
+        {
+            return (loadPacked(headerBuffer) >> m_schemaVersionShift) & 0xFFFF;
+        }
+
         return Encoding::getUInt(m_schemaVersionType, m_schemaVersionByteOrder, headerBuffer + m_schemaVersionOffset);
     }
 
     std::uint64_t getBlockLength(const char *headerBuffer) const
     {
+        if (m_isPackedUInt16)
+        {
+            return (loadPacked(headerBuffer) >> m_blockLengthShift) & 0xFFFF;
+        }
+
         return Encoding::getUInt(m_blockLengthType, m_blockLengthByteOrder, headerBuffer + m_blockLengthOffset);
     }
 
+    /*
+     * Decode every field of the header at once, reading the buffer only once for a packed uint16 header.
+     */
+    inline OtfHeaderFields getFields(const char *headerBuffer) const
+    {
+        OtfHeaderFields fields;
+
+        if (m_isPackedUInt16)
+        {
+            const std::uint64_t header = loadPacked(headerBuffer);
+
+            fields.blockLength = (header >> m_blockLengthShift) & 0xFFFF;
+            fields.templateId = (header >> m_templateIdShift) & 0xFFFF;
+            fields.schemaId = (header >> m_schemaIdShift) & 0xFFFF;
+            fields.schemaVersion = (header >> m_schemaVersionShift) & 0xFFFF;
+        }
+        else
+        {
+            fields.blockLength = getBlockLength(headerBuffer);
+            fields.templateId = getTemplateId(headerBuffer);
+            fields.schemaId = getSchemaId(headerBuffer);
+            fields.schemaVersion = getSchemaVersion(headerBuffer);
+        }
+
+        return fields;
+    }
+
+    /// True if the header is decoded with the single load fast path.
+    inline bool isPackedUInt16() const
+    {
+        return m_isPackedUInt16;
+    }
+
 private:
     std::int32_t m_encodedLength;
     std::int32_t m_blockLengthOffset;
@@ -141,6 +220,28 @@ private:
     ByteOrder m_templateIdByteOrder;
     ByteOrder m_schemaIdByteOrder;
     ByteOrder m_schemaVersionByteOrder;
+    bool m_isPackedUInt16;
+    std::uint32_t m_blockLengthShift;
+    std::uint32_t m_templateIdShift;
+    std::uint32_t m_schemaIdShift;
+    std::uint32_t m_schemaVersionShift;
+
+    static bool isPackedUInt16(const Token& token)
+    {
+        return PrimitiveType::UINT16 == token.encoding().primitiveType() &&
+            ByteOrder::SBE_LITTLE_ENDIAN == token.encoding().byteOrder() &&
+            token.offset() >= 0 &&
+            (token.offset() + static_cast<std::int32_t>(sizeof(std::uint16_t))) <=
+                static_cast<std::int32_t>(sizeof(std::uint64_t));
+    }
+
+    static inline std::uint64_t loadPacked(const char *headerBuffer)
+    {
+        std::uint64_t header;
+        std::memcpy(&header, headerBuffer, sizeof(header));
+
+        return SBE_OTF_BYTE_ORDER_64(ByteOrder::SBE_LITTLE_ENDIAN, header);
+    }
 };
 
 }}
@@ -0,0 +1,552 @@
+/*
+ * Copyright 2013-2020 Real Logic Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _OTF_JSONPRINTER_H
+#define _OTF_JSONPRINTER_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "Token.h"
+#include "EnumIndex.h"
+#include "OtfMessageDecoder.h"
+
+namespace sbe { namespace otf {
+
+/*
+ * Listener writing each decoded message as a single line of JSON appended to a caller supplied string, in the shape of
+ * the Java JsonTokenListener: composites as objects, groups as arrays of objects, enums as their names, and sets as
+ * objects of their choices.
+ *
+ * Nothing is allocated per message once the output has grown to hold the longest run of messages between calls to
+ * clear. Integers are formatted without the C library, floating point values are formatted into a stack buffer, and
+ * strings are escaped 16 bytes at a time on SSE2 targets. Values which JSON cannot represent, NaN, infinity, unknown
+ * enum values, and optional fields absent in the acting version, are written as null. Var data is written as a string
+ * when UTF-8, with bytes above 0x7F escaped as \u00XX for other character encodings, and as hex when it has none.
+ */
+class OtfJsonPrinter : public OtfMessageDecoder::StaticTokenListener<OtfJsonPrinter>
+{
+public:
+    explicit OtfJsonPrinter(std::string& output) :
+        m_output(output),
+        m_compositeLevel(0),
+        m_isFirst(true)
+    {
+    }
+
+    inline std::string& output()
+    {
+        return m_output;
+    }
+
+    void onBeginMessage(Token& token)
+    {
+        m_compositeLevel = 0;
+        open('{');
+    }
+
+    void onEndMessage(Token& token)
+    {
+        close('}');
+        m_output += '\n';
+    }
+
+    void onEncoding(
+        Token& fieldToken,
+        const char *buffer,
+        Token& typeToken,
+        std::uint64_t actingVersion)
+    {
+        property(m_compositeLevel > 0 ? typeToken.name() : fieldToken.name());
+
+        const Encoding& encoding = typeToken.encoding();
+
+        if (typeToken.isConstantEncoding())
+        {
+            appendConstant(encoding.primitiveType(), encoding.constValue());
+        }
+        else if (isAbsent(fieldToken, typeToken, actingVersion))
+        {
+            m_output += "null";
+        }
+        else if (PrimitiveType::CHAR == encoding.primitiveType())
+        {
+            const std::size_t length = static_cast<std::size_t>(typeToken.encodedLength());
+            const void *end = std::memchr(buffer, '\0', length);
+
+            appendString(
+                buffer,
+                nullptr != end ? static_cast<std::size_t>(static_cast<const char *>(end) - buffer) : length,
+                !isUtf8(encoding.characterEncoding()));
+        }
+        else
+        {
+            const std::size_t elementLength = lengthOfType(encoding.primitiveType());
+            const std::size_t count = elementLength > 0 ?
+                static_cast<std::size_t>(typeToken.encodedLength()) / elementLength : 0;
+
+            if (1 == count)
+            {
+                appendValue(encoding, buffer);
+            }
+            else
+            {
+                m_output += '[';
+
+                for (std::size_t i = 0; i < count; i++)
+                {
+                    if (i > 0)
+                    {
+                        m_output += ',';
+                    }
+
+                    appendValue(encoding, buffer + (i * elementLength));
+                }
+
+                m_output += ']';
+            }
+        }
+    }
+
+    void onEnum(
+        Token& fieldToken,
+        const char *buffer,
+        std::vector<Token>& tokens,
+        std::size_t fromIndex,
+        std::size_t toIndex,
+        std::uint64_t actingVersion)
+    {
+        property(m_compositeLevel > 0 ? tokens[fromIndex].name() : fieldToken.name());
+
+        if (fieldToken.isConstantEncoding())
+        {
+            const PrimitiveValue& constValue = fieldToken.encoding().constValue();
+            const char *refValue = constValue.getArray();
+            const char *dot = static_cast<const char *>(std::memchr(refValue, '.', constValue.size()));
+            const char *name = nullptr != dot ? dot + 1 : refValue;
+
+            appendString(name, constValue.size() - static_cast<std::size_t>(name - refValue));
+            return;
+        }
+
+        if (isAbsent(fieldToken, tokens[fromIndex], actingVersion))
+        {
+            m_output += "null";
+            return;
+        }
+
+        const EnumIndex *enumIndex = tokens[fromIndex].enumIndex();
+        const Token *validValue = nullptr != enumIndex ?
+            enumIndex->find(tokens, buffer) : EnumIndex::scan(tokens, fromIndex, toIndex, buffer);
+
+        if (nullptr != validValue)
+        {
+            appendString(validValue->name().data(), validValue->name().size());
+        }
+        else
+        {
+            m_output += "null";
+        }
+    }
+
+    void onBitSet(
+        Token& fieldToken,
+        const char *buffer,
+        std::vector<Token>& tokens,
+        std::size_t fromIndex,
+        std::size_t toIndex,
+        std::uint64_t actingVersion)
+    {
+        property(m_compositeLevel > 0 ? tokens[fromIndex].name() : fieldToken.name());
+
+        const std::uint64_t encodedValue = isAbsent(fieldToken, tokens[fromIndex], actingVersion) ?
+            0 : tokens[fromIndex].encoding().getAsUInt(buffer);
+
+        open('{');
+
+        for (std::size_t i = fromIndex + 1; i < toIndex; i++)
+        {
+            const Encoding& encoding = tokens[i].encoding();
+            const std::uint64_t bits = encoding.getBits(encodedValue);
+
+            property(tokens[i].name());
+
+            if (1 == encoding.bitLength())
+            {
+                m_output += 0 != bits ? "true" : "false";
+            }
+            else if (Encoding::isInt(encoding.primitiveType()))
+            {
+                appendInt(static_cast<std::int64_t>(bits));
+            }
+            else
+            {
+                appendUInt(bits);
+            }
+        }
+
+        close('}');
+    }
+
+    void onBeginComposite(
+        Token& fieldToken,
+        std::vector<Token>& tokens,
+        std::size_t fromIndex,
+        std::size_t toIndex)
+    {
+        m_compositeLevel++;
+        property(m_compositeLevel > 1 ? tokens[fromIndex].name() : fieldToken.name());
+        open('{');
+    }
+
+    void onEndComposite(
+        Token& fieldToken,
+        std::vector<Token>& tokens,
+        std::size_t fromIndex,
+        std::size_t toIndex)
+    {
+        m_compositeLevel--;
+        close('}');
+    }
+
+    void onGroupHeader(
+        Token& token,
+        std::uint64_t numInGroup)
+    {
+        property(token.name());
+
+        if (0 == numInGroup)
+        {
+            m_output += "[]";
+        }
+        else
+        {
+            open('[');
+        }
+    }
+
+    void onBeginGroup(
+        Token& token,
+        std::uint64_t groupIndex,
+        std::uint64_t numInGroup)
+    {
+        separator();
+        open('{');
+    }
+
+    void onEndGroup(
+        Token& token,
+        std::uint64_t groupIndex,
+        std::uint64_t numInGroup)
+    {
+        close('}');
+
+        if (groupIndex + 1 == numInGroup)
+        {
+            close(']');
+        }
+    }
+
+    void onVarData(
+        Token& fieldToken,
+        const char *buffer,
+        std::uint64_t length,
+        Token& typeToken)
+    {
+        property(fieldToken.name());
+
+        const std::string& characterEncoding = typeToken.encoding().characterEncoding();
+
+        if (characterEncoding.empty())
+        {
+            appendHex(buffer, static_cast<std::size_t>(length));
+        }
+        else
+        {
+            appendString(buffer, static_cast<std::size_t>(length), !isUtf8(characterEncoding));
+        }
+    }
+
+    /// Append the integer in decimal.
+    void appendUInt(std::uint64_t value)
+    {
+        static const char digitPairs[] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+        char digits[20];
+        char *end = digits + sizeof(digits);
+        char *start = end;
+
+        while (value >= 100)
+        {
+            const std::size_t pair = static_cast<std::size_t>(value % 100) * 2;
+            value /= 100;
+            *--start = digitPairs[pair + 1];
+            *--start = digitPairs[pair];
+        }
+
+        if (value >= 10)
+        {
+            const std::size_t pair = static_cast<std::size_t>(value) * 2;
+            *--start = digitPairs[pair + 1];
+            *--start = digitPairs[pair];
+        }
+        else
+        {
+            *--start = static_cast<char>('0' + value);
+        }
+
+        m_output.append(start, static_cast<std::size_t>(end - start));
+    }
+
+    void appendInt(std::int64_t value)
+    {
+        if (value < 0)
+        {
+            m_output += '-';
+            appendUInt(UINT64_C(0) - static_cast<std::uint64_t>(value));
+        }
+        else
+        {
+            appendUInt(static_cast<std::uint64_t>(value));
+        }
+    }
+
+    /// Append the value with enough digits to read back the same float or double, or null if not finite.
+    void appendDouble(double value, bool isFloat)
+    {
+        if (std::isnan(value) || std::isinf(value))
+        {
+            m_output += "null";
+            return;
+        }
+
+        char digits[32];
+        const int length = std::snprintf(digits, sizeof(digits), isFloat ? "%.9g" : "%.17g", value);
+        m_output.append(digits, static_cast<std::size_t>(length));
+    }
+
+    /**
+     * Append the bytes as a quoted JSON string, escaping quotes, backslashes, and control characters. With
+     * escapeNonAscii, bytes above 0x7F are escaped as \u00XX, which reads back as ISO-8859-1.
+     */
+    void appendString(const char *value, std::size_t length, bool escapeNonAscii = false)
+    {
+        m_output += '"';
+
+        std::size_t i = 0;
+
+        while (i < length)
+        {
+            const std::size_t plainLength = plainPrefixLength(value + i, length - i, escapeNonAscii);
+
+            m_output.append(value + i, plainLength);
+            i += plainLength;
+
+            if (i < length)
+            {
+                appendEscaped(static_cast<unsigned char>(value[i]));
+                i++;
+            }
+        }
+
+        m_output += '"';
+    }
+
+    /// Append the bytes as a quoted string of two lower case hex digits per byte.
+    void appendHex(const char *value, std::size_t length)
+    {
+        static const char hexDigits[] = "0123456789abcdef";
+
+        m_output += '"';
+
+        for (std::size_t i = 0; i < length; i++)
+        {
+            const unsigned char c = static_cast<unsigned char>(value[i]);
+            const char digits[2] = { hexDigits[c >> 4], hexDigits[c & 0xF] };
+            m_output.append(digits, sizeof(digits));
+        }
+
+        m_output += '"';
+    }
+
+private:
+    std::string& m_output;
+    int m_compositeLevel;
+    bool m_isFirst;
+
+    static bool isUtf8(const std::string& characterEncoding)
+    {
+        return characterEncoding == "UTF-8" || characterEncoding == "utf-8" || characterEncoding == "UTF8";
+    }
+
+    static bool isAbsent(const Token& fieldToken, const Token& typeToken, std::uint64_t actingVersion)
+    {
+        return Presence::SBE_OPTIONAL == typeToken.encoding().presence() &&
+            actingVersion < static_cast<std::uint64_t>(fieldToken.tokenVersion());
+    }
+
+    static inline bool isEscaped(unsigned char c, bool escapeNonAscii)
+    {
+        return c < 0x20 || '"' == c || '\\' == c || (escapeNonAscii && c > 0x7F);
+    }
+
+    /// Number of leading bytes which need no escaping.
+    static std::size_t plainPrefixLength(const char *value, std::size_t length, bool escapeNonAscii)
+    {
+        std::size_t i = 0;
+
+#if defined(__SSE2__)
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i lastControl = _mm_set1_epi8(0x1F);
+
+        for (; i + 16 <= length; i += 16)
+        {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(value + i));
+            const __m128i isControl = _mm_cmpeq_epi8(_mm_max_epu8(bytes, lastControl), lastControl);
+            const __m128i needsEscape = _mm_or_si128(
+                isControl, _mm_or_si128(_mm_cmpeq_epi8(bytes, quote), _mm_cmpeq_epi8(bytes, backslash)));
+            const int mask = _mm_movemask_epi8(needsEscape) | (escapeNonAscii ? _mm_movemask_epi8(bytes) : 0);
+
+            if (0 != mask)
+            {
+                return i + static_cast<std::size_t>(__builtin_ctz(static_cast<unsigned int>(mask)));
+            }
+        }
+#endif
+        for (; i < length; i++)
+        {
+            if (isEscaped(static_cast<unsigned char>(value[i]), escapeNonAscii))
+            {
+                break;
+            }
+        }
+
+        return i;
+    }
+
+    void appendEscaped(unsigned char c)
+    {
+        static const char hexDigits[] = "0123456789abcdef";
+
+        switch (c)
+        {
+            case '"': m_output += "\\\""; break;
+            case '\\': m_output += "\\\\"; break;
+            case '\b': m_output += "\\b"; break;
+            case '\f': m_output += "\\f"; break;
+            case '\n': m_output += "\\n"; break;
+            case '\r': m_output += "\\r"; break;
+            case '\t': m_output += "\\t"; break;
+
+            default:
+            {
+                const char escaped[6] = { '\\', 'u', '0', '0', hexDigits[c >> 4], hexDigits[c & 0xF] };
+                m_output.append(escaped, sizeof(escaped));
+                break;
+            }
+        }
+    }
+
+    /// Comma before the next property or element, unless it is the first in its object or array.
+    void separator()
+    {
+        if (!m_isFirst)
+        {
+            m_output += ',';
+        }
+
+        m_isFirst = false;
+    }
+
+    void open(char c)
+    {
+        m_output += c;
+        m_isFirst = true;
+    }
+
+    void close(char c)
+    {
+        m_output += c;
+        m_isFirst = false;
+    }
+
+    void property(const std::string& name)
+    {
+        separator();
+        appendString(name.data(), name.size());
+        m_output += ':';
+    }
+
+    void appendValue(const Encoding& encoding, const char *buffer)
+    {
+        const PrimitiveType type = encoding.primitiveType();
+
+        if (Encoding::isInt(type))
+        {
+            appendInt(encoding.getAsInt(buffer));
+        }
+        else if (Encoding::isUInt(type))
+        {
+            appendUInt(encoding.getAsUInt(buffer));
+        }
+        else
+        {
+            appendDouble(encoding.getAsDouble(buffer), PrimitiveType::FLOAT == type);
+        }
+    }
+
+    void appendConstant(PrimitiveType type, const PrimitiveValue& constValue)
+    {
+        if (PrimitiveType::CHAR == type)
+        {
+            if (constValue.size() > 1)
+            {
+                appendString(constValue.getArray(), constValue.size());
+            }
+            else
+            {
+                const char value = static_cast<char>(constValue.getAsInt());
+                appendString(&value, 1);
+            }
+        }
+        else if (Encoding::isInt(type))
+        {
+            appendInt(constValue.getAsInt());
+        }
+        else if (Encoding::isUInt(type))
+        {
+            appendUInt(constValue.getAsUInt());
+        }
+        else
+        {
+            appendDouble(constValue.getAsDouble(), PrimitiveType::FLOAT == type);
+        }
+    }
+};
+
+}}
+
+#endif
@@ -18,8 +18,10 @@
 
 #include <functional>
 #include <vector>
+#include <type_traits>
 
 #include "Token.h"
+#include "DecodePlan.h"
 
 using namespace sbe::otf;
 
@@ -145,19 +147,184 @@ public:
         Token& typeToken) {}
 };
 
+/// Listener events the decoder raises, combined as a bitmask
+enum TokenListenerInterest
+{
+    INTEREST_BEGIN_MESSAGE = 1u << 0,
+    INTEREST_END_MESSAGE = 1u << 1,
+    INTEREST_ENCODING = 1u << 2,
+    INTEREST_ENUM = 1u << 3,
+    INTEREST_BIT_SET = 1u << 4,
+    INTEREST_BEGIN_COMPOSITE = 1u << 5,
+    INTEREST_END_COMPOSITE = 1u << 6,
+    INTEREST_GROUP_HEADER = 1u << 7,
+    INTEREST_BEGIN_GROUP = 1u << 8,
+    INTEREST_END_GROUP = 1u << 9,
+    INTEREST_VAR_DATA = 1u << 10,
+    /// Events raised from within a composite.
+    INTEREST_COMPOSITE_CONTENT = INTEREST_ENCODING | INTEREST_ENUM | INTEREST_BIT_SET |
+        INTEREST_BEGIN_COMPOSITE | INTEREST_END_COMPOSITE,
+    /// Events raised from within a repeating group.
+    INTEREST_GROUP_CONTENT = INTEREST_COMPOSITE_CONTENT | INTEREST_GROUP_HEADER | INTEREST_BEGIN_GROUP |
+        INTEREST_END_GROUP | INTEREST_VAR_DATA,
+    INTEREST_ALL = INTEREST_BEGIN_MESSAGE | INTEREST_END_MESSAGE | INTEREST_GROUP_CONTENT
+};
+
+/*
+ * Non virtual alternative to BasicTokenListener. The decoder detects at compile time which callbacks Derived
+ * declares and raises only those events, skipping composites and groups which would raise none.
+ */
+template<typename Derived>
+class StaticTokenListener
+{
+public:
+    void onBeginMessage(Token& token) {}
+
+    void onEndMessage(Token& token) {}
+
+    void onEncoding(
+        Token& fieldToken,
+        const char *buffer,
+        Token& typeToken,
+        std::uint64_t actingVersion) {}
+
+    void onEnum(
+        Token& fieldToken,
+        const char *buffer,
+        std::vector<Token>& tokens,
+        std::size_t fromIndex,
+        std::size_t toIndex,
+        std::uint64_t actingVersion) {}
+
+    void onBitSet(
+        Token& fieldToken,
+        const char *buffer,
+        std::vector<Token>& tokens,
+        std::size_t fromIndex,
+        std::size_t toIndex,
+        std::uint64_t actingVersion) {}
+
+    void onBeginComposite(
+        Token& fieldToken,
+        std::vector<Token>& tokens,
+        std::size_t fromIndex,
+        std::size_t toIndex) {}
+
+    void onEndComposite(
+        Token& fieldToken,
+        std::vector<Token>& tokens,
+        std::size_t fromIndex,
+        std::size_t toIndex) {}
+
+    void onGroupHeader(
+        Token& token,
+        std::uint64_t numInGroup) {}
+
+    void onBeginGroup(
+        Token& token,
+        std::uint64_t groupIndex,
+        std::uint64_t numInGroup) {}
+
+    void onEndGroup(
+        Token& token,
+        std::uint64_t groupIndex,
+        std::uint64_t numInGroup) {}
+
+    void onVarData(
+        Token& fieldToken,
+        const char *buffer,
+        std::uint64_t length,
+        Token& typeToken) {}
+};
+
+namespace detail {
+
+template<typename TokenListener>
+class HasDeclaredInterest
+{
+    template<typename T>
+    static std::true_type test(decltype(&T::tokenListenerInterest));
+
+    template<typename T>
+    static std::false_type test(...);
+
+public:
+    static const bool value = decltype(test<TokenListener>(nullptr))::value;
+};
+
+#define _OTF_DECLARED_CALLBACK(CALLBACK, INTEREST) \
+    (std::is_same<decltype(&TokenListener::CALLBACK), decltype(&StaticTokenListener<TokenListener>::CALLBACK)>::value ? \
+        0u : static_cast<std::uint32_t>(INTEREST))
+
+template<typename TokenListener, bool isDeclared, bool isStatic>
+struct TokenListenerInterestOf
+{
+    static const std::uint32_t value = INTEREST_ALL;
+};
+
+template<typename TokenListener, bool isStatic>
+struct TokenListenerInterestOf<TokenListener, true, isStatic>
+{
+    static const std::uint32_t value = TokenListener::tokenListenerInterest;
+};
+
+template<typename TokenListener>
+struct TokenListenerInterestOf<TokenListener, false, true>
+{
+    static const std::uint32_t value =
+        _OTF_DECLARED_CALLBACK(onBeginMessage, INTEREST_BEGIN_MESSAGE) |
+        _OTF_DECLARED_CALLBACK(onEndMessage, INTEREST_END_MESSAGE) |
+        _OTF_DECLARED_CALLBACK(onEncoding, INTEREST_ENCODING) |
+        _OTF_DECLARED_CALLBACK(onEnum, INTEREST_ENUM) |
+        _OTF_DECLARED_CALLBACK(onBitSet, INTEREST_BIT_SET) |
+        _OTF_DECLARED_CALLBACK(onBeginComposite, INTEREST_BEGIN_COMPOSITE) |
+        _OTF_DECLARED_CALLBACK(onEndComposite, INTEREST_END_COMPOSITE) |
+        _OTF_DECLARED_CALLBACK(onGroupHeader, INTEREST_GROUP_HEADER) |
+        _OTF_DECLARED_CALLBACK(onBeginGroup, INTEREST_BEGIN_GROUP) |
+        _OTF_DECLARED_CALLBACK(onEndGroup, INTEREST_END_GROUP) |
+        _OTF_DECLARED_CALLBACK(onVarData, INTEREST_VAR_DATA);
+};
+
+#undef _OTF_DECLARED_CALLBACK
+
+}
+
+/*
+ * Compile time mask of TokenListenerInterest for a listener type. A listener may declare its mask as
+ *
+ *     static const std::uint32_t tokenListenerInterest = INTEREST_ENCODING;
+ *
+ * otherwise it is detected for a StaticTokenListener and is INTEREST_ALL for any other listener, as a
+ * BasicTokenListener may be overridden by a type the decoder cannot see. Specialise to declare a mask for a listener
+ * which cannot be changed.
+ */
+template<typename TokenListener>
+struct TokenListenerTraits
+{
+    static const std::uint32_t interest = detail::TokenListenerInterestOf<
+        TokenListener,
+        detail::HasDeclaredInterest<TokenListener>::value,
+        std::is_base_of<StaticTokenListener<TokenListener>, TokenListener>::value>::value;
+};
+
 template<typename TokenListener>
 static void decodeComposite(
     Token& fieldToken,
     const char *buffer,
     std::size_t bufferIndex,
     std::size_t length,
-    std::shared_ptr<std::vector<Token>> tokens,
+    const std::shared_ptr<std::vector<Token>>& tokens,
     size_t tokenIndex,
     size_t toIndex,
     std::uint64_t actingVersion,
     TokenListener& listener)
 {
-    listener.onBeginComposite(fieldToken, *tokens.get(), tokenIndex, toIndex);
+    const std::uint32_t interest = TokenListenerTraits<TokenListener>::interest;
+
+    if (interest & INTEREST_BEGIN_COMPOSITE)
+    {
+        listener.onBeginComposite(fieldToken, *tokens.get(), tokenIndex, toIndex);
+    }
 
     for (size_t i = tokenIndex + 1; i < toIndex;)
     {
@@ -169,19 +336,31 @@ static void decodeComposite(
         switch (token.signal())
         {
             case Signal::BEGIN_COMPOSITE:
-                decodeComposite(fieldToken, buffer, bufferIndex + offset, length, tokens, i, nextFieldIndex - 1, actingVersion, listener);
+                if (interest & INTEREST_COMPOSITE_CONTENT)
+                {
+                    decodeComposite(fieldToken, buffer, bufferIndex + offset, length, tokens, i, nextFieldIndex - 1, actingVersion, listener);
+                }
                 break;
 
             case Signal::BEGIN_ENUM:
-                listener.onEnum(fieldToken, buffer + bufferIndex + offset, *tokens.get(), i, nextFieldIndex - 1, actingVersion);
+                if (interest & INTEREST_ENUM)
+                {
+                    listener.onEnum(fieldToken, buffer + bufferIndex + offset, *tokens.get(), i, nextFieldIndex - 1, actingVersion);
+                }
                 break;
 
             case Signal::BEGIN_SET:
-                listener.onBitSet(fieldToken, buffer + bufferIndex + offset, *tokens.get(), i, nextFieldIndex - 1, actingVersion);
+                if (interest & INTEREST_BIT_SET)
+                {
+                    listener.onBitSet(fieldToken, buffer + bufferIndex + offset, *tokens.get(), i, nextFieldIndex - 1, actingVersion);
+                }
                 break;
 
             case Signal::ENCODING:
-                listener.onEncoding(token, buffer + bufferIndex + offset, token, actingVersion);
+                if (interest & INTEREST_ENCODING)
+                {
+                    listener.onEncoding(token, buffer + bufferIndex + offset, token, actingVersion);
+                }
                 break;
 
             default:
@@ -191,7 +370,10 @@ static void decodeComposite(
         i += token.componentTokenCount();
     }
 
-    listener.onEndComposite(fieldToken, *tokens.get(), tokenIndex, toIndex);
+    if (interest & INTEREST_END_COMPOSITE)
+    {
+        listener.onEndComposite(fieldToken, *tokens.get(), tokenIndex, toIndex);
+    }
 }
 
 template<typename TokenListener>
@@ -200,11 +382,13 @@ static size_t decodeFields(
     std::size_t bufferIndex,
     std::size_t length,
     std::uint64_t actingVersion,
-    std::shared_ptr<std::vector<Token>> tokens,
+    const std::shared_ptr<std::vector<Token>>& tokens,
     size_t tokenIndex,
     const size_t numTokens,
     TokenListener& listener)
 {
+    const std::uint32_t interest = TokenListenerTraits<TokenListener>::interest;
+
     while (tokenIndex < numTokens)
     {
         Token& fieldToken = tokens->at(tokenIndex);
@@ -222,20 +406,32 @@ static size_t decodeFields(
         switch (typeToken.signal())
         {
             case Signal::BEGIN_COMPOSITE:
-                decodeComposite<TokenListener>(
-                    fieldToken, buffer, offset, length, tokens, tokenIndex, nextFieldIndex - 2, actingVersion, listener);
+                if (interest & INTEREST_COMPOSITE_CONTENT)
+                {
+                    decodeComposite<TokenListener>(
+                        fieldToken, buffer, offset, length, tokens, tokenIndex, nextFieldIndex - 2, actingVersion, listener);
+                }
                 break;
 
             case Signal::BEGIN_ENUM:
-                listener.onEnum(fieldToken, buffer + offset, *tokens.get(), tokenIndex, nextFieldIndex - 2, actingVersion);
+                if (interest & INTEREST_ENUM)
+                {
+                    listener.onEnum(fieldToken, buffer + offset, *tokens.get(), tokenIndex, nextFieldIndex - 2, actingVersion);
+                }
                 break;
 
             case Signal::BEGIN_SET:
-                listener.onBitSet(fieldToken, buffer + offset, *tokens.get(), tokenIndex, nextFieldIndex - 2, actingVersion);
+                if (interest & INTEREST_BIT_SET)
+                {
+                    listener.onBitSet(fieldToken, buffer + offset, *tokens.get(), tokenIndex, nextFieldIndex - 2, actingVersion);
+                }
                 break;
 
             case Signal::ENCODING:
-                listener.onEncoding(fieldToken, buffer + offset, typeToken, actingVersion);
+                if (interest & INTEREST_ENCODING)
+                {
+                    listener.onEncoding(fieldToken, buffer + offset, typeToken, actingVersion);
+                }
                 break;
 
             default:
@@ -290,7 +486,10 @@ std::size_t decodeData(
             throw std::runtime_error("length too short for data field");
         }
 
-        listener.onVarData(token, buffer + bufferIndex, dataLength, dataToken);
+        if (TokenListenerTraits<TokenListener>::interest & INTEREST_VAR_DATA)
+        {
+            listener.onVarData(token, buffer + bufferIndex, dataLength, dataToken);
+        }
 
         bufferIndex += static_cast<size_t>(dataLength);
         tokenIndex += token.componentTokenCount();
@@ -305,11 +504,13 @@ std::pair<size_t, size_t> decodeGroups(
     std::size_t bufferIndex,
     const std::size_t length,
     std::uint64_t actingVersion,
-    std::shared_ptr<std::vector<Token>> tokens,
+    const std::shared_ptr<std::vector<Token>>& tokens,
     size_t tokenIndex,
     const size_t numTokens,
     TokenListener& listener)
 {
+    const std::uint32_t interest = TokenListenerTraits<TokenListener>::interest;
+
     while (tokenIndex < numTokens)
     {
         Token& token = tokens->at(tokenIndex);
@@ -343,11 +544,17 @@ std::pair<size_t, size_t> decodeGroups(
 
         size_t beginFieldsIndex = tokenIndex + dimensionsTypeComposite.componentTokenCount() + 1;
 
-        listener.onGroupHeader(token, numInGroup);
+        if (interest & INTEREST_GROUP_HEADER)
+        {
+            listener.onGroupHeader(token, numInGroup);
+        }
 
         for (std::uint64_t i = 0; i < numInGroup; i++)
         {
-            listener.onBeginGroup(token, i, numInGroup);
+            if (interest & INTEREST_BEGIN_GROUP)
+            {
+                listener.onBeginGroup(token, i, numInGroup);
+            }
 
             if ((bufferIndex + blockLength) > length)
             {
@@ -364,7 +571,10 @@ std::pair<size_t, size_t> decodeGroups(
             bufferIndex = decodeData(
                 buffer, groupsResult.first, length, tokens, groupsResult.second, numTokens, actingVersion, listener);
 
-            listener.onEndGroup(token, i, numInGroup);
+            if (interest & INTEREST_END_GROUP)
+            {
+                listener.onEndGroup(token, i, numInGroup);
+            }
         }
 
         tokenIndex += token.componentTokenCount();
@@ -382,10 +592,15 @@ std::size_t decode(
     const std::size_t length,
     std::uint64_t actingVersion,
     size_t blockLength,
-    std::shared_ptr<std::vector<Token>> msgTokens,
+    const std::shared_ptr<std::vector<Token>>& msgTokens,
     TokenListener& listener)
 {
-    listener.onBeginMessage(msgTokens->at(0));
+    const std::uint32_t interest = TokenListenerTraits<TokenListener>::interest;
+
+    if (interest & INTEREST_BEGIN_MESSAGE)
+    {
+        listener.onBeginMessage(msgTokens->at(0));
+    }
 
     if (length < blockLength)
     {
@@ -403,7 +618,406 @@ std::size_t decode(
     bufferIndex = decodeData(
         buffer, groupResult.first, length, msgTokens, groupResult.second, numTokens, actingVersion, listener);
 
-    listener.onEndMessage(msgTokens->at(numTokens - 1));
+    if (interest & INTEREST_END_MESSAGE)
+    {
+        listener.onEndMessage(msgTokens->at(numTokens - 1));
+    }
+
+    return bufferIndex;
+}
+
+inline bool skipPlanInstructions(
+    const char *buffer,
+    std::size_t bufferIndex,
+    std::uint64_t blockLength,
+    const std::size_t length,
+    std::uint64_t actingVersion,
+    const DecodeInstruction *instructions,
+    std::size_t instructionIndex,
+    const std::size_t endIndex,
+    std::size_t& position)
+{
+    position = bufferIndex + static_cast<std::size_t>(blockLength);
+
+    while (instructionIndex < endIndex)
+    {
+        const DecodeInstruction& instruction = instructions[instructionIndex];
+
+        if (OP_GROUP == instruction.opCode || OP_SKIP_GROUP == instruction.opCode ||
+            OP_SKIP_FIXED_GROUP == instruction.opCode)
+        {
+            const bool isPresent = instruction.version <= static_cast<std::int32_t>(actingVersion);
+
+            if ((position + instruction.headerLength) > length)
+            {
+                return false;
+            }
+
+            std::uint64_t groupBlockLength = isPresent ? Encoding::getUInt(
+                static_cast<PrimitiveType>(instruction.primitiveType),
+                static_cast<ByteOrder>(instruction.byteOrder),
+                buffer + position + instruction.offset) : 0;
+            std::uint64_t numInGroup = isPresent ? Encoding::getUInt(
+                static_cast<PrimitiveType>(instruction.secondaryPrimitiveType),
+                static_cast<ByteOrder>(instruction.secondaryByteOrder),
+                buffer + position + instruction.secondaryOffset) : 0;
+
+            if (isPresent)
+            {
+                position += instruction.headerLength;
+            }
+
+            if (OP_SKIP_FIXED_GROUP == instruction.opCode)
+            {
+                const std::uint64_t groupLength = groupBlockLength * numInGroup;
+
+                if ((position + groupLength) > length)
+                {
+                    return false;
+                }
+
+                position += static_cast<std::size_t>(groupLength);
+                numInGroup = 0;
+            }
+
+            for (std::uint64_t i = 0; i < numInGroup; i++)
+            {
+                if ((position + groupBlockLength) > length ||
+                    !skipPlanInstructions(
+                        buffer,
+                        position,
+                        groupBlockLength,
+                        length,
+                        actingVersion,
+                        instructions,
+                        instructionIndex + 1,
+                        instruction.next,
+                        position))
+                {
+                    return false;
+                }
+            }
+
+            instructionIndex = instruction.next;
+            continue;
+        }
+
+        if (OP_VAR_DATA == instruction.opCode || OP_SKIP_VAR_DATA == instruction.opCode)
+        {
+            const bool isPresent = instruction.version <= static_cast<std::int32_t>(actingVersion);
+
+            if ((position + instruction.dataOffset) > length)
+            {
+                return false;
+            }
+
+            std::uint64_t dataLength = isPresent ? Encoding::getUInt(
+                static_cast<PrimitiveType>(instruction.primitiveType),
+                static_cast<ByteOrder>(instruction.byteOrder),
+                buffer + position + instruction.offset) : 0;
+
+            if (isPresent)
+            {
+                position += instruction.dataOffset;
+            }
+
+            if ((position + dataLength) > length)
+            {
+                return false;
+            }
+
+            position += static_cast<std::size_t>(dataLength);
+        }
+
+        instructionIndex++;
+    }
+
+    return true;
+}
+
+template<typename TokenListener>
+std::size_t decodePlanInstructions(
+    const char *buffer,
+    std::size_t bufferIndex,
+    std::uint64_t blockLength,
+    const std::size_t length,
+    std::uint64_t actingVersion,
+    std::vector<Token>& tokens,
+    const DecodeInstruction *instructions,
+    std::size_t instructionIndex,
+    const std::size_t endIndex,
+    TokenListener& listener)
+{
+    const std::uint32_t interest = TokenListenerTraits<TokenListener>::interest;
+    std::size_t position = bufferIndex + static_cast<std::size_t>(blockLength);
+
+    while (instructionIndex < endIndex)
+    {
+        const DecodeInstruction& instruction = instructions[instructionIndex];
+
+        switch (instruction.opCode)
+        {
+            case OP_ENCODING:
+                if (interest & INTEREST_ENCODING)
+                {
+                    listener.onEncoding(
+                        tokens[instruction.fieldTokenIndex],
+                        buffer + bufferIndex + instruction.offset,
+                        tokens[instruction.typeTokenIndex],
+                        actingVersion);
+                }
+                break;
+
+            case OP_ENUM:
+                if (interest & INTEREST_ENUM)
+                {
+                    listener.onEnum(
+                        tokens[instruction.fieldTokenIndex],
+                        buffer + bufferIndex + instruction.offset,
+                        tokens,
+                        instruction.typeTokenIndex,
+                        instruction.toIndex,
+                        actingVersion);
+                }
+                break;
+
+            case OP_SET:
+                if (interest & INTEREST_BIT_SET)
+                {
+                    listener.onBitSet(
+                        tokens[instruction.fieldTokenIndex],
+                        buffer + bufferIndex + instruction.offset,
+                        tokens,
+                        instruction.typeTokenIndex,
+                        instruction.toIndex,
+                        actingVersion);
+                }
+                break;
+
+            case OP_BEGIN_COMPOSITE:
+                if (interest & INTEREST_BEGIN_COMPOSITE)
+                {
+                    listener.onBeginComposite(
+                        tokens[instruction.fieldTokenIndex], tokens, instruction.typeTokenIndex, instruction.toIndex);
+                }
+                break;
+
+            case OP_END_COMPOSITE:
+                if (interest & INTEREST_END_COMPOSITE)
+                {
+                    listener.onEndComposite(
+                        tokens[instruction.fieldTokenIndex], tokens, instruction.typeTokenIndex, instruction.toIndex);
+                }
+                break;
+
+            case OP_GROUP:
+            {
+                if (!(interest & INTEREST_GROUP_CONTENT))
+                {
+                    if (!skipPlanInstructions(
+                        buffer, position, 0, length, actingVersion, instructions, instructionIndex, instruction.next, position))
+                    {
+                        throw std::runtime_error("length too short for skipped group");
+                    }
+
+                    instructionIndex = instruction.next;
+                    continue;
+                }
+
+                Token& token = tokens[instruction.fieldTokenIndex];
+                const bool isPresent = instruction.version <= static_cast<std::int32_t>(actingVersion);
+
+                if ((position + instruction.headerLength) > length)
+                {
+                    throw std::runtime_error("length too short for group dimensions");
+                }
+
+                std::uint64_t groupBlockLength = isPresent ? Encoding::getUInt(
+                    static_cast<PrimitiveType>(instruction.primitiveType),
+                    static_cast<ByteOrder>(instruction.byteOrder),
+                    buffer + position + instruction.offset) : 0;
+                std::uint64_t numInGroup = isPresent ? Encoding::getUInt(
+                    static_cast<PrimitiveType>(instruction.secondaryPrimitiveType),
+                    static_cast<ByteOrder>(instruction.secondaryByteOrder),
+                    buffer + position + instruction.secondaryOffset) : 0;
+
+                if (isPresent)
+                {
+                    position += instruction.headerLength;
+                }
+
+                if (interest & INTEREST_GROUP_HEADER)
+                {
+                    listener.onGroupHeader(token, numInGroup);
+                }
+
+                for (std::uint64_t i = 0; i < numInGroup; i++)
+                {
+                    if (interest & INTEREST_BEGIN_GROUP)
+                    {
+                        listener.onBeginGroup(token, i, numInGroup);
+                    }
+
+                    if ((position + groupBlockLength) > length)
+                    {
+                        throw std::runtime_error("length too short for group blockLength");
+                    }
+
+                    position = decodePlanInstructions(
+                        buffer,
+                        position,
+                        groupBlockLength,
+                        length,
+                        actingVersion,
+                        tokens,
+                        instructions,
+                        instructionIndex + 1,
+                        instruction.next,
+                        listener);
+
+                    if (interest & INTEREST_END_GROUP)
+                    {
+                        listener.onEndGroup(token, i, numInGroup);
+                    }
+                }
+
+                instructionIndex = instruction.next;
+                continue;
+            }
+
+            case OP_SKIP_GROUP:
+            case OP_SKIP_FIXED_GROUP:
+            {
+                if (!skipPlanInstructions(
+                    buffer, position, 0, length, actingVersion, instructions, instructionIndex, instruction.next, position))
+                {
+                    throw std::runtime_error("length too short for skipped group");
+                }
+
+                instructionIndex = instruction.next;
+                continue;
+            }
+
+            case OP_VAR_DATA:
+            case OP_SKIP_VAR_DATA:
+            {
+                const bool isPresent = instruction.version <= static_cast<std::int32_t>(actingVersion);
+
+                if ((position + instruction.dataOffset) > length)
+                {
+                    throw std::runtime_error("length too short for data length field");
+                }
+
+                std::uint64_t dataLength = isPresent ? Encoding::getUInt(
+                    static_cast<PrimitiveType>(instruction.primitiveType),
+                    static_cast<ByteOrder>(instruction.byteOrder),
+                    buffer + position + instruction.offset) : 0;
+
+                if (isPresent)
+                {
+                    position += instruction.dataOffset;
+                }
+
+                if ((position + dataLength) > length)
+                {
+                    throw std::runtime_error("length too short for data field");
+                }
+
+                if ((interest & INTEREST_VAR_DATA) && OP_VAR_DATA == instruction.opCode)
+                {
+                    listener.onVarData(
+                        tokens[instruction.fieldTokenIndex],
+                        buffer + position,
+                        dataLength,
+                        tokens[instruction.typeTokenIndex]);
+                }
+
+                position += static_cast<std::size_t>(dataLength);
+                break;
+            }
+        }
+
+        instructionIndex++;
+    }
+
+    return position;
+}
+
+/**
+ * Find the length of an encoded message by walking only its group dimensions and var data lengths. No listener
+ * events are raised. Returns false if length is too short to hold the message.
+ */
+inline bool encodedLength(
+    const char *buffer,
+    const std::size_t length,
+    std::uint64_t actingVersion,
+    size_t blockLength,
+    const DecodePlan& plan,
+    std::size_t& messageLength)
+{
+    if (length < blockLength)
+    {
+        return false;
+    }
+
+    if (plan.isFixedLength())
+    {
+        messageLength = blockLength;
+        return true;
+    }
+
+    return skipPlanInstructions(
+        buffer,
+        0,
+        blockLength,
+        length,
+        actingVersion,
+        plan.instructions().data(),
+        0,
+        plan.instructions().size(),
+        messageLength);
+}
+
+/**
+ * Entry point for decoder using a precompiled DecodePlan. Listener events are the same as for the token based decode.
+ */
+template<typename TokenListener>
+std::size_t decode(
+    const char *buffer,
+    const std::size_t length,
+    std::uint64_t actingVersion,
+    size_t blockLength,
+    const DecodePlan& plan,
+    TokenListener& listener)
+{
+    const std::uint32_t interest = TokenListenerTraits<TokenListener>::interest;
+
+    if (interest & INTEREST_BEGIN_MESSAGE)
+    {
+        listener.onBeginMessage(plan.beginMessageToken());
+    }
+
+    if (length < blockLength)
+    {
+        throw std::runtime_error("length too short for message blockLength");
+    }
+
+    const std::size_t bufferIndex = decodePlanInstructions(
+        buffer,
+        0,
+        blockLength,
+        length,
+        actingVersion,
+        plan.tokens(),
+        plan.instructions().data(),
+        0,
+        plan.instructions().size(),
+        listener);
+
+    if (interest & INTEREST_END_MESSAGE)
+    {
+        listener.onEndMessage(plan.endMessageToken());
+    }
 
     return bufferIndex;
 }
@@ -0,0 +1,378 @@
+/*
+ * Copyright 2013-2020 Real Logic Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _OTF_PARALLELDECODER_H
+#define _OTF_PARALLELDECODER_H
+
+#include <cstdint>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+
+#include "DecodePlan.h"
+#include "OtfMessageDecoder.h"
+#include "OtfStreamDecoder.h"
+
+namespace sbe { namespace otf {
+
+/// Location of a single message within a buffer of header prefixed messages
+struct MessageIndexEntry
+{
+    /// Plan resolved from the header, shared by every message of the same templateId and version.
+    const DecodePlan *plan;
+    /// Offset of the message header within the buffer.
+    std::uint64_t offset;
+    /// Length of the message, excluding the header.
+    std::uint32_t length;
+    std::uint32_t templateId;
+    std::uint32_t actingVersion;
+    std::uint32_t blockLength;
+};
+
+/*
+ * Offsets of the whole messages in a buffer of header prefixed messages, found in one sequential pass.
+ *
+ * Messages carry no total length so the pass walks each group dimension and var data length, decoding no fields.
+ * Each templateId and version is resolved to a DecodePlan while building, so an index may then be decoded in
+ * parallel without touching the DecodePlanRegistry, which is not thread safe.
+ */
+class MessageIndex
+{
+public:
+    MessageIndex() :
+        m_headerLength(0)
+    {
+    }
+
+    /**
+     * Index the buffer, replacing any previous entries. Stops at the first message which is incomplete or has an
+     * unknown templateId in the same way as OtfMessageDecoder::decodeStream.
+     */
+    StreamDecodeResult build(const char *buffer, const std::size_t length, DecodePlanRegistry& registry)
+    {
+        const OtfHeaderDecoder& headerDecoder = registry.headerDecoder();
+        const std::size_t headerLength = headerDecoder.encodedLength();
+        StreamDecodeResult result = { STREAM_COMPLETE, 0, length, 0 };
+        std::size_t position = 0;
+
+        m_entries.clear();
+        m_headerLength = headerLength;
+
+        while (position < length)
+        {
+            const char *headerBuffer = buffer + position;
+
+            if ((length - position) < headerLength)
+            {
+                result.status = STREAM_TRUNCATED;
+                break;
+            }
+
+            const OtfHeaderFields header = headerDecoder.getFields(headerBuffer);
+            const std::uint64_t templateId = header.templateId;
+            const std::uint64_t actingVersion = header.schemaVersion;
+            const std::size_t blockLength = static_cast<std::size_t>(header.blockLength);
+            const DecodePlan *plan = registry.plan(templateId, actingVersion);
+
+            if (nullptr == plan)
+            {
+                result.status = STREAM_UNKNOWN_TEMPLATE;
+                break;
+            }
+
+            std::size_t messageLength = 0;
+
+            if (!OtfMessageDecoder::encodedLength(
+                headerBuffer + headerLength, length - position - headerLength, actingVersion, blockLength, *plan, messageLength))
+            {
+                result.status = STREAM_TRUNCATED;
+                break;
+            }
+
+            MessageIndexEntry entry;
+            entry.plan = plan;
+            entry.offset = position;
+            entry.length = static_cast<std::uint32_t>(messageLength);
+            entry.templateId = static_cast<std::uint32_t>(templateId);
+            entry.actingVersion = static_cast<std::uint32_t>(actingVersion);
+            entry.blockLength = static_cast<std::uint32_t>(blockLength);
+            m_entries.push_back(entry);
+
+            position += headerLength + messageLength;
+        }
+
+        result.messageCount = m_entries.size();
+        result.consumedLength = position;
+        result.remainingLength = length - position;
+
+        return result;
+    }
+
+    inline std::size_t size() const
+    {
+        return m_entries.size();
+    }
+
+    inline const MessageIndexEntry& operator[](std::size_t index) const
+    {
+        return m_entries[index];
+    }
+
+    inline const std::vector<MessageIndexEntry>& entries() const
+    {
+        return m_entries;
+    }
+
+    inline std::size_t headerLength() const
+    {
+        return m_headerLength;
+    }
+
+private:
+    std::vector<MessageIndexEntry> m_entries;
+    std::size_t m_headerLength;
+};
+
+namespace OtfMessageDecoder {
+
+/**
+ * Decode the messages of an index within the buffer it was built from, in order, with a single listener.
+ */
+template<typename TokenListener>
+void decodeIndexed(
+    const char *buffer,
+    const MessageIndex& index,
+    std::size_t fromEntry,
+    std::size_t toEntry,
+    TokenListener& listener)
+{
+    const std::size_t headerLength = index.headerLength();
+
+    for (std::size_t i = fromEntry; i < toEntry; i++)
+    {
+        const MessageIndexEntry& entry = index[i];
+
+        decode(
+            buffer + entry.offset + headerLength,
+            entry.length,
+            entry.actingVersion,
+            entry.blockLength,
+            *entry.plan,
+            listener);
+    }
+}
+
+/**
+ * Decode the messages of an index on threadCount threads, or one per core if zero.
+ *
+ * The index is split into chunks of messagesPerChunk which idle threads take in turn. Each chunk is decoded with a
+ * listener of its own from newListener and, once it and every chunk before it is complete, handed to merge on the
+ * calling thread. merge therefore sees the chunks in message order and needs no locking, whereas newListener is called
+ * on the decoding threads and must be thread safe. At most twice threadCount chunks are decoding or awaiting merge at
+ * once, so a slow chunk stalls the threads rather than holding the listeners of the rest of the index. An exception
+ * thrown while decoding a chunk is rethrown from here in place of merging that chunk, after all threads have stopped.
+ */
+template<typename TokenListener>
+void decodeParallel(
+    const char *buffer,
+    const MessageIndex& index,
+    const std::function<std::unique_ptr<TokenListener>()>& newListener,
+    const std::function<void(TokenListener& listener)>& merge,
+    std::size_t threadCount = 0,
+    std::size_t messagesPerChunk = 4096)
+{
+    struct Chunk
+    {
+        std::unique_ptr<TokenListener> listener;
+        std::exception_ptr exception;
+        bool isComplete = false;
+    };
+
+    if (0 == messagesPerChunk)
+    {
+        messagesPerChunk = 1;
+    }
+
+    const std::size_t chunkCount = (index.size() + messagesPerChunk - 1) / messagesPerChunk;
+
+    if (0 == threadCount)
+    {
+        threadCount = std::thread::hardware_concurrency();
+    }
+
+    if (threadCount > chunkCount)
+    {
+        threadCount = chunkCount;
+    }
+
+    if (threadCount <= 1)
+    {
+        for (std::size_t i = 0; i < chunkCount; i++)
+        {
+            std::unique_ptr<TokenListener> listener = newListener();
+            decodeIndexed(
+                buffer, index, i * messagesPerChunk, std::min(index.size(), (i + 1) * messagesPerChunk), *listener);
+            merge(*listener);
+        }
+
+        return;
+    }
+
+    const std::size_t window = 2 * threadCount;
+    std::vector<Chunk> chunks(std::min(window, chunkCount));
+    std::size_t nextChunk = 0;
+    std::size_t mergedCount = 0;
+    bool isAborted = false;
+    std::mutex mutex;
+    std::condition_variable chunkCompleted;
+
+    std::function<void()> worker =
+        [&]()
+        {
+            while (true)
+            {
+                std::size_t i;
+
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    chunkCompleted.wait(
+                        lock,
+                        [&]()
+                        {
+                            return isAborted || nextChunk >= chunkCount || nextChunk < mergedCount + window;
+                        });
+
+                    if (isAborted || nextChunk >= chunkCount)
+                    {
+                        break;
+                    }
+
+                    i = nextChunk++;
+                }
+
+                std::unique_ptr<TokenListener> listener;
+                std::exception_ptr exception;
+
+                try
+                {
+                    listener = newListener();
+                    decodeIndexed(
+                        buffer, index, i * messagesPerChunk, std::min(index.size(), (i + 1) * messagesPerChunk), *listener);
+                }
+                catch (...)
+                {
+                    exception = std::current_exception();
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    Chunk& chunk = chunks[i % window];
+                    chunk.listener = std::move(listener);
+                    chunk.exception = exception;
+                    chunk.isComplete = true;
+                }
+
+                chunkCompleted.notify_all();
+            }
+        };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+
+    try
+    {
+        for (std::size_t i = 0; i < threadCount; i++)
+        {
+            threads.push_back(std::thread(worker));
+        }
+    }
+    catch (...)
+    {
+        // threads already started must be stopped and joined before their captured state goes away
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            isAborted = true;
+        }
+
+        chunkCompleted.notify_all();
+
+        for (std::size_t i = 0; i < threads.size(); i++)
+        {
+            threads[i].join();
+        }
+
+        throw;
+    }
+
+    std::exception_ptr exception;
+
+    for (std::size_t i = 0; i < chunkCount && !exception; i++)
+    {
+        std::unique_ptr<TokenListener> listener;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            Chunk& chunk = chunks[i % window];
+            chunkCompleted.wait(lock, [&]() { return chunk.isComplete; });
+            listener = std::move(chunk.listener);
+            exception = chunk.exception;
+            chunk.exception = nullptr;
+            chunk.isComplete = false;
+            mergedCount = i + 1;
+        }
+
+        chunkCompleted.notify_all();
+
+        if (!exception)
+        {
+            try
+            {
+                merge(*listener);
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isAborted = true;
+    }
+
+    chunkCompleted.notify_all();
+
+    for (std::size_t i = 0; i < threads.size(); i++)
+    {
+        threads[i].join();
+    }
+
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+}
+
+}
+
+}}
+
+#endif
@@ -0,0 +1,227 @@
+/*
+ * Copyright 2013-2020 Real Logic Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _OTF_STREAMDECODER_H
+#define _OTF_STREAMDECODER_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+
+#include "IrDecoder.h"
+#include "DecodePlan.h"
+#include "OtfHeaderDecoder.h"
+#include "OtfMessageDecoder.h"
+
+namespace sbe { namespace otf {
+
+/*
+ * Resolves the templateId and version of a message header to a DecodePlan, compiling each plan once on first use.
+ *
+ * A message is resolved to the IR message of the same templateId and version, or failing that the last message in
+ * the IR with the templateId. The registry itself is not thread safe, the plans it returns are immutable and may be
+ * shared between threads for as long as the registry and IrDecoder live.
+ */
+class DecodePlanRegistry
+{
+public:
+    explicit DecodePlanRegistry(const IrDecoder& irDecoder) :
+        m_irDecoder(irDecoder),
+        m_headerDecoder(irDecoder.header())
+    {
+    }
+
+    inline const OtfHeaderDecoder& headerDecoder() const
+    {
+        return m_headerDecoder;
+    }
+
+    /*
+     * Plan for the templateId and version, or nullptr if the IR has no message with the templateId.
+     */
+    const DecodePlan *plan(std::uint64_t templateId, std::uint64_t version)
+    {
+        if (templateId < m_latestPlans.size())
+        {
+            const VersionedPlan& latest = m_latestPlans[static_cast<std::size_t>(templateId)];
+
+            if (nullptr != latest.plan && latest.version == version)
+            {
+                return latest.plan;
+            }
+        }
+
+        const std::uint64_t key = (templateId << 32) | (version & 0xFFFFFFFF);
+        std::unordered_map<std::uint64_t, const DecodePlan *>::const_iterator it = m_plansByKey.find(key);
+        const DecodePlan *result = nullptr;
+
+        if (it != m_plansByKey.end())
+        {
+            result = it->second;
+        }
+        else
+        {
+            result = compilePlan(static_cast<int>(templateId), static_cast<int>(version));
+            m_plansByKey.insert(std::make_pair(key, result));
+        }
+
+        if (nullptr != result && templateId < MAX_DENSE_TEMPLATE_ID)
+        {
+            if (templateId >= m_latestPlans.size())
+            {
+                m_latestPlans.resize(static_cast<std::size_t>(templateId) + 1);
+            }
+
+            VersionedPlan& latest = m_latestPlans[static_cast<std::size_t>(templateId)];
+            latest.version = version;
+            latest.plan = result;
+        }
+
+        return result;
+    }
+
+private:
+    static const std::uint64_t MAX_DENSE_TEMPLATE_ID = 65536;
+
+    struct VersionedPlan
+    {
+        VersionedPlan() : version(0), plan(nullptr)
+        {
+        }
+
+        std::uint64_t version;
+        const DecodePlan *plan;
+    };
+
+    const IrDecoder& m_irDecoder;
+    const OtfHeaderDecoder m_headerDecoder;
+    std::vector<VersionedPlan> m_latestPlans;
+    std::unordered_map<std::uint64_t, const DecodePlan *> m_plansByKey;
+    std::unordered_map<const std::vector<Token> *, std::unique_ptr<DecodePlan>> m_plans;
+
+    const DecodePlan *compilePlan(int templateId, int version)
+    {
+        const std::shared_ptr<std::vector<Token>> *tokens = m_irDecoder.findMessage(templateId, version);
+
+        if (nullptr == tokens)
+        {
+            tokens = m_irDecoder.findMessage(templateId);
+        }
+
+        if (nullptr == tokens)
+        {
+            return nullptr;
+        }
+
+        std::unique_ptr<DecodePlan>& plan = m_plans[tokens->get()];
+        if (!plan)
+        {
+            plan.reset(new DecodePlan(*tokens));
+        }
+
+        return plan.get();
+    }
+};
+
+/// Outcome of decoding a buffer of consecutive messages
+enum StreamDecodeStatus
+{
+    /// Every byte of the buffer was decoded as a whole message.
+        STREAM_COMPLETE = 0,
+    /// The buffer ends part way through a message header or message.
+        STREAM_TRUNCATED = 1,
+    /// A message header has a templateId with no message in the IR.
+        STREAM_UNKNOWN_TEMPLATE = 2
+};
+
+struct StreamDecodeResult
+{
+    StreamDecodeStatus status;
+    /// Bytes of whole messages, including headers, which were decoded.
+    std::size_t consumedLength;
+    /// Bytes left after the last whole message, starting at the header of the message which could not be decoded.
+    std::size_t remainingLength;
+    std::size_t messageCount;
+};
+
+namespace OtfMessageDecoder {
+
+/**
+ * Decode a buffer of consecutive header prefixed messages, stopping at the first message which is incomplete or has
+ * an unknown templateId. The extent of each message is found before it is decoded so the listener never sees part
+ * of a truncated message.
+ */
+template<typename TokenListener>
+StreamDecodeResult decodeStream(
+    const char *buffer,
+    const std::size_t length,
+    DecodePlanRegistry& registry,
+    TokenListener& listener)
+{
+    const OtfHeaderDecoder& headerDecoder = registry.headerDecoder();
+    const std::size_t headerLength = headerDecoder.encodedLength();
+    StreamDecodeResult result = { STREAM_COMPLETE, 0, length, 0 };
+    std::size_t position = 0;
+
+    while (position < length)
+    {
+        const char *headerBuffer = buffer + position;
+
+        if ((length - position) < headerLength)
+        {
+            result.status = STREAM_TRUNCATED;
+            break;
+        }
+
+        const OtfHeaderFields header = headerDecoder.getFields(headerBuffer);
+        const std::uint64_t templateId = header.templateId;
+        const std::uint64_t actingVersion = header.schemaVersion;
+        const std::size_t blockLength = static_cast<std::size_t>(header.blockLength);
+        const DecodePlan *plan = registry.plan(templateId, actingVersion);
+
+        if (nullptr == plan)
+        {
+            result.status = STREAM_UNKNOWN_TEMPLATE;
+            break;
+        }
+
+        const char *messageBuffer = headerBuffer + headerLength;
+        const std::size_t messageBufferLength = length - position - headerLength;
+        std::size_t messageLength = 0;
+
+        if (!encodedLength(messageBuffer, messageBufferLength, actingVersion, blockLength, *plan, messageLength))
+        {
+            result.status = STREAM_TRUNCATED;
+            break;
+        }
+
+        decode(messageBuffer, messageLength, actingVersion, blockLength, *plan, listener);
+
+        position += headerLength + messageLength;
+        result.messageCount++;
+    }
+
+    result.consumedLength = position;
+    result.remainingLength = length - position;
+
+    return result;
+}
+
+}
+
+}}
+
+#endif
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2013-2020 Real Logic Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _OTF_STRINGPOOL_H
+#define _OTF_STRINGPOOL_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+
+namespace sbe { namespace otf {
+
+/*
+ * Interned names and metadata of tokens. Each distinct string is stored once for the life of the process, so a Token
+ * or Encoding holds a pointer to it and remains cheap to copy. The strings of an IR are a small, bounded set which is
+ * mostly shared between messages and IR files, such as type names, character encodings and time units.
+ *
+ * Interning is thread safe as message tokens may be materialized concurrently.
+ */
+class StringPool
+{
+public:
+    static const std::string *intern(const char *value, std::size_t length)
+    {
+        Pool& pool = instance();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+
+        const Key key = { value, length };
+        std::unordered_map<Key, const std::string *, KeyHash, KeyEquals>::const_iterator it = pool.index.find(key);
+        if (it != pool.index.end())
+        {
+            return it->second;
+        }
+
+        pool.strings.push_back(std::string(value, length));
+        const std::string *interned = &pool.strings.back();
+        const Key internedKey = { interned->data(), interned->size() };
+        pool.index.insert(std::make_pair(internedKey, interned));
+
+        return interned;
+    }
+
+    static const std::string *intern(const std::string& value)
+    {
+        return intern(value.data(), value.size());
+    }
+
+    static const std::string *empty()
+    {
+        static const std::string *emptyString = intern("", 0);
+
+        return emptyString;
+    }
+
+private:
+    struct Key
+    {
+        const char *data;
+        std::size_t length;
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(const Key& key) const
+        {
+            std::uint64_t hash = UINT64_C(14695981039346656037);
+            for (std::size_t i = 0; i < key.length; i++)
+            {
+                hash = (hash ^ static_cast<std::uint8_t>(key.data[i])) * UINT64_C(1099511628211);
+            }
+
+            return static_cast<std::size_t>(hash);
+        }
+    };
+
+    struct KeyEquals
+    {
+        bool operator()(const Key& lhs, const Key& rhs) const
+        {
+            return lhs.length == rhs.length && (0 == lhs.length || 0 == std::memcmp(lhs.data, rhs.data, lhs.length));
+        }
+    };
+
+    // a deque never moves its elements so the keys may point into the strings
+    struct Pool
+    {
+        std::mutex mutex;
+        std::deque<std::string> strings;
+        std::unordered_map<Key, const std::string *, KeyHash, KeyEquals> index;
+    };
+
+    static Pool& instance()
+    {
+        static Pool pool;
+
+        return pool;
+    }
+};
+
+}}
+
+#endif
@@ -18,11 +18,18 @@
 
 #include <cstdint>
 #include <string>
+#include <memory>
+
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
 
 #include "Encoding.h"
 
 namespace sbe { namespace otf {
 
+class EnumIndex;
+
 /// Constants used for holding Token signals
 enum Signal
 {
@@ -63,7 +70,8 @@ enum Signal
 };
 
 /*
- * Hold the state for a single token in the IR
+ * Hold the state for a single token in the IR. Names and metadata are interned into the StringPool, so a token only
+ * holds pointers to them.
  */
 class Token
 {
@@ -76,9 +84,35 @@ public:
         std::int32_t componentTokenCount,
         std::int32_t arrayCapacity,
         Signal signal,
-        std::string name,
-        std::string description,
-        Encoding encoding) :
+        const std::string& name,
+        const std::string& description,
+        const Encoding& encoding) :
+        Token(
+            offset,
+            fieldId,
+            version,
+            encodedLength,
+            componentTokenCount,
+            arrayCapacity,
+            signal,
+            StringPool::intern(name),
+            StringPool::intern(description),
+            encoding)
+    {
+    }
+
+    /// As above with the name and description already interned into the StringPool, as done by the IrDecoder.
+    Token(
+        std::int32_t offset,
+        std::int32_t fieldId,
+        std::int32_t version,
+        std::int32_t encodedLength,
+        std::int32_t componentTokenCount,
+        std::int32_t arrayCapacity,
+        Signal signal,
+        const std::string *name,
+        const std::string *description,
+        const Encoding& encoding) :
         m_offset(offset),
         m_fieldId(fieldId),
         m_version(version),
@@ -86,9 +120,9 @@ public:
         m_componentTokenCount(componentTokenCount),
         m_arrayCapacity(arrayCapacity),
         m_signal(signal),
-        m_name(std::move(name)),
-        m_description(std::move(description)),
-        m_encoding(std::move(encoding))
+        m_name(name),
+        m_description(description),
+        m_encoding(encoding)
     {
     }
 
@@ -99,14 +133,26 @@ public:
 
     inline const std::string& name() const
     {
-        return m_name;
+        return *m_name;
     }
 
     inline const std::string& description() const
     {
-        return m_description;
+        return *m_description;
     }
 
+#if __cplusplus >= 201703L
+    inline std::string_view nameView() const
+    {
+        return *m_name;
+    }
+
+    inline std::string_view descriptionView() const
+    {
+        return *m_description;
+    }
+#endif
+
     inline std::int32_t fieldId() const
     {
         return m_fieldId;
@@ -147,6 +193,17 @@ public:
         return m_encoding.presence() == Presence::SBE_CONSTANT;
     }
 
+    /// Value to name index of a BEGIN_ENUM token, if built by the IrDecoder, else nullptr. See EnumIndex.h.
+    inline const EnumIndex *enumIndex() const
+    {
+        return m_enumIndex.get();
+    }
+
+    inline void enumIndex(std::shared_ptr<const EnumIndex> enumIndex)
+    {
+        m_enumIndex = std::move(enumIndex);
+    }
+
 private:
     const std::int32_t m_offset;
     const std::int32_t m_fieldId;
@@ -155,9 +212,10 @@ private:
     const std::int32_t m_componentTokenCount;
     const std::int32_t m_arrayCapacity;
     const Signal m_signal;
-    const std::string m_name;
-    const std::string m_description;
+    const std::string *const m_name;
+    const std::string *const m_description;
     const Encoding m_encoding;
+    std::shared_ptr<const EnumIndex> m_enumIndex;
 };
 
 }}
@@ -64,6 +64,14 @@ import org.xml.sax.InputSource;
  * <li><b>sbe.target.namespace</b>: Namespace for the generated code to override schema package.</li>
  * <li><b>sbe.cpp.namespaces.collapse</b>: Namespace for the generated code to override schema package.</li>
  * <li>
+ * <b>sbe.cpp.generate.current.version</b>: Generate C++ codecs without acting version checks in a current_version
+ * namespace. Defaults to false.
+ * </li>
+ * <li>
+ * <b>sbe.cpp.generate.validated.views</b>: Generate C++ views checked once by a static validate in a validated
+ * namespace. Defaults to false.
+ * </li>
+ * <li>
  * <b>sbe.java.generate.group-order.annotation</b>: Should the GroupOrder annotation be added to generated stubs.
  * </li>
  * <li><b>sbe.csharp.generate.namespace.dir</b>: Should a directory be created for the namespace under
@@ -145,6 +153,18 @@ public class SbeTool
      */
     public static final String CPP_NAMESPACES_COLLAPSE = "sbe.cpp.namespaces.collapse";
 
+    /**
+     * Boolean system property to turn on or off generation of C++ codecs pinned to the current schema version in a
+     * nested current_version namespace. Defaults to false.
+     */
+    public static final String CPP_GENERATE_CURRENT_VERSION = "sbe.cpp.generate.current.version";
+
+    /**
+     * Boolean system property to turn on or off generation of C++ views, checked once by a static validate, in a
+     * nested validated namespace. Defaults to false.
+     */
+    public static final String CPP_GENERATE_VALIDATED_VIEWS = "sbe.cpp.generate.validated.views";
+
     /**
      * Boolean system property to turn on or off generation of the interface hierarchy. Defaults to false.
      */
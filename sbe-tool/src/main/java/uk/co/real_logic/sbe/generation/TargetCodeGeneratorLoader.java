@@ -69,7 +69,11 @@ public enum TargetCodeGeneratorLoader implements TargetCodeGenerator
     {
         public CodeGenerator newInstance(final Ir ir, final String outputDir)
         {
-            return new CppGenerator(ir, new NamespaceOutputManager(outputDir, ir.applicableNamespace()));
+            return new CppGenerator(
+                ir,
+                Boolean.getBoolean(CPP_GENERATE_CURRENT_VERSION),
+                Boolean.getBoolean(CPP_GENERATE_VALIDATED_VIEWS),
+                new NamespaceOutputManager(outputDir, ir.applicableNamespace()));
         }
     },
 
@@ -155,6 +155,11 @@ public class CGenerator implements CodeGenerator
             i = collectVarData(tokens, i, varData);
             sb.append(generateVarData(groupName, outermostStruct, varData));
 
+            if (groups.isEmpty() && varData.isEmpty())
+            {
+                sb.append(generateGroupColumnEncoder(scope, groupName, groupToken.encodedLength(), fields));
+            }
+
             sb.append(generateGroupPropertyFunctions(outerStruct, groupName, groupToken, cTypeForNumInGroup));
         }
     }
@@ -329,6 +334,138 @@ public class CGenerator implements CodeGenerator
             dimensionHeaderLength, blockLength, groupName));
     }
 
+    /*
+     * Encoding of a group without nested groups or var data from one column per field, for groups of scalar
+     * primitive, enum, and set fields.
+     */
+    private static CharSequence generateGroupColumnEncoder(
+        final CharSequence[] scope, final String groupName, final int blockLength, final List<Token> tokens)
+    {
+        final StringBuilder sb = new StringBuilder();
+        final StringBuilder sbParams = new StringBuilder();
+        final StringBuilder sbArgs = new StringBuilder();
+        final StringBuilder sbStores = new StringBuilder();
+
+        for (int i = 0, size = tokens.size(); i < size; i++)
+        {
+            final Token signalToken = tokens.get(i);
+            if (signalToken.signal() != Signal.BEGIN_FIELD)
+            {
+                continue;
+            }
+
+            final Token typeToken = tokens.get(i + 1);
+            if (signalToken.isConstantEncoding() || typeToken.isConstantEncoding())
+            {
+                continue;
+            }
+
+            final PrimitiveType primitiveType = typeToken.encoding().primitiveType();
+            if (typeToken.signal() == Signal.BEGIN_COMPOSITE || typeToken.encodedLength() != primitiveType.size())
+            {
+                return sb;
+            }
+
+            final String propertyName = formatPropertyName(signalToken.name());
+            final String cTypeName = cTypeName(primitiveType);
+            final String columnType = typeToken.signal() == Signal.BEGIN_ENUM ?
+                formatScopedName(scope, typeToken.applicableTypeName()) : cTypeName;
+            final String byteOrderStr = formatByteOrderEncoding(typeToken.encoding().byteOrder(), primitiveType);
+
+            sbParams.append(",\n    const ").append(columnType).append(" *const ")
+                .append(propertyName).append("_column");
+            sbArgs.append(", ").append(propertyName).append("_column");
+
+            if (primitiveType == PrimitiveType.FLOAT || primitiveType == PrimitiveType.DOUBLE)
+            {
+                sbStores.append(String.format(
+                    "        {\n" +
+                    "            union sbe_%1$s_as_uint val;\n" +
+                    "            val.fp_value = %2$s_column[i];\n" +
+                    "            val.uint_value = %3$s(val.uint_value);\n" +
+                    "            memcpy(element + %4$d, &val, sizeof(%5$s));\n" +
+                    "        }\n",
+                    primitiveType == PrimitiveType.FLOAT ? "float" : "double",
+                    propertyName,
+                    byteOrderStr,
+                    typeToken.offset(),
+                    cTypeName));
+            }
+            else
+            {
+                sbStores.append(String.format(
+                    "        {\n" +
+                    "            %1$s val = %3$s((%1$s)%2$s_column[i]);\n" +
+                    "            memcpy(element + %4$d, &val, sizeof(%1$s));\n" +
+                    "        }\n",
+                    cTypeName,
+                    propertyName,
+                    byteOrderStr,
+                    typeToken.offset()));
+            }
+        }
+
+        if (0 == sbArgs.length())
+        {
+            return sb;
+        }
+
+        sb.append(String.format("\n" +
+            "SBE_ONE_DEF char *%1$s_reserve_elements(\n" +
+            "    %1$s *const codec)\n" +
+            "{\n" +
+            "    const uint64_t offset = *codec->position_ptr;\n" +
+            "    const uint64_t limit = offset + ((codec->count - (codec->index + 1)) * codec->block_length);\n" +
+            "    if (SBE_BOUNDS_CHECK_EXPECT((limit > codec->buffer_length), false))\n" +
+            "    {\n" +
+            "        errno = E108;\n" +
+            "        return NULL;\n" +
+            "    }\n" +
+            "    if (codec->index + 1 < codec->count)\n" +
+            "    {\n" +
+            "        codec->offset = limit - codec->block_length;\n" +
+            "    }\n" +
+            "    codec->index = codec->count - 1;\n" +
+            "    *codec->position_ptr = limit;\n\n" +
+
+            "    return codec->buffer + offset;\n" +
+            "}\n\n" +
+
+            "SBE_ONE_DEF void %1$s_encode_column_range(\n" +
+            "    char *const elements,\n" +
+            "    const uint64_t from_index,\n" +
+            "    const uint64_t to_index%2$s)\n" +
+            "{\n" +
+            "    uint64_t i;\n" +
+            "    for (i = from_index; i < to_index; i++)\n" +
+            "    {\n" +
+            "        char *const element = elements + (i * %3$d);\n" +
+            "%4$s" +
+            "    }\n" +
+            "}\n\n" +
+
+            "SBE_ONE_DEF %1$s *%1$s_encode_columns(\n" +
+            "    %1$s *const codec%2$s)\n" +
+            "{\n" +
+            "    const uint64_t count = codec->count - (codec->index + 1);\n" +
+            "    char *const elements = %1$s_reserve_elements(codec);\n" +
+            "    if (NULL == elements)\n" +
+            "    {\n" +
+            "        return NULL;\n" +
+            "    }\n" +
+            "    %1$s_encode_column_range(elements, 0, count%5$s);\n\n" +
+
+            "    return codec;\n" +
+            "}\n",
+            groupName,
+            sbParams,
+            blockLength,
+            sbStores,
+            sbArgs));
+
+        return sb;
+    }
+
     private CharSequence generateGroupPropertyFunctions(
         final String outerStruct, final String groupName, final Token token, final String cTypeForNumInGroup)
     {
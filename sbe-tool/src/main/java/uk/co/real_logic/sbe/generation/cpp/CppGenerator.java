@@ -33,6 +33,8 @@ import java.io.Writer;
 import java.nio.ByteOrder;
 import java.util.ArrayList;
 import java.util.List;
+import java.util.Map;
+import java.util.TreeMap;
 
 import static uk.co.real_logic.sbe.generation.Generators.toLowerFirstChar;
 import static uk.co.real_logic.sbe.generation.Generators.toUpperFirstChar;
@@ -53,15 +55,33 @@ public class CppGenerator implements CodeGenerator
     private static final String BASE_INDENT = "";
     private static final String INDENT = "    ";
 
+    private static final String VERSION_PINNED_NAMESPACE = "current_version";
+    private static final String VALIDATED_NAMESPACE = "validated";
+
     private final Ir ir;
     private final OutputManager outputManager;
+    private final boolean shouldGenerateCurrentVersion;
+    private final boolean shouldGenerateValidatedViews;
+    private boolean isVersionPinned;
+    private boolean isValidatedView;
 
     public CppGenerator(final Ir ir, final OutputManager outputManager)
+    {
+        this(ir, false, false, outputManager);
+    }
+
+    public CppGenerator(
+        final Ir ir,
+        final boolean shouldGenerateCurrentVersion,
+        final boolean shouldGenerateValidatedViews,
+        final OutputManager outputManager)
     {
         Verify.notNull(ir, "ir");
         Verify.notNull(outputManager, "outputManager");
 
         this.ir = ir;
+        this.shouldGenerateCurrentVersion = shouldGenerateCurrentVersion;
+        this.shouldGenerateValidatedViews = shouldGenerateValidatedViews;
         this.outputManager = outputManager;
     }
 
@@ -145,25 +165,56 @@ public class CppGenerator implements CodeGenerator
             sb.append(generateFileHeader(ir.namespaces(), filename));
             generateTypeStubs(sb);
 
-            for (final List<Token> tokens : ir.messages())
+            generateMessages(sb);
+
+            if (shouldGenerateCurrentVersion && ir.version() > 0)
             {
+                sb.append("\nnamespace ").append(VERSION_PINNED_NAMESPACE).append(" {\n");
+                isVersionPinned = true;
+                generateMessages(sb);
+                isVersionPinned = false;
+                sb.append("}\n");
+            }
 
-                final ArrayList<MessageItem> messageItemList = new ArrayList<MessageItem>();
-                GenerationUtil.getMessageItemList(messageItemList, null, tokens);
-                for (int i = 0; i < messageItemList.size(); i += 1)
-                {
-                    generateMessageItem(sb, messageItemList.get(i), BASE_INDENT);
-                }
+            if (shouldGenerateValidatedViews)
+            {
+                sb.append("\nnamespace ").append(VALIDATED_NAMESPACE).append(" {\n");
+                isValidatedView = true;
+                generateMessages(sb);
+                isValidatedView = false;
+                sb.append("}\n");
             }
+
             sb.append(CppUtil.closingBraces(ir.namespaces().length)).append("#endif\n");
             out.append(sb);
         }
     }
 
+    private void generateMessages(final StringBuilder sb)
+    {
+        for (final List<Token> tokens : ir.messages())
+        {
+            final ArrayList<MessageItem> messageItemList = new ArrayList<MessageItem>();
+            GenerationUtil.getMessageItemList(messageItemList, null, tokens);
+            for (int i = 0; i < messageItemList.size(); i += 1)
+            {
+                generateMessageItem(sb, messageItemList.get(i), BASE_INDENT);
+            }
+        }
+    }
+
     private void generateMessageItem(final StringBuilder sb, final MessageItem messageItem, final String indent)
     {
         final Token rootToken = messageItem.rootToken;
 
+        if (isValidatedView && rootToken.signal() == Signal.BEGIN_GROUP)
+        {
+            final ArrayList<String> parentNamespace = generateMessageItemNamespace(messageItem.parent);
+            sb.append(CppUtil.openingBraces(parentNamespace))
+                .append("class ").append(messageItemClassName(messageItem.parent)).append(";\n")
+                .append(CppUtil.closingBraces(parentNamespace.size()));
+        }
+
         sb.append(CppUtil.openingBraces(generateMessageItemNamespace(messageItem)));
 
         final StringBuilder sbClassType = new StringBuilder();
@@ -175,7 +226,11 @@ public class CppGenerator implements CodeGenerator
         else
         {
             sbClassType.append(generateClassDeclaration(messageItemClassName(messageItem)));
-            sbClassType.append(generateMessageFlyweightCode(messageItemClassName(messageItem), messageItem.rootToken));
+            sbClassType.append(generateMessageFlyweightCode(messageItem));
+            if (isVersionPinned)
+            {
+                sbClassType.append(generateVersionPinnedDispatch(messageItem));
+            }
         }
         final StringBuilder sbLengthType = new StringBuilder();
 
@@ -186,6 +241,12 @@ public class CppGenerator implements CodeGenerator
         );
 
         generateProperties(sbLengthType, sbClassType, messageItem, indent);
+        generateOffsetIndex(sbClassType, messageItem, indent);
+
+        if (isValidatedView)
+        {
+            generateValidation(sbClassType, messageItem, indent);
+        }
 
         sbLengthType.append(indent).append("};\n\n");
         sbClassType.append(indent).append("};\n\n");
@@ -204,6 +265,34 @@ public class CppGenerator implements CodeGenerator
         return String.join("::", ir.namespaces()) + "::" + name;
     }
 
+    private String validatedClassName(final MessageItem messageItem)
+    {
+        return "::" + fullClassNameForType(VALIDATED_NAMESPACE + "::" + messageItemFullClassName(messageItem));
+    }
+
+    /*
+     * A bounds check on a decode path, left out of the validated view whose buffer has been checked by validate.
+     * Checks shared with encoding, such as sbeCheckPosition and next, are kept in the view.
+     */
+    private String generateDecodeCheck(final String indent, final String condition, final String... onFailure)
+    {
+        if (isValidatedView)
+        {
+            return "";
+        }
+
+        final StringBuilder sb = new StringBuilder()
+            .append(indent).append("        if (SBE_BOUNDS_CHECK_EXPECT((").append(condition).append("), false))\n")
+            .append(indent).append("        {\n");
+
+        for (final String statement : onFailure)
+        {
+            sb.append(indent).append("            ").append(statement).append("\n");
+        }
+
+        return sb.append(indent).append("        }\n").toString();
+    }
+
     private static String messageItemClassName(final MessageItem messageItem)
     {
         final String formattedName = formatClassName(messageItem.rootToken.name());
@@ -228,7 +317,7 @@ public class CppGenerator implements CodeGenerator
         return result;
     }
 
-    private static void generateGroupClassHeader(
+    private void generateGroupClassHeader(
         final StringBuilder sb,
         final MessageItem messageItem,
         final String indent)
@@ -253,15 +342,18 @@ public class CppGenerator implements CodeGenerator
             indent + "    std::uint64_t m_count;\n" +
             indent + "    std::uint64_t m_index;\n" +
             indent + "    std::uint64_t m_offset;\n" +
-            indent + "    std::uint64_t m_actingVersion;\n\n" +
+            indent + "    std::uint64_t m_actingVersion;\n" +
+            indent + "    std::uint64_t m_elementPosition;\n\n" +
 
             indent + "    SBE_NODISCARD std::uint64_t *sbePositionPtr() SBE_NOEXCEPT\n" +
             indent + "    {\n" +
             indent + "        return m_positionPtr;\n" +
             indent + "    }\n\n" +
 
-            indent + "public:\n",
-            messageItemClassName(messageItem));
+            "%2$s",
+            messageItemClassName(messageItem),
+            isValidatedView ?
+            indent + "    friend class " + validatedClassName(messageItem.parent) + ";\n\n" : indent + "public:\n");
 
         new Formatter(sb).format(
             indent + "    inline void wrapForDecode(\n" +
@@ -270,18 +362,60 @@ public class CppGenerator implements CodeGenerator
             indent + "        const std::uint64_t actingVersion,\n" +
             indent + "        const std::uint64_t bufferLength)\n" +
             indent + "    {\n" +
+            indent + "        m_index = 0;\n" +
+            indent + "        m_actingVersion = actingVersion;\n" +
+            indent + "        m_initialPosition = *pos;\n" +
+            indent + "        m_positionPtr = pos;\n" +
+            "%4$s" +
             indent + "        %2$s dimensions(buffer, *pos, bufferLength, actingVersion);\n" +
             indent + "        m_buffer = buffer;\n" +
             indent + "        m_bufferLength = bufferLength;\n" +
             indent + "        m_blockLength = dimensions.blockLength();\n" +
             indent + "        m_count = dimensions.numInGroup();\n" +
+            indent + "        *m_positionPtr = *m_positionPtr + %1$d;\n" +
+            indent + "    }\n\n" +
+
+            indent + "#if __cplusplus >= 201103L\n" +
+            indent + "    inline void wrapForDecode(\n" +
+            indent + "        char *buffer,\n" +
+            indent + "        std::uint64_t *pos,\n" +
+            indent + "        const std::uint64_t actingVersion,\n" +
+            indent + "        const std::uint64_t bufferLength,\n" +
+            indent + "        std::error_code &ec) SBE_NOEXCEPT\n" +
+            indent + "    {\n" +
+            indent + "        m_buffer = buffer;\n" +
+            indent + "        m_bufferLength = bufferLength;\n" +
+            indent + "        m_blockLength = 0;\n" +
+            indent + "        m_count = 0;\n" +
             indent + "        m_index = 0;\n" +
             indent + "        m_actingVersion = actingVersion;\n" +
             indent + "        m_initialPosition = *pos;\n" +
             indent + "        m_positionPtr = pos;\n" +
+            "%3$s" +
+            indent + "        %2$s dimensions(buffer, *pos, bufferLength, actingVersion);\n" +
+            indent + "        m_blockLength = dimensions.blockLength();\n" +
+            indent + "        m_count = dimensions.numInGroup();\n" +
             indent + "        *m_positionPtr = *m_positionPtr + %1$d;\n" +
-            indent + "    }\n",
-            dimensionHeaderLength, dimensionsClassName);
+            indent + "    }\n" +
+            indent + "#endif\n",
+            dimensionHeaderLength,
+            dimensionsClassName,
+            generateDecodeCheck(
+                indent,
+                "(*pos + " + dimensionHeaderLength + ") > bufferLength",
+                "m_buffer = nullptr;",
+                "m_bufferLength = 0;",
+                "sbe_set_error(ec, E108);",
+                "return;"),
+            generateDecodeCheck(
+                indent,
+                "(*pos + " + dimensionHeaderLength + ") > bufferLength",
+                "m_buffer = nullptr;",
+                "m_bufferLength = 0;",
+                "m_blockLength = 0;",
+                "m_count = 0;",
+                "sbe_throw_errnum(E108, \"buffer too short for repeating group [E108]\");",
+                "return;"));
 
         final long minCount = numInGroupToken.encoding().applicableMinValue().longValue();
         final String minCheck = minCount > 0 ? "count < " + minCount + " || " : "";
@@ -320,6 +454,11 @@ public class CppGenerator implements CodeGenerator
             numInGroupToken.encoding().applicableMaxValue().longValue(),
             dimensionsClassName);
 
+        if (isValidatedView)
+        {
+            sb.append("\n").append(indent).append("public:");
+        }
+
         new Formatter(sb).format("\n" +
             indent + "    static SBE_CONSTEXPR std::uint64_t sbeHeaderSize() SBE_NOEXCEPT\n" +
             indent + "    {\n" +
@@ -341,6 +480,8 @@ public class CppGenerator implements CodeGenerator
             indent + "    {\n" +
             indent + "        if (SBE_BOUNDS_CHECK_EXPECT((position > m_bufferLength), false))\n" +
             indent + "        {\n" +
+            indent + "            m_buffer = nullptr;\n" +
+            indent + "            m_bufferLength = 0;\n" +
             indent + "            sbe_throw_errnum(E100, \"buffer too short [E100]\");\n" +
             indent + "            return UINT64_MAX;\n" +
             indent + "        }\n" +
@@ -369,17 +510,38 @@ public class CppGenerator implements CodeGenerator
             indent + "            sbe_throw_errnum(E108, \"index >= count [E108]\");\n" +
             indent + "            return *this;\n" +
             indent + "        }\n" +
-            indent + "        m_offset = *m_positionPtr;\n" +
-            indent + "        if (SBE_BOUNDS_CHECK_EXPECT(((m_offset + m_blockLength) > m_bufferLength), false))\n" +
+            indent + "        if (SBE_BOUNDS_CHECK_EXPECT(\n" +
+            indent + "            ((*m_positionPtr + m_blockLength) > m_bufferLength), false))\n" +
             indent + "        {\n" +
+            indent + "            m_count = m_index;\n" +
             indent + "            sbe_throw_errnum(E108, \"buffer too short for next group index [E108]\");\n" +
             indent + "            return *this;\n" +
             indent + "        }\n" +
+            indent + "        m_offset = *m_positionPtr;\n" +
             indent + "        *m_positionPtr = m_offset + m_blockLength;\n" +
             indent + "        ++m_index;\n\n" +
 
             indent + "        return *this;\n" +
-            indent + "    }\n",
+            indent + "    }\n\n" +
+
+            indent + "#if __cplusplus >= 201103L\n" +
+            indent + "    inline %3$s &next(std::error_code &ec) SBE_NOEXCEPT\n" +
+            indent + "    {\n" +
+            indent + "        if (m_index >= m_count ||\n" +
+            indent + "            SBE_BOUNDS_CHECK_EXPECT(((*m_positionPtr + m_blockLength) > m_bufferLength), " +
+            "false))\n" +
+            indent + "        {\n" +
+            indent + "            m_count = m_index;\n" +
+            indent + "            sbe_set_error(ec, E108);\n" +
+            indent + "            return *this;\n" +
+            indent + "        }\n" +
+            indent + "        m_offset = *m_positionPtr;\n" +
+            indent + "        *m_positionPtr = m_offset + m_blockLength;\n" +
+            indent + "        ++m_index;\n\n" +
+
+            indent + "        return *this;\n" +
+            indent + "    }\n" +
+            indent + "#endif\n",
             dimensionHeaderLength,
             blockLength,
             messageItemFullClassName(messageItem));
@@ -416,6 +578,364 @@ public class CppGenerator implements CodeGenerator
             .append(indent).append("    }\n\n")
 
             .append(indent).append("#endif\n");
+
+        if (messageItem.isConst())
+        {
+            generateGroupElements(sb, messageItem, indent);
+            generateGroupColumnEncoder(sb, messageItem, indent);
+        }
+    }
+
+    /*
+     * Encoding of a group without nested groups or var data from one column per field, for groups of scalar
+     * primitive, enum, and set fields.
+     */
+    private static void generateGroupColumnEncoder(
+        final StringBuilder sb,
+        final MessageItem messageItem,
+        final String indent)
+    {
+        final String className = messageItemClassName(messageItem);
+        final int blockLength = messageItem.rootToken.encodedLength();
+        final List<Token> tokens = messageItem.fields;
+        final StringBuilder sbParams = new StringBuilder();
+        final StringBuilder sbArgs = new StringBuilder();
+        final StringBuilder sbStores = new StringBuilder();
+        final String storeIndent = indent + INDENT + INDENT + INDENT;
+
+        for (int i = 0, size = tokens.size(); i < size; i++)
+        {
+            final Token signalToken = tokens.get(i);
+            if (signalToken.signal() != Signal.BEGIN_FIELD)
+            {
+                continue;
+            }
+
+            final Token typeToken = tokens.get(i + 1);
+            if (signalToken.isConstantEncoding() || typeToken.isConstantEncoding())
+            {
+                continue;
+            }
+
+            final PrimitiveType primitiveType = typeToken.encoding().primitiveType();
+            if (typeToken.signal() == Signal.BEGIN_COMPOSITE || typeToken.encodedLength() != primitiveType.size())
+            {
+                return;
+            }
+
+            final String propertyName = formatPropertyName(signalToken.name());
+            final String cppTypeName = cppTypeName(primitiveType);
+            final String columnType = typeToken.signal() == Signal.BEGIN_ENUM ?
+                formatClassName(typeToken.applicableTypeName()) + "::Value" : cppTypeName;
+            final String byteOrderStr = formatByteOrderEncoding(typeToken.encoding().byteOrder(), primitiveType);
+
+            sbParams.append(",\n").append(indent).append(INDENT).append(INDENT)
+                .append("const ").append(columnType).append(" *").append(propertyName).append("Column");
+            sbArgs.append(", ").append(propertyName).append("Column");
+
+            if (primitiveType == PrimitiveType.FLOAT || primitiveType == PrimitiveType.DOUBLE)
+            {
+                new Formatter(sbStores).format(
+                    storeIndent + "%1$s %2$sValue;\n" +
+                    storeIndent + "%2$sValue.fp_value = %2$sColumn[i];\n" +
+                    storeIndent + "%2$sValue.uint_value = %3$s(%2$sValue.uint_value);\n" +
+                    storeIndent + "std::memcpy(element + %4$d, &%2$sValue, sizeof(%5$s));\n",
+                    primitiveType == PrimitiveType.FLOAT ? "union sbe_float_as_uint" : "union sbe_double_as_uint",
+                    propertyName,
+                    byteOrderStr,
+                    typeToken.offset(),
+                    cppTypeName);
+            }
+            else
+            {
+                new Formatter(sbStores).format(
+                    storeIndent + "%1$s %2$sValue = %3$s(static_cast<%1$s>(%2$sColumn[i]));\n" +
+                    storeIndent + "std::memcpy(element + %4$d, &%2$sValue, sizeof(%1$s));\n",
+                    cppTypeName,
+                    propertyName,
+                    byteOrderStr,
+                    typeToken.offset());
+            }
+        }
+
+        if (0 == sbArgs.length())
+        {
+            return;
+        }
+
+        new Formatter(sb).format("\n" +
+            indent + "    /*\n" +
+            indent + "     * Reserve the elements not yet encoded with next(), returning where the first starts\n" +
+            indent + "     * for encodeColumnRange, which may encode disjoint ranges of them concurrently.\n" +
+            indent + "     */\n" +
+            indent + "    char *reserveElements()\n" +
+            indent + "    {\n" +
+            indent + "        const std::uint64_t offset = *m_positionPtr;\n" +
+            indent + "        const std::uint64_t limit = offset + ((m_count - m_index) * m_blockLength);\n" +
+            indent + "        if (SBE_BOUNDS_CHECK_EXPECT((limit > m_bufferLength), false))\n" +
+            indent + "        {\n" +
+            indent + "            sbe_throw_errnum(E108, \"buffer too short for group elements [E108]\");\n" +
+            indent + "            return nullptr;\n" +
+            indent + "        }\n" +
+            indent + "        if (m_index < m_count)\n" +
+            indent + "        {\n" +
+            indent + "            m_offset = limit - m_blockLength;\n" +
+            indent + "        }\n" +
+            indent + "        m_index = m_count;\n" +
+            indent + "        *m_positionPtr = limit;\n" +
+            indent + "        return m_buffer + offset;\n" +
+            indent + "    }\n\n" +
+
+            indent + "    /*\n" +
+            indent + "     * Encode elements [fromIndex, toIndex) of those reserved, element i from index i of each\n" +
+            indent + "     * column. The stride and field offsets are constant so the loop is left to vectorize.\n" +
+            indent + "     */\n" +
+            indent + "    static void encodeColumnRange(\n" +
+            indent + "        char *elements,\n" +
+            indent + "        const std::uint64_t fromIndex,\n" +
+            indent + "        const std::uint64_t toIndex%1$s) SBE_NOEXCEPT\n" +
+            indent + "    {\n" +
+            indent + "        for (std::uint64_t i = fromIndex; i < toIndex; i++)\n" +
+            indent + "        {\n" +
+            indent + "            char *element = elements + (i * %2$d);\n" +
+            "%3$s" +
+            indent + "        }\n" +
+            indent + "    }\n\n" +
+
+            indent + "    %4$s &encodeColumns(%5$s)\n" +
+            indent + "    {\n" +
+            indent + "        const std::uint64_t count = m_count - m_index;\n" +
+            indent + "        char *elements = reserveElements();\n" +
+            indent + "        if (nullptr != elements)\n" +
+            indent + "        {\n" +
+            indent + "            encodeColumnRange(elements, 0, count%6$s);\n" +
+            indent + "        }\n" +
+            indent + "        return *this;\n" +
+            indent + "    }\n",
+            sbParams,
+            blockLength,
+            sbStores,
+            className,
+            "\n" + sbParams.substring(2),
+            sbArgs);
+    }
+
+    private void generateGroupElements(
+        final StringBuilder sb,
+        final MessageItem messageItem,
+        final String indent)
+    {
+        final String className = messageItemClassName(messageItem);
+        final int dimensionHeaderLength = messageItem.tokens.get(1).encodedLength();
+
+        new Formatter(sb).format("\n" +
+            indent + "    /*\n" +
+            indent + "     * Elements of a group without nested groups or var data, an array of blockLength stride\n" +
+            indent + "     * checked against the buffer once, so indexing them is unchecked.\n" +
+            indent + "     */\n" +
+            indent + "    class Elements\n" +
+            indent + "    {\n" +
+            indent + "    private:\n" +
+            indent + "        char *m_buffer;\n" +
+            indent + "        std::uint64_t m_bufferLength;\n" +
+            indent + "        std::uint64_t m_offset;\n" +
+            indent + "        std::uint64_t m_blockLength;\n" +
+            indent + "        std::uint64_t m_count;\n" +
+            indent + "        std::uint64_t m_actingVersion;\n" +
+            indent + "        mutable std::uint64_t m_position;\n\n" +
+
+            indent + "    public:\n" +
+            indent + "        class iterator\n" +
+            indent + "        {\n" +
+            indent + "        private:\n" +
+            indent + "            const Elements *m_elements;\n" +
+            indent + "            std::uint64_t m_index;\n\n" +
+
+            indent + "        public:\n" +
+            indent + "            iterator(const Elements *elements, const std::uint64_t index) SBE_NOEXCEPT :\n" +
+            indent + "                m_elements(elements), m_index(index)\n" +
+            indent + "            {\n" +
+            indent + "            }\n\n" +
+
+            indent + "            %1$s operator*() const SBE_NOEXCEPT\n" +
+            indent + "            {\n" +
+            indent + "                return (*m_elements)[m_index];\n" +
+            indent + "            }\n\n" +
+
+            indent + "            iterator &operator++() SBE_NOEXCEPT\n" +
+            indent + "            {\n" +
+            indent + "                ++m_index;\n" +
+            indent + "                return *this;\n" +
+            indent + "            }\n\n" +
+
+            indent + "            bool operator==(const iterator &other) const SBE_NOEXCEPT\n" +
+            indent + "            {\n" +
+            indent + "                return m_index == other.m_index;\n" +
+            indent + "            }\n\n" +
+
+            indent + "            bool operator!=(const iterator &other) const SBE_NOEXCEPT\n" +
+            indent + "            {\n" +
+            indent + "                return m_index != other.m_index;\n" +
+            indent + "            }\n" +
+            indent + "        };\n\n" +
+
+            indent + "        Elements(\n" +
+            indent + "            char *buffer,\n" +
+            indent + "            const std::uint64_t bufferLength,\n" +
+            indent + "            const std::uint64_t offset,\n" +
+            indent + "            const std::uint64_t blockLength,\n" +
+            indent + "            const std::uint64_t count,\n" +
+            indent + "            const std::uint64_t actingVersion) SBE_NOEXCEPT :\n" +
+            indent + "            m_buffer(buffer),\n" +
+            indent + "            m_bufferLength(bufferLength),\n" +
+            indent + "            m_offset(offset),\n" +
+            indent + "            m_blockLength(blockLength),\n" +
+            indent + "            m_count(count),\n" +
+            indent + "            m_actingVersion(actingVersion),\n" +
+            indent + "            m_position(offset + (count * blockLength))\n" +
+            indent + "        {\n" +
+            indent + "        }\n\n" +
+
+            indent + "        SBE_NODISCARD std::uint64_t size() const SBE_NOEXCEPT\n" +
+            indent + "        {\n" +
+            indent + "            return m_count;\n" +
+            indent + "        }\n\n" +
+
+            indent + "        SBE_NODISCARD bool empty() const SBE_NOEXCEPT\n" +
+            indent + "        {\n" +
+            indent + "            return 0 == m_count;\n" +
+            indent + "        }\n\n" +
+
+            indent + "        SBE_NODISCARD std::uint64_t stride() const SBE_NOEXCEPT\n" +
+            indent + "        {\n" +
+            indent + "            return m_blockLength;\n" +
+            indent + "        }\n\n" +
+
+            indent + "        SBE_NODISCARD const char *data() const SBE_NOEXCEPT\n" +
+            indent + "        {\n" +
+            indent + "            return m_buffer + m_offset;\n" +
+            indent + "        }\n\n" +
+
+            indent + "        /*\n" +
+            indent + "         * The element is past the last, so hasNext() is false and next() fails, and its\n" +
+            indent + "         * position is that past the group, held here for as long as these elements.\n" +
+            indent + "         */\n" +
+            indent + "        SBE_NODISCARD %1$s operator[](const std::uint64_t index) const SBE_NOEXCEPT\n" +
+            indent + "        {\n" +
+            indent + "            %1$s element;\n" +
+            indent + "            element.m_buffer = m_buffer;\n" +
+            indent + "            element.m_bufferLength = m_bufferLength;\n" +
+            indent + "            element.m_initialPosition = m_offset - %2$d;\n" +
+            indent + "            element.m_positionPtr = &m_position;\n" +
+            indent + "            element.m_blockLength = m_blockLength;\n" +
+            indent + "            element.m_count = m_count;\n" +
+            indent + "            element.m_index = m_count;\n" +
+            indent + "            element.m_offset = m_offset + (index * m_blockLength);\n" +
+            indent + "            element.m_actingVersion = m_actingVersion;\n" +
+            indent + "            element.m_elementPosition = m_position;\n" +
+            indent + "            return element;\n" +
+            indent + "        }\n\n" +
+
+            indent + "        SBE_NODISCARD iterator begin() const SBE_NOEXCEPT\n" +
+            indent + "        {\n" +
+            indent + "            return iterator(this, 0);\n" +
+            indent + "        }\n\n" +
+
+            indent + "        SBE_NODISCARD iterator end() const SBE_NOEXCEPT\n" +
+            indent + "        {\n" +
+            indent + "            return iterator(this, m_count);\n" +
+            indent + "        }\n" +
+            indent + "    };\n\n" +
+
+            indent + "    /*\n" +
+            indent + "     * All elements of the group, leaving the position past the group as if each had been\n" +
+            indent + "     * read with next(). Elements are for field access only and do not move the position.\n" +
+            indent + "     */\n" +
+            indent + "    Elements elements()\n" +
+            indent + "    {\n" +
+            indent + "        const std::uint64_t offset = m_initialPosition + %2$d;\n" +
+            indent + "        const std::uint64_t limit = offset + (m_count * m_blockLength);\n" +
+            "%4$s" +
+            indent + "        m_index = m_count;\n" +
+            indent + "        *m_positionPtr = limit;\n" +
+            indent + "        return Elements(\n" +
+            indent + "            m_buffer, m_bufferLength, offset, m_blockLength, m_count, m_actingVersion);\n" +
+            indent + "    }\n\n" +
+
+            indent + "    /*\n" +
+            indent + "     * Position past a group at the given position, from its dimensions alone.\n" +
+            indent + "     */\n" +
+            indent + "    static std::uint64_t sbeSkipPosition(\n" +
+            indent + "        const char *buffer,\n" +
+            indent + "        const std::uint64_t position,\n" +
+            indent + "        const std::uint64_t bufferLength,\n" +
+            indent + "        const std::uint64_t actingVersion)\n" +
+            indent + "    {\n" +
+            indent + "        const %3$s dimensions(\n" +
+            indent + "            const_cast<char *>(buffer), position, bufferLength, actingVersion);\n" +
+            indent + "        const std::uint64_t limit = position + %2$d +\n" +
+            indent + "            (static_cast<std::uint64_t>(dimensions.numInGroup()) * dimensions.blockLength());\n" +
+            indent + "        if (SBE_BOUNDS_CHECK_EXPECT((limit > bufferLength), false))\n" +
+            indent + "        {\n" +
+            indent + "            sbe_throw_errnum(E108, \"buffer too short for group elements [E108]\");\n" +
+            indent + "            return UINT64_MAX;\n" +
+            indent + "        }\n" +
+            indent + "        return limit;\n" +
+            indent + "    }\n",
+            className,
+            dimensionHeaderLength,
+            formatClassName(messageItem.tokens.get(1).name()),
+            generateDecodeCheck(
+                indent,
+                "limit > m_bufferLength",
+                "sbe_throw_errnum(E108, \"buffer too short for group elements [E108]\");",
+                "return Elements(",
+                "    m_buffer, m_bufferLength, offset, m_blockLength, 0, m_actingVersion);"));
+    }
+
+    private String generateDecodeLength(final MessageItem messageItem)
+    {
+        boolean isClosedForm = messageItem.varData.isEmpty();
+        for (final MessageItem child : messageItem.children)
+        {
+            isClosedForm &= child.isConst();
+        }
+
+        final StringBuilder sb = new StringBuilder();
+
+        if (!isClosedForm)
+        {
+            return sb
+                .append("    SBE_NODISCARD std::uint64_t decodeLength() const\n")
+                .append("    {\n")
+                .append("        ").append(messageItemClassName(messageItem))
+                .append(" skipper(m_buffer, m_offset,\n")
+                .append("            m_bufferLength, sbeBlockLength(), m_actingVersion);\n")
+                .append("        skipper.skip();\n")
+                .append("        return skipper.encodedLength();\n")
+                .append("    }\n\n")
+                .toString();
+        }
+
+        sb.append("    SBE_NODISCARD std::uint64_t decodeLength() const\n")
+            .append("    {\n")
+            .append("        std::uint64_t position = m_offset + sbeBlockLength();\n")
+            .append(generateDecodeCheck(
+                BASE_INDENT,
+                "position > m_bufferLength",
+                "sbe_throw_errnum(E100, \"buffer too short [E100]\");",
+                "return UINT64_MAX;"));
+
+        for (final MessageItem child : messageItem.children)
+        {
+            sb.append("        position = ").append(messageItemFullClassName(child))
+                .append("::sbeSkipPosition(m_buffer, position, m_bufferLength, m_actingVersion);\n");
+        }
+
+        return sb
+            .append("        return position - m_offset;\n")
+            .append("    }\n\n")
+            .toString();
     }
 
     private void generateGroupProperty(
@@ -449,7 +969,16 @@ public class CppGenerator implements CodeGenerator
             indent + "    {\n" +
             indent + "        m_%2$s.wrapForDecode(m_buffer, sbePositionPtr(), m_actingVersion, m_bufferLength);\n" +
             indent + "        return m_%2$s;\n" +
-            indent + "    }\n",
+            indent + "    }\n\n" +
+
+            indent + "#if __cplusplus >= 201103L\n" +
+            indent + "    SBE_NODISCARD inline %1$s &%2$s(std::error_code &ec) SBE_NOEXCEPT\n" +
+            indent + "    {\n" +
+            indent + "        m_%2$s.wrapForDecode(" +
+            "m_buffer, sbePositionPtr(), m_actingVersion, m_bufferLength, ec);\n" +
+            indent + "        return m_%2$s;\n" +
+            indent + "    }\n" +
+            indent + "#endif\n",
             className,
             propertyName);
 
@@ -503,59 +1032,59 @@ public class CppGenerator implements CodeGenerator
             generateVarDataDescriptors(
                 sb, token, propertyName, characterEncoding, lengthToken, lengthOfLengthField, lengthCppType, indent);
 
+            final String lengthCheck = generateVarDataLengthCheck(
+                lengthOfLengthField, lengthCppType, lengthByteOrderStr, indent);
+            final String throwError = "sbe_throw_errnum(E100, \"buffer too short [E100]\")";
+            final String setError = "sbe_set_error(ec, E100)";
+
             new Formatter(sb).format("\n" +
                 indent + "    std::uint64_t %1$sSkip()\n" +
                 indent + "    {\n" +
                 "%2$s" +
-                indent + "        std::uint64_t lengthPosition = sbePosition();\n" +
-                indent + "        %3$s lengthValue;\n" +
-                indent + "        std::memcpy(&lengthValue, m_buffer + lengthPosition, sizeof(lengthValue));\n" +
-                indent + "        std::uint64_t dataLength = %4$s(lengthValue);\n" +
-                indent + "        sbePosition(lengthPosition + sizeof(lengthValue) + dataLength);\n" +
+                "%3$s" +
+                indent + "        sbePosition(pos + dataLength);\n" +
                 indent + "        return dataLength;\n" +
                 indent + "    }\n",
                 propertyName,
                 generateArrayFieldNotPresentCondition(token.version(), indent),
-                lengthCppType,
-                lengthByteOrderStr);
+                String.format(lengthCheck, throwError, "0"));
 
             new Formatter(sb).format("\n" +
                 indent + "    SBE_NODISCARD const char *%1$s()\n" +
                 indent + "    {\n" +
                 "%2$s" +
-                indent + "        %4$s lengthFieldValue;\n" +
-                indent + "        std::memcpy(&lengthFieldValue, m_buffer + sbePosition(), sizeof(%4$s));\n" +
-                indent + "        const char *fieldPtr = m_buffer + sbePosition() + %3$d;\n" +
-                indent + "        sbePosition(sbePosition() + %3$d + %5$s(lengthFieldValue));\n" +
-                indent + "        return fieldPtr;\n" +
-                indent + "    }\n",
+                "%3$s" +
+                indent + "        sbePosition(pos + dataLength);\n" +
+                indent + "        return m_buffer + pos;\n" +
+                indent + "    }\n\n" +
+
+                indent + "#if __cplusplus >= 201103L\n" +
+                indent + "    SBE_NODISCARD const char *%1$s(std::error_code &ec) SBE_NOEXCEPT\n" +
+                indent + "    {\n" +
+                "%2$s" +
+                "%4$s" +
+                indent + "        sbePosition(pos + dataLength);\n" +
+                indent + "        return m_buffer + pos;\n" +
+                indent + "    }\n" +
+                indent + "#endif\n",
                 formatPropertyName(propertyName),
                 generateTypeFieldNotPresentCondition(token.version(), indent),
-                lengthOfLengthField,
-                lengthCppType,
-                lengthByteOrderStr);
+                String.format(lengthCheck, throwError, "nullptr"),
+                String.format(lengthCheck, setError, "nullptr"));
 
             new Formatter(sb).format("\n" +
                 indent + "    std::uint64_t get%1$s(char *dst, const std::uint64_t length)\n" +
                 indent + "    {\n" +
                 "%2$s" +
-                indent + "        std::uint64_t lengthOfLengthField = %3$d;\n" +
-                indent + "        std::uint64_t lengthPosition = sbePosition();\n" +
-                indent + "        sbePosition(lengthPosition + lengthOfLengthField);\n" +
-                indent + "        %5$s lengthFieldValue;\n" +
-                indent + "        std::memcpy(&lengthFieldValue, m_buffer + lengthPosition, sizeof(%5$s));\n" +
-                indent + "        std::uint64_t dataLength = %4$s(lengthFieldValue);\n" +
+                "%3$s" +
                 indent + "        std::uint64_t bytesToCopy = length < dataLength ? length : dataLength;\n" +
-                indent + "        std::uint64_t pos = sbePosition();\n" +
                 indent + "        sbePosition(pos + dataLength);\n" +
                 indent + "        std::memcpy(dst, m_buffer + pos, static_cast<std::size_t>(bytesToCopy));\n" +
                 indent + "        return bytesToCopy;\n" +
                 indent + "    }\n",
                 propertyName,
                 generateArrayFieldNotPresentCondition(token.version(), indent),
-                lengthOfLengthField,
-                lengthByteOrderStr,
-                lengthCppType);
+                String.format(lengthCheck, throwError, "0"));
 
             new Formatter(sb).format("\n" +
                 indent + "    %5$s &put%1$s(const char *src, const %3$s length)\n" +
@@ -583,22 +1112,26 @@ public class CppGenerator implements CodeGenerator
                 indent + "    std::string get%1$sAsString()\n" +
                 indent + "    {\n" +
                 "%2$s" +
-                indent + "        std::uint64_t lengthOfLengthField = %3$d;\n" +
-                indent + "        std::uint64_t lengthPosition = sbePosition();\n" +
-                indent + "        sbePosition(lengthPosition + lengthOfLengthField);\n" +
-                indent + "        %5$s lengthFieldValue;\n" +
-                indent + "        std::memcpy(&lengthFieldValue, m_buffer + lengthPosition, sizeof(%5$s));\n" +
-                indent + "        std::uint64_t dataLength = %4$s(lengthFieldValue);\n" +
-                indent + "        std::uint64_t pos = sbePosition();\n" +
+                "%3$s" +
                 indent + "        const std::string result(m_buffer + pos, static_cast<std::size_t>(dataLength));\n" +
                 indent + "        sbePosition(pos + dataLength);\n" +
                 indent + "        return result;\n" +
-                indent + "    }\n",
+                indent + "    }\n\n" +
+
+                indent + "#if __cplusplus >= 201103L\n" +
+                indent + "    std::string get%1$sAsString(std::error_code &ec)\n" +
+                indent + "    {\n" +
+                "%2$s" +
+                "%4$s" +
+                indent + "        const std::string result(m_buffer + pos, static_cast<std::size_t>(dataLength));\n" +
+                indent + "        sbePosition(pos + dataLength);\n" +
+                indent + "        return result;\n" +
+                indent + "    }\n" +
+                indent + "#endif\n",
                 propertyName,
                 generateStringNotPresentCondition(token.version(), indent),
-                lengthOfLengthField,
-                lengthByteOrderStr,
-                lengthCppType);
+                String.format(lengthCheck, throwError, "std::string()"),
+                String.format(lengthCheck, setError, "std::string()"));
 
             generateJsonEscapedStringGetter(sb, token, indent, propertyName);
 
@@ -607,13 +1140,7 @@ public class CppGenerator implements CodeGenerator
                 indent + "    std::string_view get%1$sAsStringView()\n" +
                 indent + "    {\n" +
                 "%2$s" +
-                indent + "        std::uint64_t lengthOfLengthField = %3$d;\n" +
-                indent + "        std::uint64_t lengthPosition = sbePosition();\n" +
-                indent + "        sbePosition(lengthPosition + lengthOfLengthField);\n" +
-                indent + "        %5$s lengthFieldValue;\n" +
-                indent + "        std::memcpy(&lengthFieldValue, m_buffer + lengthPosition, sizeof(%5$s));\n" +
-                indent + "        std::uint64_t dataLength = %4$s(lengthFieldValue);\n" +
-                indent + "        std::uint64_t pos = sbePosition();\n" +
+                "%3$s" +
                 indent + "        const std::string_view result(m_buffer + pos, dataLength);\n" +
                 indent + "        sbePosition(pos + dataLength);\n" +
                 indent + "        return result;\n" +
@@ -621,9 +1148,7 @@ public class CppGenerator implements CodeGenerator
                 indent + "    #endif\n",
                 propertyName,
                 generateStringViewNotPresentCondition(token.version(), indent),
-                lengthOfLengthField,
-                lengthByteOrderStr,
-                lengthCppType);
+                String.format(lengthCheck, throwError, "std::string_view()"));
 
             new Formatter(sb).format("\n" +
                 indent + "    %1$s &put%2$s(const std::string& str)\n" +
@@ -661,8 +1186,28 @@ public class CppGenerator implements CodeGenerator
         }
     }
 
-    private void generateVarDataDescriptors(
-        final StringBuilder sb,
+    /**
+     * Generate the checks shared by var data getters as a format string taking the statement that reports an error
+     * and the value to return in its place. The length field and the data are checked against the buffer before
+     * either is read, so a failed check leaves the position unchanged even when errors do not throw.
+     */
+    private String generateVarDataLengthCheck(
+        final int lengthOfLengthField, final String lengthCppType, final String lengthByteOrderStr, final String indent)
+    {
+        return
+            indent + "        const std::uint64_t lengthPosition = sbePosition();\n" +
+            generateDecodeCheck(
+                indent, "(lengthPosition + " + lengthOfLengthField + ") > m_bufferLength", "%1$s;", "return %2$s;") +
+            indent + "        " + lengthCppType + " lengthFieldValue;\n" +
+            indent + "        std::memcpy(&lengthFieldValue, m_buffer + lengthPosition, sizeof(" + lengthCppType +
+            "));\n" +
+            indent + "        const std::uint64_t dataLength = " + lengthByteOrderStr + "(lengthFieldValue);\n" +
+            indent + "        const std::uint64_t pos = lengthPosition + " + lengthOfLengthField + ";\n" +
+            generateDecodeCheck(indent, "dataLength > (m_bufferLength - pos)", "%1$s;", "return %2$s;");
+    }
+
+    private void generateVarDataDescriptors(
+        final StringBuilder sb,
         final Token token,
         final String propertyName,
         final String characterEncoding,
@@ -711,14 +1256,36 @@ public class CppGenerator implements CodeGenerator
             indent + "    SBE_NODISCARD %4$s %1$sLength() const\n" +
             indent + "    {\n" +
             "%2$s" +
+            "%5$s" +
             indent + "        %4$s length;\n" +
             indent + "        std::memcpy(&length, m_buffer + sbePosition(), sizeof(%4$s));\n" +
             indent + "        return %3$s(length);\n" +
-            indent + "    }\n",
+            indent + "    }\n\n" +
+
+            indent + "#if __cplusplus >= 201103L\n" +
+            indent + "    SBE_NODISCARD %4$s %1$sLength(std::error_code &ec) const SBE_NOEXCEPT\n" +
+            indent + "    {\n" +
+            "%2$s" +
+            "%6$s" +
+            indent + "        %4$s length;\n" +
+            indent + "        std::memcpy(&length, m_buffer + sbePosition(), sizeof(%4$s));\n" +
+            indent + "        return %3$s(length);\n" +
+            indent + "    }\n" +
+            indent + "#endif\n",
             toLowerFirstChar(propertyName),
             generateArrayFieldNotPresentCondition(token.version(), BASE_INDENT),
             formatByteOrderEncoding(lengthToken.encoding().byteOrder(), lengthToken.encoding().primitiveType()),
-            lengthCppType);
+            lengthCppType,
+            generateDecodeCheck(
+                indent,
+                "(sbePosition() + " + sizeOfLengthField + ") > m_bufferLength",
+                "sbe_throw_errnum(E100, \"buffer too short [E100]\");",
+                "return 0;"),
+            generateDecodeCheck(
+                indent,
+                "(sbePosition() + " + sizeOfLengthField + ") > m_bufferLength",
+                "sbe_set_error(ec, E100);",
+                "return 0;"));
     }
 
     private void generateChoiceSet(final StringBuilder out, final List<Token> tokens)
@@ -768,6 +1335,7 @@ public class CppGenerator implements CodeGenerator
 
             out.append(generateChoices(bitSetName, tokens.get(0), tokens.subList(1, tokens.size() - 1)));
             out.append(generateChoicesDisplay(bitSetName, tokens.subList(1, tokens.size() - 1)));
+            out.append(generateChoicesAppendJson(tokens.subList(1, tokens.size() - 1)));
             out.append("};\n\n");
         }
     }
@@ -786,6 +1354,8 @@ public class CppGenerator implements CodeGenerator
 
             out.append(generateEnumDisplay(tokens.subList(1, tokens.size() - 1), enumToken));
 
+            out.append(generateEnumAppendJson(tokens.subList(1, tokens.size() - 1), enumToken));
+
             out.append("};\n\n");
         }
     }
@@ -803,6 +1373,9 @@ public class CppGenerator implements CodeGenerator
             out.append(generateCompositeDisplay(
                 tokens.get(0).applicableTypeName(), tokens.subList(1, tokens.size() - 1)));
 
+            out.append(generateCompositeAppendJson(
+                tokens.get(0).applicableTypeName(), tokens.subList(1, tokens.size() - 1)));
+
             out.append("};\n\n");
         }
     }
@@ -996,7 +1569,7 @@ public class CppGenerator implements CodeGenerator
     private CharSequence generateFieldNotPresentCondition(
         final int sinceVersion, final Encoding encoding, final String indent)
     {
-        if (0 == sinceVersion)
+        if (0 == sinceVersion || isVersionPinned)
         {
             return "";
         }
@@ -1010,9 +1583,9 @@ public class CppGenerator implements CodeGenerator
             generateLiteral(encoding.primitiveType(), encoding.applicableNullValue().toString()));
     }
 
-    private static CharSequence generateArrayFieldNotPresentCondition(final int sinceVersion, final String indent)
+    private CharSequence generateArrayFieldNotPresentCondition(final int sinceVersion, final String indent)
     {
-        if (0 == sinceVersion)
+        if (0 == sinceVersion || isVersionPinned)
         {
             return "";
         }
@@ -1025,9 +1598,9 @@ public class CppGenerator implements CodeGenerator
             sinceVersion);
     }
 
-    private static CharSequence generateStringNotPresentCondition(final int sinceVersion, final String indent)
+    private CharSequence generateStringNotPresentCondition(final int sinceVersion, final String indent)
     {
-        if (0 == sinceVersion)
+        if (0 == sinceVersion || isVersionPinned)
         {
             return "";
         }
@@ -1040,9 +1613,9 @@ public class CppGenerator implements CodeGenerator
             sinceVersion);
     }
 
-    private static CharSequence generateStringViewNotPresentCondition(final int sinceVersion, final String indent)
+    private CharSequence generateStringViewNotPresentCondition(final int sinceVersion, final String indent)
     {
-        if (0 == sinceVersion)
+        if (0 == sinceVersion || isVersionPinned)
         {
             return "";
         }
@@ -1055,9 +1628,9 @@ public class CppGenerator implements CodeGenerator
             sinceVersion);
     }
 
-    private static CharSequence generateTypeFieldNotPresentCondition(final int sinceVersion, final String indent)
+    private CharSequence generateTypeFieldNotPresentCondition(final int sinceVersion, final String indent)
     {
-        if (0 == sinceVersion)
+        if (0 == sinceVersion || isVersionPinned)
         {
             return "";
         }
@@ -1745,15 +2318,18 @@ public class CppGenerator implements CodeGenerator
             "        const std::uint64_t bufferLength,\n" +
             "        const std::uint64_t actingVersion)\n" +
             "    {\n" +
-            "        m_buffer = buffer;\n" +
-            "        m_bufferLength = bufferLength;\n" +
-            "        m_offset = offset;\n" +
             "        m_actingVersion = actingVersion;\n" +
-            "        if (SBE_BOUNDS_CHECK_EXPECT(((m_offset + %7$s) > m_bufferLength), false))\n" +
+            "        if (SBE_BOUNDS_CHECK_EXPECT(((offset + %7$s) > bufferLength), false))\n" +
             "        {\n" +
+            "            m_buffer = nullptr;\n" +
+            "            m_bufferLength = 0;\n" +
+            "            m_offset = 0;\n" +
             "            sbe_throw_errnum(E107, \"buffer too short for flyweight [E107]\");\n" +
             "            return ;\n" +
             "        }\n" +
+            "        m_buffer = buffer;\n" +
+            "        m_bufferLength = bufferLength;\n" +
+            "        m_offset = offset;\n" +
             "    }\n\n" +
 
             "    %1$s(\n" +
@@ -1847,6 +2423,7 @@ public class CppGenerator implements CodeGenerator
             "        m_buffer = buffer;\n" +
             "        m_bufferLength = bufferLength;\n" +
             "        m_offset = offset;\n" +
+            "        m_actingBlockLength = actingBlockLength;\n" +
             "        m_position = sbeCheckPosition(offset + actingBlockLength);\n" +
             "        m_actingVersion = actingVersion;\n" +
             "    }\n\n" +
@@ -1878,20 +2455,86 @@ public class CppGenerator implements CodeGenerator
             className);
     }
 
-    private CharSequence generateMessageFlyweightCode(final String className, final Token token)
+    private CharSequence generateMessageFlyweightCode(final MessageItem messageItem)
     {
+        final String className = messageItemClassName(messageItem);
+        final Token token = messageItem.rootToken;
         final String blockLengthType = cppTypeName(ir.headerStructure().blockLengthType());
         final String templateIdType = cppTypeName(ir.headerStructure().templateIdType());
         final String schemaIdType = cppTypeName(ir.headerStructure().schemaIdType());
         final String schemaVersionType = cppTypeName(ir.headerStructure().schemaVersionType());
         final String semanticType = token.encoding().semanticType() == null ? "" : token.encoding().semanticType();
         final String headerType = ir.headerStructure().tokens().get(0).name();
+        final CharSequence constructors = generateConstructorsAndOperators(className);
+        final String wrapMethods = String.format(
+            "    %1$s &wrapForEncode(char *buffer, const std::uint64_t offset, const std::uint64_t bufferLength)\n" +
+            "    {\n" +
+            "        return *this = %1$s(buffer, offset, bufferLength, sbeBlockLength(), sbeSchemaVersion());\n" +
+            "    }\n\n" +
+
+            "    %1$s &wrapAndApplyHeader(" +
+            "char *buffer, const std::uint64_t offset, const std::uint64_t bufferLength)\n" +
+            "    {\n" +
+            "        messageHeader hdr(buffer, offset, bufferLength, sbeSchemaVersion());\n\n" +
+
+            "        hdr\n" +
+            "            .blockLength(sbeBlockLength())\n" +
+            "            .templateId(sbeTemplateId())\n" +
+            "            .schemaId(sbeSchemaId())\n" +
+            "            .version(sbeSchemaVersion());\n\n" +
+
+            "        return *this = %1$s(\n" +
+            "            buffer,\n" +
+            "            offset + messageHeader::encodedLength(),\n" +
+            "            bufferLength,\n" +
+            "            sbeBlockLength(),\n" +
+            "            sbeSchemaVersion());\n" +
+            "    }\n\n" +
 
+            "    %1$s &wrapForDecode(\n" +
+            "        char *buffer,\n" +
+            "        const std::uint64_t offset,\n" +
+            "        const std::uint64_t actingBlockLength,\n" +
+            "        const std::uint64_t actingVersion,\n" +
+            "        const std::uint64_t bufferLength)\n" +
+            "    {\n" +
+            "        return *this = %1$s(buffer, offset, bufferLength, actingBlockLength, actingVersion);\n" +
+            "    }\n\n" +
+
+            "#if __cplusplus >= 201103L\n" +
+            "    %1$s &wrapForDecode(\n" +
+            "        char *buffer,\n" +
+            "        const std::uint64_t offset,\n" +
+            "        const std::uint64_t actingBlockLength,\n" +
+            "        const std::uint64_t actingVersion,\n" +
+            "        const std::uint64_t bufferLength,\n" +
+            "        std::error_code &ec) SBE_NOEXCEPT\n" +
+            "    {\n" +
+            "        m_buffer = buffer;\n" +
+            "        m_bufferLength = bufferLength;\n" +
+            "        m_offset = offset;\n" +
+            "        m_actingBlockLength = actingBlockLength;\n" +
+            "        m_position = offset + actingBlockLength;\n" +
+            "        m_actingVersion = actingVersion;\n" +
+            "%2$s\n" +
+            "        return *this;\n" +
+            "    }\n" +
+            "#endif\n\n",
+            className,
+            generateDecodeCheck(
+                BASE_INDENT,
+                "m_position > bufferLength",
+                "m_buffer = nullptr;",
+                "m_bufferLength = 0;",
+                "sbe_set_error(ec, E100);"));
+
+        // The validated view is only obtained from validate, so its constructors and wrap methods are private
         return String.format(
             "private:\n" +
             "    char *m_buffer;\n" +
             "    std::uint64_t m_bufferLength;\n" +
             "    std::uint64_t m_offset;\n" +
+            "    std::uint64_t m_actingBlockLength;\n" +
             "    std::uint64_t m_position;\n" +
             "    std::uint64_t m_actingVersion;\n\n" +
 
@@ -1900,6 +2543,7 @@ public class CppGenerator implements CodeGenerator
             "        return &m_position;\n" +
             "    }\n\n" +
 
+            "%15$s" +
             "public:\n" +
             "    typedef %12$s messageHeader;\n\n" +
 
@@ -1939,39 +2583,7 @@ public class CppGenerator implements CodeGenerator
             "        return m_offset;\n" +
             "    }\n\n" +
 
-            "    %10$s &wrapForEncode(char *buffer, const std::uint64_t offset, const std::uint64_t bufferLength)\n" +
-            "    {\n" +
-            "        return *this = %10$s(buffer, offset, bufferLength, sbeBlockLength(), sbeSchemaVersion());\n" +
-            "    }\n\n" +
-
-            "    %10$s &wrapAndApplyHeader(" +
-            "char *buffer, const std::uint64_t offset, const std::uint64_t bufferLength)\n" +
-            "    {\n" +
-            "        messageHeader hdr(buffer, offset, bufferLength, sbeSchemaVersion());\n\n" +
-
-            "        hdr\n" +
-            "            .blockLength(sbeBlockLength())\n" +
-            "            .templateId(sbeTemplateId())\n" +
-            "            .schemaId(sbeSchemaId())\n" +
-            "            .version(sbeSchemaVersion());\n\n" +
-
-            "        return *this = %10$s(\n" +
-            "            buffer,\n" +
-            "            offset + messageHeader::encodedLength(),\n" +
-            "            bufferLength,\n" +
-            "            sbeBlockLength(),\n" +
-            "            sbeSchemaVersion());\n" +
-            "    }\n\n" +
-
-            "    %10$s &wrapForDecode(\n" +
-            "        char *buffer,\n" +
-            "        const std::uint64_t offset,\n" +
-            "        const std::uint64_t actingBlockLength,\n" +
-            "        const std::uint64_t actingVersion,\n" +
-            "        const std::uint64_t bufferLength)\n" +
-            "    {\n" +
-            "        return *this = %10$s(buffer, offset, bufferLength, actingBlockLength, actingVersion);\n" +
-            "    }\n\n" +
+            "%14$s" +
 
             "    SBE_NODISCARD std::uint64_t sbePosition() const SBE_NOEXCEPT\n" +
             "    {\n" +
@@ -1983,6 +2595,8 @@ public class CppGenerator implements CodeGenerator
             "    {\n" +
             "        if (SBE_BOUNDS_CHECK_EXPECT((position > m_bufferLength), false))\n" +
             "        {\n" +
+            "            m_buffer = nullptr;\n" +
+            "            m_bufferLength = 0;\n" +
             "            sbe_throw_errnum(E100, \"buffer too short [E100]\");\n" +
             "            return UINT64_MAX;\n" +
             "        }\n" +
@@ -1999,13 +2613,7 @@ public class CppGenerator implements CodeGenerator
             "        return sbePosition() - m_offset;\n" +
             "    }\n\n" +
 
-            "    SBE_NODISCARD std::uint64_t decodeLength() const\n" +
-            "    {\n" +
-            "        %10$s skipper(m_buffer, m_offset,\n" +
-            "            m_bufferLength, sbeBlockLength(), m_actingVersion);\n" +
-            "        skipper.skip();\n" +
-            "        return skipper.encodedLength();\n" +
-            "    }\n\n" +
+            "%13$s" +
 
             "    SBE_NODISCARD const char * buffer() const SBE_NOEXCEPT\n" +
             "    {\n" +
@@ -2036,457 +2644,1911 @@ public class CppGenerator implements CodeGenerator
             generateLiteral(ir.headerStructure().schemaVersionType(), Integer.toString(ir.version())),
             semanticType,
             className,
-            generateConstructorsAndOperators(className),
-            formatClassName(headerType));
+            isValidatedView ? "" : constructors,
+            formatClassName(headerType),
+            generateDecodeLength(messageItem),
+            isValidatedView ? "" : wrapMethods,
+            isValidatedView ? constructors + wrapMethods : "");
     }
 
-    private void generateFields(
-        final StringBuilder sb,
-        final String containingClassName,
-        final List<Token> tokens,
-        final String indent)
+    private static int indexWidth(final MessageItem messageItem)
     {
-        for (int i = 0, size = tokens.size(); i < size; i++)
+        final List<Token> tokens = messageItem.varData;
+        int varDataCount = 0;
+        for (int i = 0, size = tokens.size(); i < size; i += tokens.get(i).componentTokenCount())
         {
-            final Token signalToken = tokens.get(i);
-            if (signalToken.signal() == Signal.BEGIN_FIELD)
-            {
-                final Token encodingToken = tokens.get(i + 1);
-                final String propertyName = formatPropertyName(signalToken.name());
+            varDataCount++;
+        }
 
-                generateFieldMetaAttributeMethod(sb, signalToken, indent);
-                generateFieldCommonMethods(indent, sb, signalToken, encodingToken, propertyName);
+        return 2 + (2 * messageItem.children.size()) + varDataCount;
+    }
 
-                switch (encodingToken.signal())
-                {
-                    case ENCODING:
-                        generatePrimitiveProperty(
-                            sb, containingClassName, propertyName, signalToken, encodingToken, indent);
-                        break;
+    /*
+     * The index has a record per message and group element, laid out as described for sbe_offset_index. The records of
+     * the elements of a group are contiguous so the record of any element is found from the first. Groups of the
+     * validated view have no wrapIndexed, as a view is only obtained from validate.
+     */
+    private void generateOffsetIndex(final StringBuilder sb, final MessageItem messageItem, final String indent)
+    {
+        final boolean isGroup = messageItem.rootToken.signal() == Signal.BEGIN_GROUP;
+        final String recordParam = isGroup ? ", const std::uint64_t record" : "";
+        final String recordOffset = isGroup ? "record + " : "";
+        final int width = indexWidth(messageItem);
 
-                    case BEGIN_ENUM:
-                        generateEnumProperty(sb, containingClassName, signalToken, propertyName, encodingToken, indent);
-                        break;
+        new Formatter(sb).format("\n" +
+            indent + "    SBE_NODISCARD static SBE_CONSTEXPR std::uint64_t sbeIndexWidth() SBE_NOEXCEPT\n" +
+            indent + "    {\n" +
+            indent + "        return %1$d;\n" +
+            indent + "    }\n",
+            width);
 
-                    case BEGIN_SET:
-                        generateBitsetProperty(sb, propertyName, encodingToken, indent);
-                        break;
+        if (!messageItem.isConst())
+        {
+            new Formatter(sb).format("\n" +
+                indent + "    static std::uint64_t sbeIndexGroupsAndData(\n" +
+                indent + "        const char *buffer,\n" +
+                indent + "        std::uint64_t position,\n" +
+                indent + "        const std::uint64_t bufferLength,\n" +
+                indent + "        const std::uint64_t actingVersion,\n" +
+                indent + "        std::uint64_t *offsets,\n" +
+                indent + "        const std::uint64_t capacity,\n" +
+                indent + "        std::uint64_t &length,\n" +
+                indent + "        const std::uint64_t record)\n" +
+                indent + "    {\n" +
+                "%1$s" +
+                indent + "        return position;\n" +
+                indent + "    }\n",
+                generateGroupsAndDataIndexing(messageItem, indent));
+        }
 
-                    case BEGIN_COMPOSITE:
-                        generateCompositeProperty(sb, propertyName, encodingToken, indent);
-                        break;
+        for (int i = 0, size = messageItem.children.size(); i < size; i++)
+        {
+            final MessageItem child = messageItem.children.get(i);
 
-                    default:
-                        break;
-                }
-            }
+            new Formatter(sb).format("\n" +
+                indent + "    template<std::size_t Capacity>\n" +
+                indent + "    SBE_NODISCARD static std::uint64_t %1$sIndexedCount(\n" +
+                indent + "        const sbe_offset_index<Capacity> &index%2$s) SBE_NOEXCEPT\n" +
+                indent + "    {\n" +
+                indent + "        return index.offsets[%3$s%4$d];\n" +
+                indent + "    }\n\n" +
+
+                indent + "    template<std::size_t Capacity>\n" +
+                indent + "    SBE_NODISCARD static std::uint64_t %1$sIndexedRecord(\n" +
+                indent + "        const sbe_offset_index<Capacity> &index%2$s, const std::uint64_t element)\n" +
+                indent + "    {\n" +
+                indent + "        if (SBE_BOUNDS_CHECK_EXPECT((element >= index.offsets[%3$s%4$d]), false))\n" +
+                indent + "        {\n" +
+                indent + "            sbe_throw_errnum(E108, \"index >= count [E108]\");\n" +
+                indent + "            return UINT64_MAX;\n" +
+                indent + "        }\n" +
+                indent + "        return index.offsets[%3$s%5$d] + (element * %6$s::sbeIndexWidth());\n" +
+                indent + "    }\n",
+                formatPropertyName(child.rootToken.name()),
+                recordParam,
+                recordOffset,
+                2 + (2 * i),
+                3 + (2 * i),
+                messageItemFullClassName(child));
+        }
+
+        final List<Token> tokens = messageItem.varData;
+        for (int i = 0, slot = 2 + (2 * messageItem.children.size()), size = tokens.size(); i < size; slot++)
+        {
+            final Token token = tokens.get(i);
+            final Token lengthToken = Generators.findFirst("length", tokens, i);
+            final Encoding lengthEncoding = lengthToken.encoding();
+            final boolean isOptional = token.version() > 0;
+
+            new Formatter(sb).format("\n" +
+                indent + "    template<std::size_t Capacity>\n" +
+                indent + "    SBE_NODISCARD std::uint64_t %1$sIndexedLength(\n" +
+                indent + "        const sbe_offset_index<Capacity> &index%2$s) const SBE_NOEXCEPT\n" +
+                indent + "    {\n" +
+                indent + "        const std::uint64_t position = index.offsets[%3$s%4$d];\n" +
+                "%5$s" +
+                indent + "        %6$s lengthFieldValue;\n" +
+                indent + "        std::memcpy(&lengthFieldValue, m_buffer + position, sizeof(%6$s));\n" +
+                indent + "        return %7$s(lengthFieldValue);\n" +
+                indent + "    }\n\n" +
+
+                indent + "    template<std::size_t Capacity>\n" +
+                indent + "    SBE_NODISCARD const char *%1$sIndexed(\n" +
+                indent + "        const sbe_offset_index<Capacity> &index%2$s) const SBE_NOEXCEPT\n" +
+                indent + "    {\n" +
+                indent + "        const std::uint64_t position = index.offsets[%3$s%4$d];\n" +
+                indent + "        return %8$sm_buffer + position + %9$d;\n" +
+                indent + "    }\n",
+                formatPropertyName(token.name()),
+                recordParam,
+                recordOffset,
+                slot,
+                isOptional ?
+                    indent + "        if (UINT64_MAX == position)\n" +
+                    indent + "        {\n" +
+                    indent + "            return 0;\n" +
+                    indent + "        }\n" : "",
+                cppTypeName(lengthEncoding.primitiveType()),
+                formatByteOrderEncoding(lengthEncoding.byteOrder(), lengthEncoding.primitiveType()),
+                isOptional ? "UINT64_MAX == position ? nullptr : " : "",
+                lengthToken.encodedLength());
+
+            i += token.componentTokenCount();
+        }
+
+        if (isGroup)
+        {
+            generateGroupIndexing(sb, messageItem, width, indent);
+        }
+        else
+        {
+            new Formatter(sb).format("\n" +
+                indent + "    /*\n" +
+                indent + "     * Record the offsets of all group elements and var data in one pass, after which the\n" +
+                indent + "     * indexed accessors read them in any order without moving the position.\n" +
+                indent + "     */\n" +
+                indent + "    template<std::size_t Capacity>\n" +
+                indent + "    void buildIndex(sbe_offset_index<Capacity> &index) const\n" +
+                indent + "    {\n" +
+                indent + "        index.length = 0;\n" +
+                indent + "        if (Capacity < sbeIndexWidth())\n" +
+                indent + "        {\n" +
+                indent + "            sbe_throw_errnum(E112, \"offset index capacity exceeded [E112]\");\n" +
+                indent + "            return;\n" +
+                indent + "        }\n\n" +
+                indent + "        std::uint64_t length = sbeIndexWidth();\n" +
+                indent + "        index.offsets[0] = m_offset;\n" +
+                indent + "        index.offsets[1] = m_actingBlockLength;\n" +
+                "%1$s" +
+                indent + "        index.length = length;\n" +
+                indent + "    }\n",
+                messageItem.isConst() ? "" :
+                indent + "        if (UINT64_MAX == sbeIndexGroupsAndData(\n" +
+                indent + "            m_buffer, m_offset + m_actingBlockLength, m_bufferLength, m_actingVersion,\n" +
+                indent + "            index.offsets, Capacity, length, 0))\n" +
+                indent + "        {\n" +
+                indent + "            return;\n" +
+                indent + "        }\n");
         }
     }
 
-    private void generateFieldCommonMethods(
-        final String indent,
-        final StringBuilder sb,
-        final Token fieldToken,
-        final Token encodingToken,
-        final String propertyName)
+    private static void generateGroupIndexing(
+        final StringBuilder sb, final MessageItem messageItem, final int width, final String indent)
     {
-        new Formatter(sb).format("\n" +
-            indent + "    static SBE_CONSTEXPR std::uint16_t %1$sId() SBE_NOEXCEPT\n" +
-            indent + "    {\n" +
-            indent + "        return %2$s;\n" +
-            indent + "    }\n",
-            propertyName,
-            generateLiteral(ir.headerStructure().templateIdType(), "" + fieldToken.id())
-        );
+        final String elementIndexing = messageItem.isConst() ?
+            indent + "            position += blockLength;\n" :
+            indent + "            position = sbeIndexGroupsAndData(\n" +
+            indent + "                buffer, position + blockLength, bufferLength, actingVersion,\n" +
+            indent + "                offsets, capacity, length, element);\n" +
+            indent + "            if (UINT64_MAX == position)\n" +
+            indent + "            {\n" +
+            indent + "                return UINT64_MAX;\n" +
+            indent + "            }\n";
 
         new Formatter(sb).format("\n" +
-            indent + "    SBE_NODISCARD static SBE_CONSTEXPR std::uint64_t %1$sSinceVersion() SBE_NOEXCEPT\n" +
-            indent + "    {\n" +
-            indent + "        return %2$d;\n" +
-            indent + "    }\n\n" +
-
-            indent + "    SBE_NODISCARD bool %1$sInActingVersion() SBE_NOEXCEPT\n" +
+            indent + "    static std::uint64_t sbeIndexPosition(\n" +
+            indent + "        const char *buffer,\n" +
+            indent + "        std::uint64_t position,\n" +
+            indent + "        const std::uint64_t bufferLength,\n" +
+            indent + "        const std::uint64_t actingVersion,\n" +
+            indent + "        std::uint64_t *offsets,\n" +
+            indent + "        const std::uint64_t capacity,\n" +
+            indent + "        std::uint64_t &length,\n" +
+            indent + "        const std::uint64_t slot)\n" +
             indent + "    {\n" +
-            indent + "        return m_actingVersion >= %1$sSinceVersion();\n" +
+            indent + "        if (SBE_BOUNDS_CHECK_EXPECT(((position + %2$d) > bufferLength), false))\n" +
+            indent + "        {\n" +
+            indent + "            sbe_throw_errnum(E108, \"buffer too short for repeating group [E108]\");\n" +
+            indent + "            return UINT64_MAX;\n" +
+            indent + "        }\n\n" +
+            indent + "        const %3$s dimensions(\n" +
+            indent + "            const_cast<char *>(buffer), position, bufferLength, actingVersion);\n" +
+            indent + "        const std::uint64_t blockLength = dimensions.blockLength();\n" +
+            indent + "        const std::uint64_t count = dimensions.numInGroup();\n" +
+            indent + "        if ((count * %4$d) > (capacity - length))\n" +
+            indent + "        {\n" +
+            indent + "            sbe_throw_errnum(E112, \"offset index capacity exceeded [E112]\");\n" +
+            indent + "            return UINT64_MAX;\n" +
+            indent + "        }\n\n" +
+            indent + "        const std::uint64_t firstRecord = length;\n" +
+            indent + "        offsets[slot] = count;\n" +
+            indent + "        offsets[slot + 1] = firstRecord;\n" +
+            indent + "        length += count * %4$d;\n" +
+            indent + "        position += %2$d;\n" +
+            indent + "        for (std::uint64_t i = 0; i < count; i++)\n" +
+            indent + "        {\n" +
+            indent + "            const std::uint64_t element = firstRecord + (i * %4$d);\n" +
+            indent + "            if (SBE_BOUNDS_CHECK_EXPECT(((position + blockLength) > bufferLength), false))\n" +
+            indent + "            {\n" +
+            indent + "                sbe_throw_errnum(E108, \"buffer too short for next group index [E108]\");\n" +
+            indent + "                return UINT64_MAX;\n" +
+            indent + "            }\n" +
+            indent + "            offsets[element] = position;\n" +
+            indent + "            offsets[element + 1] = blockLength;\n" +
+            "%5$s" +
+            indent + "        }\n\n" +
+            indent + "        return position;\n" +
             indent + "    }\n",
-            propertyName,
-            fieldToken.version());
+            messageItemClassName(messageItem),
+            messageItem.tokens.get(1).encodedLength(),
+            formatClassName(messageItem.tokens.get(1).name()),
+            width,
+            elementIndexing);
+
+        if (isValidatedView)
+        {
+            return;
+        }
 
         new Formatter(sb).format("\n" +
-            indent + "    SBE_NODISCARD static SBE_CONSTEXPR std::uint64_t %1$sEncodedOffset() SBE_NOEXCEPT\n" +
+            indent + "    /*\n" +
+            indent + "     * Wrap the element of the given record alone, so hasNext() is false. Its groups and var\n" +
+            indent + "     * data are read with the indexed accessors given the same record, or in order from its\n" +
+            indent + "     * own position which starts past its block.\n" +
+            indent + "     */\n" +
+            indent + "    template<std::size_t Capacity>\n" +
+            indent + "    %1$s &wrapIndexed(\n" +
+            indent + "        char *buffer,\n" +
+            indent + "        const sbe_offset_index<Capacity> &index,\n" +
+            indent + "        const std::uint64_t record,\n" +
+            indent + "        const std::uint64_t actingVersion,\n" +
+            indent + "        const std::uint64_t bufferLength)\n" +
             indent + "    {\n" +
-            indent + "        return %2$s;\n" +
+            indent + "        m_buffer = buffer;\n" +
+            indent + "        m_bufferLength = bufferLength;\n" +
+            indent + "        m_offset = index.offsets[record];\n" +
+            indent + "        m_blockLength = index.offsets[record + 1];\n" +
+            indent + "        m_count = 0;\n" +
+            indent + "        m_index = 0;\n" +
+            indent + "        m_actingVersion = actingVersion;\n" +
+            indent + "        m_initialPosition = m_offset;\n" +
+            indent + "        m_elementPosition = m_offset + m_blockLength;\n" +
+            indent + "        m_positionPtr = &m_elementPosition;\n" +
+            indent + "        return *this;\n" +
             indent + "    }\n",
-            propertyName,
-            generateEncodedLengthLiteral(encodingToken.offset()));
+            messageItemClassName(messageItem));
     }
 
-    private static void generateFieldMetaAttributeMethod(
-        final StringBuilder sb, final Token token, final String indent)
+    private static String generateGroupsAndDataIndexing(final MessageItem messageItem, final String indent)
     {
-        final Encoding encoding = token.encoding();
-        final String epoch = encoding.epoch() == null ? "" : encoding.epoch();
-        final String timeUnit = encoding.timeUnit() == null ? "" : encoding.timeUnit();
-        final String semanticType = encoding.semanticType() == null ? "" : encoding.semanticType();
-
-        sb.append("\n")
-            .append(indent).append("    SBE_NODISCARD static const char * ")
-            .append(token.name()).append("MetaAttribute(const sbe_meta_attribute metaAttribute) SBE_NOEXCEPT\n")
-            .append(indent).append("    {\n")
-            .append(indent).append("        switch (metaAttribute)\n")
-            .append(indent).append("        {\n");
+        final StringBuilder sb = new StringBuilder();
 
-        if (!Strings.isEmpty(epoch))
+        for (int i = 0, size = messageItem.children.size(); i < size; i++)
         {
-            sb.append(indent)
-                .append("            case sbe_meta_attribute_EPOCH: return \"").append(epoch).append("\";\n");
+            final MessageItem child = messageItem.children.get(i);
+            sb.append(indent).append("        position = ").append(messageItemFullClassName(child))
+                .append("::sbeIndexPosition(\n")
+                .append(indent).append("            buffer, position, bufferLength, actingVersion, offsets, capacity, ")
+                .append("length, record + ").append(2 + (2 * i)).append(");\n")
+                .append(indent).append("        if (UINT64_MAX == position)\n")
+                .append(indent).append("        {\n")
+                .append(indent).append("            return UINT64_MAX;\n")
+                .append(indent).append("        }\n\n");
         }
 
-        if (!Strings.isEmpty(timeUnit))
+        final List<Token> tokens = messageItem.varData;
+        for (int i = 0, slot = 2 + (2 * messageItem.children.size()), size = tokens.size(); i < size; slot++)
         {
-            sb.append(indent)
-                .append("            case sbe_meta_attribute_TIME_UNIT: return \"").append(timeUnit).append("\";\n");
-        }
+            final Token token = tokens.get(i);
+            final Token lengthToken = Generators.findFirst("length", tokens, i);
+            final Encoding lengthEncoding = lengthToken.encoding();
 
-        if (!Strings.isEmpty(semanticType))
-        {
-            sb.append(indent)
-                .append("            case sbe_meta_attribute_SEMANTIC_TYPE: return \"").append(semanticType)
-                .append("\";\n");
-        }
-
-        sb
-            .append(indent).append("            case sbe_meta_attribute_PRESENCE: return \"")
-            .append(encoding.presence().toString().toLowerCase()).append("\";\n")
-            .append(indent).append("            default: return \"\";\n")
-            .append(indent).append("        }\n")
-            .append(indent).append("    }\n");
-    }
+            new Formatter(sb).format(
+                indent + "        %1$s\n" +
+                indent + "        {\n" +
+                indent + "            if (SBE_BOUNDS_CHECK_EXPECT(((position + %2$d) > bufferLength), false))\n" +
+                indent + "            {\n" +
+                indent + "                sbe_throw_errnum(E100, \"buffer too short [E100]\");\n" +
+                indent + "                return UINT64_MAX;\n" +
+                indent + "            }\n" +
+                indent + "            %3$s lengthValue;\n" +
+                indent + "            std::memcpy(&lengthValue, buffer + position, sizeof(lengthValue));\n" +
+                indent + "            offsets[record + %4$d] = position;\n" +
+                indent + "            position += %2$d + static_cast<std::uint64_t>(%5$s(lengthValue));\n" +
+                indent + "            if (SBE_BOUNDS_CHECK_EXPECT((position > bufferLength), false))\n" +
+                indent + "            {\n" +
+                indent + "                sbe_throw_errnum(E100, \"buffer too short [E100]\");\n" +
+                indent + "                return UINT64_MAX;\n" +
+                indent + "            }\n" +
+                indent + "        }\n" +
+                "%6$s\n",
+                0 == token.version() ? "// " + token.name() : "if (actingVersion >= " + token.version() + ")",
+                lengthToken.encodedLength(),
+                cppTypeName(lengthEncoding.primitiveType()),
+                slot,
+                formatByteOrderEncoding(lengthEncoding.byteOrder(), lengthEncoding.primitiveType()),
+                0 == token.version() ? "" :
+                indent + "        else\n" +
+                indent + "        {\n" +
+                indent + "            offsets[record + " + slot + "] = UINT64_MAX;\n" +
+                indent + "        }\n");
 
-    private static CharSequence generateEnumFieldNotPresentCondition(
-        final int sinceVersion,
-        final String enumName,
-        final String indent)
-    {
-        if (0 == sinceVersion)
-        {
-            return "";
+            i += token.componentTokenCount();
         }
 
-        return String.format(
-            indent + "        if (m_actingVersion < %1$d)\n" +
-            indent + "        {\n" +
-            indent + "            return %2$s::NULL_VALUE;\n" +
-            indent + "        }\n\n",
-            sinceVersion,
-            enumName);
+        return sb.toString();
     }
 
-    private void generateEnumProperty(
-        final StringBuilder sb,
-        final String containingClassName,
-        final Token fieldToken,
-        final String propertyName,
-        final Token token,
-        final String indent)
+    /*
+     * In the validated namespace each message is generated again without the bounds checks of its decode paths, plus a
+     * static validate which walks the message once, checking block lengths, group dimensions, var data lengths, enum
+     * values and explicit min/max ranges against the buffer, and returns the unchecked view only when all of them hold.
+     */
+    private void generateValidation(final StringBuilder sb, final MessageItem messageItem, final String indent)
     {
-        final String enumName = formatClassName(token.applicableTypeName());
-        final String typeName = cppTypeName(token.encoding().primitiveType());
-        final int offset = token.offset();
-
-        new Formatter(sb).format("\n" +
-            indent + "    SBE_NODISCARD static SBE_CONSTEXPR std::uint64_t %1$sEncodedLength() SBE_NOEXCEPT\n" +
-            indent + "    {\n" +
-            indent + "        return %2$s;\n" +
-            indent + "    }\n",
-            propertyName,
-            generateEncodedLengthLiteral(fieldToken.encodedLength()));
+        final String className = messageItemClassName(messageItem);
+        final StringBuilder sbChecks = new StringBuilder();
+        final boolean hasBlockChecks = generateBlockChecks(sbChecks, messageItem.fields, indent);
+        final String minBlockLength = generateMinBlockLength(messageItem.fields);
 
-        if (fieldToken.isConstantEncoding())
+        if (hasBlockChecks)
         {
-            final String constValue = fieldToken.encoding().constValue().toString();
-
             new Formatter(sb).format("\n" +
-                indent + "    SBE_NODISCARD static SBE_CONSTEXPR %1$s::Value %2$sConstValue() SBE_NOEXCEPT\n" +
+                indent + "    static int sbeValidateBlocks(\n" +
+                indent + "        const char *block,\n" +
+                indent + "        const std::uint64_t count,\n" +
+                indent + "        const std::uint64_t blockLength,\n" +
+                indent + "        const std::uint64_t actingVersion) SBE_NOEXCEPT\n" +
                 indent + "    {\n" +
-                indent + "        return %1$s::%3$s;\n" +
+                indent + "        int enumsValid = 1;\n" +
+                indent + "        int rangesValid = 1;\n" +
+                indent + "        for (std::uint64_t i = 0; i < count; i++)\n" +
+                indent + "        {\n" +
+                indent + "            const char *element = block + (i * blockLength);\n" +
+                "%1$s" +
+                indent + "        }\n\n" +
+                indent + "        return !enumsValid ? E103 : (!rangesValid ? E111 : 0);\n" +
                 indent + "    }\n",
-                enumName,
-                propertyName,
-                constValue.substring(constValue.indexOf(".") + 1));
+                sbChecks);
+        }
 
+        final String blockCheck = hasBlockChecks ?
+            "sbeValidateBlocks(buffer + %1$s, %2$s, %3$s, actingVersion)" : null;
+
+        if (!messageItem.isConst())
+        {
             new Formatter(sb).format("\n" +
-                indent + "    SBE_NODISCARD %1$s::Value %2$s() const SBE_NOEXCEPT\n" +
+                indent + "    static std::uint64_t sbeValidateGroupsAndData(\n" +
+                indent + "        const char *buffer,\n" +
+                indent + "        std::uint64_t position,\n" +
+                indent + "        const std::uint64_t bufferLength,\n" +
+                indent + "        const std::uint64_t actingVersion,\n" +
+                indent + "        int &errnum) SBE_NOEXCEPT\n" +
                 indent + "    {\n" +
-                "%3$s" +
-                indent + "        return %1$s::%4$s;\n" +
+                "%1$s" +
+                indent + "        return position;\n" +
                 indent + "    }\n",
-                enumName,
-                propertyName,
-                generateEnumFieldNotPresentCondition(fieldToken.version(), enumName, indent),
-                constValue.substring(constValue.indexOf(".") + 1));
+                generateGroupsAndDataValidation(messageItem, indent));
         }
-        else
+
+        if (messageItem.rootToken.signal() == Signal.BEGIN_GROUP)
         {
+            final Token numInGroupToken = Generators.findFirst("numInGroup", messageItem.tokens, 0);
+            final long minCount = numInGroupToken.encoding().applicableMinValue().longValue();
+            final long maxCount = numInGroupToken.encoding().applicableMaxValue().longValue();
+            final StringBuilder sbElements = new StringBuilder();
+
+            if (null != minBlockLength)
+            {
+                sbElements
+                    .append(indent).append("        if (blockLength < ").append(minBlockLength).append(")\n")
+                    .append(indent).append("        {\n")
+                    .append(indent).append("            errnum = E107;\n")
+                    .append(indent).append("            return position;\n")
+                    .append(indent).append("        }\n\n");
+            }
+
+            if (messageItem.isConst())
+            {
+                sbElements
+                    .append(indent).append("        if (count * blockLength > bufferLength - position)\n")
+                    .append(indent).append("        {\n")
+                    .append(indent).append("            errnum = E108;\n")
+                    .append(indent).append("            return position;\n")
+                    .append(indent).append("        }\n");
+
+                if (hasBlockChecks)
+                {
+                    sbElements.append(indent).append("        errnum = ")
+                        .append(String.format(blockCheck, "position", "count", "blockLength")).append(";\n");
+                }
+
+                sbElements.append(indent).append("        return position + (count * blockLength);\n");
+            }
+            else
+            {
+                sbElements
+                    .append(indent).append("        for (std::uint64_t i = 0; i < count && 0 == errnum; i++)\n")
+                    .append(indent).append("        {\n")
+                    .append(indent).append("            if (blockLength > bufferLength - position)\n")
+                    .append(indent).append("            {\n")
+                    .append(indent).append("                errnum = E108;\n")
+                    .append(indent).append("                return position;\n")
+                    .append(indent).append("            }\n");
+
+                if (hasBlockChecks)
+                {
+                    sbElements.append(indent).append("            errnum = ")
+                        .append(String.format(blockCheck, "position", "1", "blockLength")).append(";\n");
+                }
+
+                sbElements
+                    .append(indent).append("            position = sbeValidateGroupsAndData(\n")
+                    .append(indent).append("                buffer, position + blockLength, bufferLength, ")
+                    .append("actingVersion, errnum);\n")
+                    .append(indent).append("        }\n\n")
+                    .append(indent).append("        return position;\n");
+            }
+
             new Formatter(sb).format("\n" +
-                indent + "    SBE_NODISCARD %1$s::Value %2$s() const SBE_NOEXCEPT\n" +
+                indent + "    static std::uint64_t sbeValidatePosition(\n" +
+                indent + "        const char *buffer,\n" +
+                indent + "        std::uint64_t position,\n" +
+                indent + "        const std::uint64_t bufferLength,\n" +
+                indent + "        const std::uint64_t actingVersion,\n" +
+                indent + "        int &errnum) SBE_NOEXCEPT\n" +
                 indent + "    {\n" +
-                "%3$s" +
-                indent + "        %5$s val;\n" +
-                indent + "        std::memcpy(&val, m_buffer + m_offset + %6$d, sizeof(%5$s));\n" +
-                indent + "        return %1$s::get(%4$s(val));\n" +
+                indent + "        if (position > bufferLength || %1$d > bufferLength - position)\n" +
+                indent + "        {\n" +
+                indent + "            errnum = E108;\n" +
+                indent + "            return position;\n" +
+                indent + "        }\n\n" +
+                indent + "        %2$s dimensions(\n" +
+                indent + "            const_cast<char *>(buffer), position, bufferLength, actingVersion);\n" +
+                indent + "        const std::uint64_t blockLength = dimensions.blockLength();\n" +
+                indent + "        const std::uint64_t count = dimensions.numInGroup();\n" +
+                indent + "        position += %1$d;\n" +
+                indent + "        if (%3$scount > %4$s)\n" +
+                indent + "        {\n" +
+                indent + "            errnum = E110;\n" +
+                indent + "            return position;\n" +
+                indent + "        }\n\n" +
+                "%5$s" +
                 indent + "    }\n",
-                enumName,
-                propertyName,
-                generateEnumFieldNotPresentCondition(fieldToken.version(), enumName, indent),
-                formatByteOrderEncoding(token.encoding().byteOrder(), token.encoding().primitiveType()),
-                typeName,
-                offset);
+                messageItem.tokens.get(1).encodedLength(),
+                formatClassName(messageItem.tokens.get(1).name()),
+                minCount > 0 ? "count < " + minCount + " || " : "",
+                validationLiteral(PrimitiveType.UINT64, maxCount),
+                sbElements);
+        }
+        else
+        {
+            final StringBuilder sbMessage = new StringBuilder();
+
+            if (null != minBlockLength)
+            {
+                sbMessage
+                    .append(indent).append("        if (actingBlockLength < ").append(minBlockLength).append(")\n")
+                    .append(indent).append("        {\n")
+                    .append(indent).append("            errnum = E107;\n")
+                    .append(indent).append("            return ").append(className).append("();\n")
+                    .append(indent).append("        }\n\n");
+            }
+
+            if (hasBlockChecks)
+            {
+                sbMessage.append(indent).append("        errnum = ")
+                    .append(String.format(blockCheck, "offset", "1", "actingBlockLength")).append(";\n");
+            }
+
+            if (!messageItem.isConst())
+            {
+                sbMessage
+                    .append(indent).append("        if (0 == errnum)\n")
+                    .append(indent).append("        {\n")
+                    .append(indent).append("            sbeValidateGroupsAndData(\n")
+                    .append(indent).append("                buffer, offset + actingBlockLength, bufferLength, ")
+                    .append("actingVersion, errnum);\n")
+                    .append(indent).append("        }\n");
+            }
 
             new Formatter(sb).format("\n" +
-                indent + "    %1$s &%2$s(const %3$s::Value value) SBE_NOEXCEPT\n" +
+                indent + "    SBE_NODISCARD static %1$s validate(\n" +
+                indent + "        char *buffer,\n" +
+                indent + "        const std::uint64_t offset,\n" +
+                indent + "        const std::uint64_t actingBlockLength,\n" +
+                indent + "        const std::uint64_t actingVersion,\n" +
+                indent + "        const std::uint64_t bufferLength,\n" +
+                indent + "        int &errnum) SBE_NOEXCEPT\n" +
                 indent + "    {\n" +
-                indent + "        %4$s val = %6$s(value);\n" +
-                indent + "        std::memcpy(m_buffer + m_offset + %5$d, &val, sizeof(%4$s));\n" +
-                indent + "        return *this;\n" +
-                indent + "    }\n",
-                formatClassName(containingClassName),
-                propertyName,
-                enumName,
-                typeName,
-                offset,
-                formatByteOrderEncoding(token.encoding().byteOrder(), token.encoding().primitiveType()));
+                indent + "        errnum = 0;\n" +
+                indent + "        if (offset > bufferLength || actingBlockLength > bufferLength - offset)\n" +
+                indent + "        {\n" +
+                indent + "            errnum = E100;\n" +
+                indent + "            return %1$s();\n" +
+                indent + "        }\n\n" +
+                "%2$s" +
+                indent + "        if (0 != errnum)\n" +
+                indent + "        {\n" +
+                indent + "            return %1$s();\n" +
+                indent + "        }\n\n" +
+                indent + "        return %1$s(buffer, offset, bufferLength, actingBlockLength, actingVersion);\n" +
+                indent + "    }\n\n" +
+
+                "#if __cplusplus >= 201103L\n" +
+                indent + "    SBE_NODISCARD static %1$s validate(\n" +
+                indent + "        char *buffer,\n" +
+                indent + "        const std::uint64_t offset,\n" +
+                indent + "        const std::uint64_t actingBlockLength,\n" +
+                indent + "        const std::uint64_t actingVersion,\n" +
+                indent + "        const std::uint64_t bufferLength,\n" +
+                indent + "        std::error_code &ec) SBE_NOEXCEPT\n" +
+                indent + "    {\n" +
+                indent + "        int errnum = 0;\n" +
+                indent + "        %1$s view = validate(\n" +
+                indent + "            buffer, offset, actingBlockLength, actingVersion, bufferLength, errnum);\n" +
+                indent + "        if (0 != errnum)\n" +
+                indent + "        {\n" +
+                indent + "            sbe_set_error(ec, errnum);\n" +
+                indent + "        }\n\n" +
+                indent + "        return view;\n" +
+                indent + "    }\n" +
+                "#endif\n",
+                className,
+                sbMessage);
         }
     }
 
-    private static void generateBitsetProperty(
-        final StringBuilder sb, final String propertyName, final Token token, final String indent)
+    private static String generateGroupsAndDataValidation(final MessageItem messageItem, final String indent)
     {
-        final String bitsetName = formatClassName(token.applicableTypeName());
-        final int offset = token.offset();
+        final StringBuilder sb = new StringBuilder();
 
-        new Formatter(sb).format("\n" +
-            indent + "private:\n" +
-            indent + "    %1$s m_%2$s;\n\n" +
+        for (final MessageItem child : messageItem.children)
+        {
+            sb.append(indent).append("        position = ").append(messageItemFullClassName(child))
+                .append("::sbeValidatePosition(buffer, position, bufferLength, actingVersion, errnum);\n")
+                .append(indent).append("        if (0 != errnum)\n")
+                .append(indent).append("        {\n")
+                .append(indent).append("            return position;\n")
+                .append(indent).append("        }\n\n");
+        }
 
-            indent + "public:\n",
-            bitsetName,
-            propertyName);
+        final List<Token> tokens = messageItem.varData;
+        for (int i = 0, size = tokens.size(); i < size; i += tokens.get(i).componentTokenCount())
+        {
+            final Token token = tokens.get(i);
+            final Token lengthToken = Generators.findFirst("length", tokens, i);
+            final Encoding lengthEncoding = lengthToken.encoding();
+            final String lengthCheck = null == lengthEncoding.maxValue() ? "" : String.format(
+                " || dataLength > %1$s", validationLiteral(
+                lengthEncoding.primitiveType(), lengthEncoding.applicableMaxValue().longValue()));
 
-        new Formatter(sb).format(
-            indent + "    SBE_NODISCARD %1$s &%2$s()\n" +
-            indent + "    {\n" +
-            indent + "        m_%2$s.wrap(m_buffer, m_offset + %3$d, m_actingVersion, m_bufferLength);\n" +
-            indent + "        return m_%2$s;\n" +
-            indent + "    }\n",
-            bitsetName,
-            propertyName,
-            offset);
+            new Formatter(sb).format(
+                indent + "        %1$s\n" +
+                indent + "        {\n" +
+                indent + "            if (%2$d > bufferLength - position)\n" +
+                indent + "            {\n" +
+                indent + "                errnum = E100;\n" +
+                indent + "                return position;\n" +
+                indent + "            }\n" +
+                indent + "            %3$s lengthValue;\n" +
+                indent + "            std::memcpy(&lengthValue, buffer + position, sizeof(lengthValue));\n" +
+                indent + "            const std::uint64_t dataLength = %4$s(lengthValue);\n" +
+                indent + "            position += %2$d;\n" +
+                indent + "            if (dataLength > bufferLength - position%5$s)\n" +
+                indent + "            {\n" +
+                indent + "                errnum = dataLength > bufferLength - position ? E100 : E111;\n" +
+                indent + "                return position;\n" +
+                indent + "            }\n" +
+                indent + "            position += dataLength;\n" +
+                indent + "        }\n\n",
+                0 == token.version() ? "// " + token.name() : "if (actingVersion >= " + token.version() + ")",
+                lengthToken.encodedLength(),
+                cppTypeName(lengthEncoding.primitiveType()),
+                formatByteOrderEncoding(lengthEncoding.byteOrder(), lengthEncoding.primitiveType()),
+                lengthCheck);
+        }
 
-        new Formatter(sb).format("\n" +
-            indent + "    static SBE_CONSTEXPR std::uint64_t %1$sEncodedLength() SBE_NOEXCEPT\n" +
-            indent + "    {\n" +
-            indent + "        return %2$s;\n" +
-            indent + "    }\n",
-            propertyName,
-            generateEncodedLengthLiteral(token.encoding().primitiveType().size())
-        );
+        return sb.toString();
     }
 
-    private static void generateCompositeProperty(
-        final StringBuilder sb, final String propertyName, final Token token, final String indent)
+    /*
+     * Branch free checks of the enum and ranged integer fields of each element, accumulated across the elements so
+     * the loop over a fixed block group may vectorise. Fields outside the acting version are not checked, and the block
+     * length has already been checked to hold all the others.
+     */
+    private static boolean generateBlockChecks(final StringBuilder sb, final List<Token> tokens, final String indent)
     {
-        final String compositeName = formatClassName(token.applicableTypeName());
+        boolean hasChecks = false;
 
-        new Formatter(sb).format("\n" +
-            "private:\n" +
-            indent + "    %1$s m_%2$s;\n\n" +
+        for (int i = 0, size = tokens.size(); i < size; i++)
+        {
+            final Token signalToken = tokens.get(i);
+            if (signalToken.signal() != Signal.BEGIN_FIELD || signalToken.isConstantEncoding())
+            {
+                continue;
+            }
 
-            "public:\n",
-            compositeName,
-            propertyName);
+            final Token encodingToken = tokens.get(i + 1);
+            final Encoding encoding = encodingToken.encoding();
+            final PrimitiveType primitiveType = encoding.primitiveType();
+            final StringBuilder condition = new StringBuilder();
+            final String flag;
 
-        new Formatter(sb).format(
-            indent + "    SBE_NODISCARD %1$s &%2$s()\n" +
-            indent + "    {\n" +
-            indent + "        m_%2$s.wrap(m_buffer, m_offset + %3$d, m_actingVersion, m_bufferLength);\n" +
-            indent + "        return m_%2$s;\n" +
-            indent + "    }\n",
-            compositeName,
-            propertyName,
-            token.offset());
+            if (encodingToken.signal() == Signal.BEGIN_ENUM)
+            {
+                final List<Long> values = new ArrayList<>();
+                for (int j = i + 2; j < size && tokens.get(j).signal() == Signal.VALID_VALUE; j++)
+                {
+                    values.add(tokens.get(j).encoding().constValue().longValue());
+                }
+                values.add(encoding.applicableNullValue().longValue());
+                appendEnumCondition(condition, primitiveType, values);
+                flag = "enumsValid";
+            }
+            else if (encodingToken.signal() == Signal.ENCODING && !encodingToken.isConstantEncoding() &&
+                encodingToken.arrayLength() == 1 && primitiveType != PrimitiveType.FLOAT &&
+                primitiveType != PrimitiveType.DOUBLE && (null != encoding.minValue() || null != encoding.maxValue()))
+            {
+                appendRangeCondition(
+                    condition,
+                    primitiveType,
+                    encoding.applicableMinValue().longValue(),
+                    encoding.applicableMaxValue().longValue());
+
+                if (encoding.presence() == Encoding.Presence.OPTIONAL)
+                {
+                    condition.append(" || value == ")
+                        .append(validationLiteral(primitiveType, encoding.applicableNullValue().longValue()));
+                }
+                flag = "rangesValid";
+            }
+            else
+            {
+                continue;
+            }
+
+            final String cppType = cppTypeName(primitiveType);
+            final String valueType = isUnsigned(primitiveType) ? "std::uint64_t" : "std::int64_t";
+            new Formatter(sb).format(
+                indent + "            {\n" +
+                indent + "                %1$s raw;\n" +
+                indent + "                std::memcpy(&raw, element + %2$d, sizeof(raw));\n" +
+                indent + "                const %3$s value = static_cast<%3$s>(%4$s(raw));\n" +
+                indent + "                %5$s &= static_cast<int>(%6$s%7$s);\n" +
+                indent + "            }\n",
+                cppType,
+                encodingToken.offset(),
+                valueType,
+                formatByteOrderEncoding(encoding.byteOrder(), primitiveType),
+                flag,
+                0 == signalToken.version() ? "" : "actingVersion < " + signalToken.version() + " || ",
+                condition);
+
+            hasChecks = true;
+        }
+
+        return hasChecks;
     }
 
-    private static String generateEncodedLengthLiteral(final long sz)
+    /*
+     * The shortest block holding every field present in the acting version, as an expression of actingVersion, or
+     * null when the block has no fields.
+     */
+    private static String generateMinBlockLength(final List<Token> tokens)
     {
-        if (sz < 0)
+        final TreeMap<Integer, Integer> endByVersion = new TreeMap<>();
+        for (int i = 0, size = tokens.size(); i < size; i++)
         {
-            return "UINT64_MAX";
+            final Token signalToken = tokens.get(i);
+            if (signalToken.signal() != Signal.BEGIN_FIELD || signalToken.isConstantEncoding())
+            {
+                continue;
+            }
+
+            final Token encodingToken = tokens.get(i + 1);
+            if (!encodingToken.isConstantEncoding())
+            {
+                endByVersion.merge(
+                    signalToken.version(), encodingToken.offset() + encodingToken.encodedLength(), Math::max);
+            }
         }
-        return "" + sz;
+
+        String minBlockLength = null;
+        int end = 0;
+        for (final Map.Entry<Integer, Integer> entry : endByVersion.entrySet())
+        {
+            end = Math.max(end, entry.getValue());
+            minBlockLength = 0 == entry.getKey() ? Integer.toString(end) : String.format(
+                "(actingVersion >= %1$d ? %2$d : %3$s)",
+                entry.getKey(),
+                end,
+                null == minBlockLength ? "0" : minBlockLength);
+        }
+
+        return "0".equals(minBlockLength) ? null : minBlockLength;
     }
 
-    private CharSequence generateNullValueLiteral(final PrimitiveType primitiveType, final Encoding encoding)
+    private static void appendEnumCondition(
+        final StringBuilder sb, final PrimitiveType primitiveType, final List<Long> values)
     {
-        // Visual C++ does not handle minimum integer values properly
-        // See: http://msdn.microsoft.com/en-us/library/4kh09110.aspx
-        // So some of the null values get special handling
-        if (null == encoding.nullValue())
+        final boolean isUnsigned = isUnsigned(primitiveType);
+        values.sort(isUnsigned ? Long::compareUnsigned : Long::compare);
+
+        for (int i = 0, size = values.size(); i < size;)
         {
-            switch (primitiveType)
+            final long low = values.get(i);
+            long high = low;
+            i++;
+            while (i < size && (values.get(i) == high || values.get(i) == high + 1) && high != Long.MAX_VALUE)
             {
-                case CHAR:
-                case FLOAT:
-                case DOUBLE:
-                    break; // no special handling
-                case INT8:
-                    return "SBE_NULLVALUE_INT8";
-                case INT16:
-                    return "SBE_NULLVALUE_INT16";
-                case INT32:
-                    return "SBE_NULLVALUE_INT32";
-                case INT64:
-                    return "SBE_NULLVALUE_INT64";
-                case UINT8:
-                    return "SBE_NULLVALUE_UINT8";
-                case UINT16:
-                    return "SBE_NULLVALUE_UINT16";
-                case UINT32:
+                high = values.get(i);
+                i++;
+            }
+
+            if (sb.length() > 0)
+            {
+                sb.append(" || ");
+            }
+
+            if (low == high)
+            {
+                sb.append("value == ").append(validationLiteral(primitiveType, low));
+            }
+            else
+            {
+                appendRangeCondition(sb, primitiveType, low, high);
+            }
+        }
+    }
+
+    private static void appendRangeCondition(
+        final StringBuilder sb, final PrimitiveType primitiveType, final long low, final long high)
+    {
+        final boolean isUnsigned = isUnsigned(primitiveType);
+        final boolean hasLow = isUnsigned ? 0 != low : Long.MIN_VALUE != low;
+        final boolean hasHigh = isUnsigned ? -1 != high : Long.MAX_VALUE != high;
+
+        sb.append("(");
+        if (hasLow)
+        {
+            sb.append("value >= ").append(validationLiteral(primitiveType, low));
+        }
+        if (hasLow && hasHigh)
+        {
+            sb.append(" && ");
+        }
+        if (hasHigh)
+        {
+            sb.append("value <= ").append(validationLiteral(primitiveType, high));
+        }
+        if (!hasLow && !hasHigh)
+        {
+            sb.append("true");
+        }
+        sb.append(")");
+    }
+
+    private static boolean isUnsigned(final PrimitiveType primitiveType)
+    {
+        return primitiveType == PrimitiveType.UINT8 || primitiveType == PrimitiveType.UINT16 ||
+            primitiveType == PrimitiveType.UINT32 || primitiveType == PrimitiveType.UINT64;
+    }
+
+    private static String validationLiteral(final PrimitiveType primitiveType, final long value)
+    {
+        if (isUnsigned(primitiveType))
+        {
+            return "UINT64_C(" + Long.toUnsignedString(value) + ")";
+        }
+
+        return Long.MIN_VALUE == value ? "INT64_MIN" : "INT64_C(" + value + ")";
+    }
+
+    /*
+     * In the current_version namespace each message is generated again without the checks of fields against the
+     * acting version, and wrapForDecodeWith picks it for the decode when the acting version is at least the schema
+     * version, falling back to the checked class for older versions.
+     */
+    private CharSequence generateVersionPinnedDispatch(final MessageItem messageItem)
+    {
+        final String className = messageItemClassName(messageItem);
+
+        return String.format("\n" +
+            "#if __cplusplus >= 201103L\n" +
+            "    template<typename Func>\n" +
+            "    static void wrapForDecodeWith(\n" +
+            "        char *buffer,\n" +
+            "        const std::uint64_t offset,\n" +
+            "        const std::uint64_t actingBlockLength,\n" +
+            "        const std::uint64_t actingVersion,\n" +
+            "        const std::uint64_t bufferLength,\n" +
+            "        Func &&func)\n" +
+            "    {\n" +
+            "        if (actingVersion >= sbeSchemaVersion())\n" +
+            "        {\n" +
+            "            %1$s decoder(buffer, offset, bufferLength, actingBlockLength, actingVersion);\n" +
+            "            func(decoder);\n" +
+            "        }\n" +
+            "        else\n" +
+            "        {\n" +
+            "            %2$s decoder(buffer, offset, bufferLength, actingBlockLength, actingVersion);\n" +
+            "            func(decoder);\n" +
+            "        }\n" +
+            "    }\n" +
+            "#endif\n",
+            className,
+            "::" + fullClassNameForType(className));
+    }
+
+    private void generateFields(
+        final StringBuilder sb,
+        final String containingClassName,
+        final List<Token> tokens,
+        final String indent)
+    {
+        for (int i = 0, size = tokens.size(); i < size; i++)
+        {
+            final Token signalToken = tokens.get(i);
+            if (signalToken.signal() == Signal.BEGIN_FIELD)
+            {
+                final Token encodingToken = tokens.get(i + 1);
+                final String propertyName = formatPropertyName(signalToken.name());
+
+                generateFieldMetaAttributeMethod(sb, signalToken, indent);
+                generateFieldCommonMethods(indent, sb, signalToken, encodingToken, propertyName);
+
+                switch (encodingToken.signal())
+                {
+                    case ENCODING:
+                        generatePrimitiveProperty(
+                            sb, containingClassName, propertyName, signalToken, encodingToken, indent);
+                        break;
+
+                    case BEGIN_ENUM:
+                        generateEnumProperty(sb, containingClassName, signalToken, propertyName, encodingToken, indent);
+                        break;
+
+                    case BEGIN_SET:
+                        generateBitsetProperty(sb, propertyName, encodingToken, indent);
+                        break;
+
+                    case BEGIN_COMPOSITE:
+                        generateCompositeProperty(sb, propertyName, encodingToken, indent);
+                        break;
+
+                    default:
+                        break;
+                }
+            }
+        }
+    }
+
+    /*
+     * A constexpr descriptor of each fixed field, a table of them, and a forEachField visitor which calls the visitor
+     * with the descriptor and accessor of each field in turn so it inlines to the accessor calls.
+     */
+    private void generateFieldReflection(
+        final StringBuilder sb,
+        final List<Token> tokens,
+        final String indent)
+    {
+        final StringBuilder sbTable = new StringBuilder();
+        final StringBuilder sbVisit = new StringBuilder();
+        int fieldCount = 0;
+
+        sb.append("\n#if __cplusplus >= 201103L\n");
+
+        for (int i = 0, size = tokens.size(); i < size; i++)
+        {
+            final Token signalToken = tokens.get(i);
+            if (signalToken.signal() != Signal.BEGIN_FIELD)
+            {
+                continue;
+            }
+
+            final Token encodingToken = tokens.get(i + 1);
+            final String propertyName = formatPropertyName(signalToken.name());
+            final Encoding encoding = encodingToken.encoding();
+            final boolean isConstant = signalToken.isConstantEncoding() || encodingToken.isConstantEncoding();
+            final String primitiveType = encodingToken.signal() == Signal.BEGIN_COMPOSITE ?
+                "NONE" : encoding.primitiveType().name();
+
+            new Formatter(sb).format("\n" +
+                indent + "    SBE_NODISCARD static SBE_CONSTEXPR sbe_field_descriptor %1$sDescriptor() SBE_NOEXCEPT\n" +
+                indent + "    {\n" +
+                indent + "        return { \"%2$s\", %3$d, %4$d, %5$d, sbe_primitive_type_%6$s, sbe_byte_order_%7$s, " +
+                "%8$d, sbe_presence_%9$s };\n" +
+                indent + "    }\n",
+                propertyName,
+                signalToken.name(),
+                signalToken.id(),
+                encodingToken.offset(),
+                isConstant ? 0 : encodingToken.encodedLength(),
+                primitiveType,
+                encoding.byteOrder() == ByteOrder.BIG_ENDIAN ? "BIG_ENDIAN" : "LITTLE_ENDIAN",
+                signalToken.version(),
+                isConstant ? "CONSTANT" : encoding.presence().name());
+
+            sbTable.append(fieldCount > 0 ? ",\n" : "\n")
+                .append(indent).append("            ").append(propertyName).append("Descriptor()");
+            sbVisit.append(indent).append("        visitor(").append(propertyName).append("Descriptor(), ")
+                .append(propertyName).append("());\n");
+            fieldCount++;
+        }
+
+        new Formatter(sb).format("\n" +
+            indent + "    SBE_NODISCARD static SBE_CONSTEXPR std::size_t sbeFieldCount() SBE_NOEXCEPT\n" +
+            indent + "    {\n" +
+            indent + "        return %1$d;\n" +
+            indent + "    }\n",
+            fieldCount);
+
+        if (fieldCount > 0)
+        {
+            new Formatter(sb).format("\n" +
+                indent + "    SBE_NODISCARD static const sbe_field_descriptor *sbeFieldDescriptors() SBE_NOEXCEPT\n" +
+                indent + "    {\n" +
+                indent + "        static SBE_CONSTEXPR sbe_field_descriptor descriptors[] =\n" +
+                indent + "        {%1$s\n" +
+                indent + "        };\n\n" +
+                indent + "        return descriptors;\n" +
+                indent + "    }\n",
+                sbTable);
+        }
+        else
+        {
+            sb.append("\n")
+                .append(indent).append("    SBE_NODISCARD static const sbe_field_descriptor *sbeFieldDescriptors() ")
+                .append("SBE_NOEXCEPT\n")
+                .append(indent).append("    {\n")
+                .append(indent).append("        return nullptr;\n")
+                .append(indent).append("    }\n");
+        }
+
+        new Formatter(sb).format("\n" +
+            indent + "    template<typename Visitor>\n" +
+            indent + "    void forEachField(Visitor &&visitor)\n" +
+            indent + "    {\n" +
+            "%1$s" +
+            indent + "    }\n" +
+            "#endif\n",
+            fieldCount > 0 ? sbVisit : indent + "        (void)visitor;\n");
+    }
+
+    /*
+     * A packed struct of the block with asStruct and fromStruct to copy it whole, for blocks which are little endian,
+     * gap free, and have every primitive at an offset aligned to its size.
+     */
+    private void generateStructOverlay(
+        final StringBuilder sb,
+        final String className,
+        final MessageItem messageItem,
+        final String indent)
+    {
+        final StringBuilder sbMembers = new StringBuilder();
+        final StringBuilder sbAsserts = new StringBuilder();
+        final List<Token> tokens = messageItem.fields;
+        int position = 0;
+        int sinceVersion = 0;
+
+        for (int i = 0, size = tokens.size(); i < size; i++)
+        {
+            final Token signalToken = tokens.get(i);
+            if (signalToken.signal() == Signal.BEGIN_FIELD)
+            {
+                final Token encodingToken = tokens.get(i + 1);
+                if (signalToken.isConstantEncoding() || encodingToken.isConstantEncoding())
+                {
+                    continue;
+                }
+
+                position = appendStructMember(
+                    sbMembers,
+                    sbAsserts,
+                    tokens,
+                    i + 1,
+                    signalToken.name(),
+                    encodingToken.offset(),
+                    position,
+                    "",
+                    indent + INDENT + INDENT);
+
+                if (position < 0)
+                {
+                    return;
+                }
+
+                sinceVersion = Math.max(sinceVersion, signalToken.version());
+            }
+        }
+
+        if (0 == position || position != messageItem.rootToken.encodedLength())
+        {
+            return;
+        }
+
+        final StringBuilder sbIndentedAsserts = new StringBuilder();
+        for (final String line : sbAsserts.toString().split("\n"))
+        {
+            sbIndentedAsserts.append(indent).append(INDENT).append(line).append("\n");
+        }
+
+        final String versionCheck = 0 == sinceVersion || isVersionPinned ? "" :
+            indent + "        if (m_actingVersion < " + sinceVersion + ")\n" +
+            indent + "        {\n" +
+            indent + "            sbe_throw_errnum(E107, \"acting version too old for struct [E107]\");\n" +
+            indent + "            return Block();\n" +
+            indent + "        }\n";
+
+        new Formatter(sb).format("\n" +
+            "#if __cplusplus >= 201103L && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__\n" +
+            "#pragma pack(push, 1)\n" +
+            indent + "    struct Block\n" +
+            indent + "    {\n" +
+            "%1$s" +
+            indent + "    };\n" +
+            "#pragma pack(pop)\n\n" +
+
+            indent + "    static_assert(sizeof(Block) == %2$d, \"Block must match the encoded block length\");\n" +
+            "%3$s\n" +
+
+            indent + "    SBE_NODISCARD Block asStruct() const\n" +
+            indent + "    {\n" +
+            "%4$s" +
+            "%6$s" +
+            indent + "        Block block;\n" +
+            indent + "        std::memcpy(&block, m_buffer + m_offset, sizeof(Block));\n" +
+            indent + "        return block;\n" +
+            indent + "    }\n\n" +
+
+            indent + "    %5$s &fromStruct(const Block &block)\n" +
+            indent + "    {\n" +
+            indent + "        if (SBE_BOUNDS_CHECK_EXPECT(((m_offset + sizeof(Block)) > m_bufferLength), false))\n" +
+            indent + "        {\n" +
+            indent + "            sbe_throw_errnum(E107, \"buffer too short for struct [E107]\");\n" +
+            indent + "            return *this;\n" +
+            indent + "        }\n" +
+            indent + "        std::memcpy(m_buffer + m_offset, &block, sizeof(Block));\n" +
+            indent + "        return *this;\n" +
+            indent + "    }\n" +
+            "#endif\n",
+            sbMembers,
+            position,
+            sbIndentedAsserts,
+            versionCheck,
+            className,
+            generateDecodeCheck(
+                indent,
+                "(m_offset + sizeof(Block)) > m_bufferLength",
+                "sbe_throw_errnum(E107, \"buffer too short for struct [E107]\");",
+                "return Block();"));
+    }
+
+    /*
+     * Append the member for the type starting at tokens[index] to the struct, returning the position after it, or -1
+     * if the type does not start at the position or is not naturally aligned little endian.
+     */
+    private static int appendStructMember(
+        final StringBuilder sbMembers,
+        final StringBuilder sbAsserts,
+        final List<Token> tokens,
+        final int index,
+        final String name,
+        final int offset,
+        final int position,
+        final String path,
+        final String indent)
+    {
+        final Token typeToken = tokens.get(index);
+        final String memberName = formatPropertyName(name);
+        final String memberPath = path + memberName;
+
+        if (offset != position)
+        {
+            return -1;
+        }
+
+        new Formatter(sbAsserts).format(
+            "static_assert(offsetof(Block, %1$s) == %2$d, \"Block must match the encoded block layout\");\n",
+            memberPath,
+            offset);
+
+        switch (typeToken.signal())
+        {
+            case ENCODING:
+            case BEGIN_ENUM:
+            case BEGIN_SET:
+            {
+                final Encoding encoding = typeToken.encoding();
+                final int primitiveSize = encoding.primitiveType().size();
+                final int arrayLength = typeToken.signal() == Signal.ENCODING ? typeToken.arrayLength() : 1;
+
+                if ((primitiveSize > 1 && encoding.byteOrder() != ByteOrder.LITTLE_ENDIAN) ||
+                    0 != offset % primitiveSize ||
+                    typeToken.encodedLength() != primitiveSize * arrayLength)
+                {
+                    return -1;
+                }
+
+                sbMembers.append(indent).append(cppTypeName(encoding.primitiveType())).append(' ').append(memberName)
+                    .append(arrayLength > 1 ? "[" + arrayLength + "]" : "").append(";\n");
+
+                return position + typeToken.encodedLength();
+            }
+
+            case BEGIN_COMPOSITE:
+            {
+                final int endIndex = index + typeToken.componentTokenCount() - 1;
+                int memberPosition = position;
+
+                if (0 == typeToken.encodedLength())
+                {
+                    return -1;
+                }
+
+                sbMembers.append(indent).append("struct\n").append(indent).append("{\n");
+
+                for (int i = index + 1; i < endIndex; i += tokens.get(i).componentTokenCount())
+                {
+                    final Token memberToken = tokens.get(i);
+                    if (memberToken.isConstantEncoding())
+                    {
+                        continue;
+                    }
+
+                    memberPosition = appendStructMember(
+                        sbMembers,
+                        sbAsserts,
+                        tokens,
+                        i,
+                        memberToken.name(),
+                        offset + memberToken.offset(),
+                        memberPosition,
+                        memberPath + ".",
+                        indent + INDENT);
+
+                    if (memberPosition < 0)
+                    {
+                        return -1;
+                    }
+                }
+
+                sbMembers.append(indent).append("} ").append(memberName).append(";\n");
+
+                return memberPosition == position + typeToken.encodedLength() ? memberPosition : -1;
+            }
+
+            default:
+                return -1;
+        }
+    }
+
+    private void generateFieldCommonMethods(
+        final String indent,
+        final StringBuilder sb,
+        final Token fieldToken,
+        final Token encodingToken,
+        final String propertyName)
+    {
+        new Formatter(sb).format("\n" +
+            indent + "    static SBE_CONSTEXPR std::uint16_t %1$sId() SBE_NOEXCEPT\n" +
+            indent + "    {\n" +
+            indent + "        return %2$s;\n" +
+            indent + "    }\n",
+            propertyName,
+            generateLiteral(ir.headerStructure().templateIdType(), "" + fieldToken.id())
+        );
+
+        new Formatter(sb).format("\n" +
+            indent + "    SBE_NODISCARD static SBE_CONSTEXPR std::uint64_t %1$sSinceVersion() SBE_NOEXCEPT\n" +
+            indent + "    {\n" +
+            indent + "        return %2$d;\n" +
+            indent + "    }\n\n" +
+
+            indent + "    SBE_NODISCARD bool %1$sInActingVersion() SBE_NOEXCEPT\n" +
+            indent + "    {\n" +
+            indent + "        return m_actingVersion >= %1$sSinceVersion();\n" +
+            indent + "    }\n",
+            propertyName,
+            fieldToken.version());
+
+        new Formatter(sb).format("\n" +
+            indent + "    SBE_NODISCARD static SBE_CONSTEXPR std::uint64_t %1$sEncodedOffset() SBE_NOEXCEPT\n" +
+            indent + "    {\n" +
+            indent + "        return %2$s;\n" +
+            indent + "    }\n",
+            propertyName,
+            generateEncodedLengthLiteral(encodingToken.offset()));
+    }
+
+    private static void generateFieldMetaAttributeMethod(
+        final StringBuilder sb, final Token token, final String indent)
+    {
+        final Encoding encoding = token.encoding();
+        final String epoch = encoding.epoch() == null ? "" : encoding.epoch();
+        final String timeUnit = encoding.timeUnit() == null ? "" : encoding.timeUnit();
+        final String semanticType = encoding.semanticType() == null ? "" : encoding.semanticType();
+
+        sb.append("\n")
+            .append(indent).append("    SBE_NODISCARD static const char * ")
+            .append(token.name()).append("MetaAttribute(const sbe_meta_attribute metaAttribute) SBE_NOEXCEPT\n")
+            .append(indent).append("    {\n")
+            .append(indent).append("        switch (metaAttribute)\n")
+            .append(indent).append("        {\n");
+
+        if (!Strings.isEmpty(epoch))
+        {
+            sb.append(indent)
+                .append("            case sbe_meta_attribute_EPOCH: return \"").append(epoch).append("\";\n");
+        }
+
+        if (!Strings.isEmpty(timeUnit))
+        {
+            sb.append(indent)
+                .append("            case sbe_meta_attribute_TIME_UNIT: return \"").append(timeUnit).append("\";\n");
+        }
+
+        if (!Strings.isEmpty(semanticType))
+        {
+            sb.append(indent)
+                .append("            case sbe_meta_attribute_SEMANTIC_TYPE: return \"").append(semanticType)
+                .append("\";\n");
+        }
+
+        sb
+            .append(indent).append("            case sbe_meta_attribute_PRESENCE: return \"")
+            .append(encoding.presence().toString().toLowerCase()).append("\";\n")
+            .append(indent).append("            default: return \"\";\n")
+            .append(indent).append("        }\n")
+            .append(indent).append("    }\n");
+    }
+
+    private CharSequence generateEnumFieldNotPresentCondition(
+        final int sinceVersion,
+        final String enumName,
+        final String indent)
+    {
+        if (0 == sinceVersion || isVersionPinned)
+        {
+            return "";
+        }
+
+        return String.format(
+            indent + "        if (m_actingVersion < %1$d)\n" +
+            indent + "        {\n" +
+            indent + "            return %2$s::NULL_VALUE;\n" +
+            indent + "        }\n\n",
+            sinceVersion,
+            enumName);
+    }
+
+    private void generateEnumProperty(
+        final StringBuilder sb,
+        final String containingClassName,
+        final Token fieldToken,
+        final String propertyName,
+        final Token token,
+        final String indent)
+    {
+        final String enumName = formatClassName(token.applicableTypeName());
+        final String typeName = cppTypeName(token.encoding().primitiveType());
+        final int offset = token.offset();
+
+        new Formatter(sb).format("\n" +
+            indent + "    SBE_NODISCARD static SBE_CONSTEXPR std::uint64_t %1$sEncodedLength() SBE_NOEXCEPT\n" +
+            indent + "    {\n" +
+            indent + "        return %2$s;\n" +
+            indent + "    }\n",
+            propertyName,
+            generateEncodedLengthLiteral(fieldToken.encodedLength()));
+
+        if (fieldToken.isConstantEncoding())
+        {
+            final String constValue = fieldToken.encoding().constValue().toString();
+
+            new Formatter(sb).format("\n" +
+                indent + "    SBE_NODISCARD static SBE_CONSTEXPR %1$s::Value %2$sConstValue() SBE_NOEXCEPT\n" +
+                indent + "    {\n" +
+                indent + "        return %1$s::%3$s;\n" +
+                indent + "    }\n",
+                enumName,
+                propertyName,
+                constValue.substring(constValue.indexOf(".") + 1));
+
+            new Formatter(sb).format("\n" +
+                indent + "    SBE_NODISCARD %1$s::Value %2$s() const SBE_NOEXCEPT\n" +
+                indent + "    {\n" +
+                "%3$s" +
+                indent + "        return %1$s::%4$s;\n" +
+                indent + "    }\n",
+                enumName,
+                propertyName,
+                generateEnumFieldNotPresentCondition(fieldToken.version(), enumName, indent),
+                constValue.substring(constValue.indexOf(".") + 1));
+        }
+        else
+        {
+            new Formatter(sb).format("\n" +
+                indent + "    SBE_NODISCARD %1$s::Value %2$s() const SBE_NOEXCEPT\n" +
+                indent + "    {\n" +
+                "%3$s" +
+                indent + "        %5$s val;\n" +
+                indent + "        std::memcpy(&val, m_buffer + m_offset + %6$d, sizeof(%5$s));\n" +
+                indent + "        return %1$s::get(%4$s(val));\n" +
+                indent + "    }\n",
+                enumName,
+                propertyName,
+                generateEnumFieldNotPresentCondition(fieldToken.version(), enumName, indent),
+                formatByteOrderEncoding(token.encoding().byteOrder(), token.encoding().primitiveType()),
+                typeName,
+                offset);
+
+            new Formatter(sb).format("\n" +
+                indent + "    %1$s &%2$s(const %3$s::Value value) SBE_NOEXCEPT\n" +
+                indent + "    {\n" +
+                indent + "        %4$s val = %6$s(value);\n" +
+                indent + "        std::memcpy(m_buffer + m_offset + %5$d, &val, sizeof(%4$s));\n" +
+                indent + "        return *this;\n" +
+                indent + "    }\n",
+                formatClassName(containingClassName),
+                propertyName,
+                enumName,
+                typeName,
+                offset,
+                formatByteOrderEncoding(token.encoding().byteOrder(), token.encoding().primitiveType()));
+        }
+    }
+
+    private static void generateBitsetProperty(
+        final StringBuilder sb, final String propertyName, final Token token, final String indent)
+    {
+        final String bitsetName = formatClassName(token.applicableTypeName());
+        final int offset = token.offset();
+
+        new Formatter(sb).format("\n" +
+            indent + "private:\n" +
+            indent + "    %1$s m_%2$s;\n\n" +
+
+            indent + "public:\n",
+            bitsetName,
+            propertyName);
+
+        new Formatter(sb).format(
+            indent + "    SBE_NODISCARD %1$s &%2$s()\n" +
+            indent + "    {\n" +
+            indent + "        m_%2$s.wrap(m_buffer, m_offset + %3$d, m_actingVersion, m_bufferLength);\n" +
+            indent + "        return m_%2$s;\n" +
+            indent + "    }\n",
+            bitsetName,
+            propertyName,
+            offset);
+
+        new Formatter(sb).format("\n" +
+            indent + "    static SBE_CONSTEXPR std::uint64_t %1$sEncodedLength() SBE_NOEXCEPT\n" +
+            indent + "    {\n" +
+            indent + "        return %2$s;\n" +
+            indent + "    }\n",
+            propertyName,
+            generateEncodedLengthLiteral(token.encoding().primitiveType().size())
+        );
+    }
+
+    private static void generateCompositeProperty(
+        final StringBuilder sb, final String propertyName, final Token token, final String indent)
+    {
+        final String compositeName = formatClassName(token.applicableTypeName());
+
+        new Formatter(sb).format("\n" +
+            "private:\n" +
+            indent + "    %1$s m_%2$s;\n\n" +
+
+            "public:\n",
+            compositeName,
+            propertyName);
+
+        new Formatter(sb).format(
+            indent + "    SBE_NODISCARD %1$s &%2$s()\n" +
+            indent + "    {\n" +
+            indent + "        m_%2$s.wrap(m_buffer, m_offset + %3$d, m_actingVersion, m_bufferLength);\n" +
+            indent + "        return m_%2$s;\n" +
+            indent + "    }\n",
+            compositeName,
+            propertyName,
+            token.offset());
+    }
+
+    private static String generateEncodedLengthLiteral(final long sz)
+    {
+        if (sz < 0)
+        {
+            return "UINT64_MAX";
+        }
+        return "" + sz;
+    }
+
+    private CharSequence generateNullValueLiteral(final PrimitiveType primitiveType, final Encoding encoding)
+    {
+        // Visual C++ does not handle minimum integer values properly
+        // See: http://msdn.microsoft.com/en-us/library/4kh09110.aspx
+        // So some of the null values get special handling
+        if (null == encoding.nullValue())
+        {
+            switch (primitiveType)
+            {
+                case CHAR:
+                case FLOAT:
+                case DOUBLE:
+                    break; // no special handling
+                case INT8:
+                    return "SBE_NULLVALUE_INT8";
+                case INT16:
+                    return "SBE_NULLVALUE_INT16";
+                case INT32:
+                    return "SBE_NULLVALUE_INT32";
+                case INT64:
+                    return "SBE_NULLVALUE_INT64";
+                case UINT8:
+                    return "SBE_NULLVALUE_UINT8";
+                case UINT16:
+                    return "SBE_NULLVALUE_UINT16";
+                case UINT32:
                     return "SBE_NULLVALUE_UINT32";
                 case UINT64:
                     return "SBE_NULLVALUE_UINT64";
             }
         }
 
-        return generateLiteral(primitiveType, encoding.applicableNullValue().toString());
+        return generateLiteral(primitiveType, encoding.applicableNullValue().toString());
+    }
+
+    private CharSequence generateLiteral(final PrimitiveType type, final String value)
+    {
+        String literal = "";
+
+        final String castType = cppTypeName(type);
+        switch (type)
+        {
+            case CHAR:
+            case UINT8:
+            case UINT16:
+            case INT8:
+            case INT16:
+                literal = "(" + castType + ")" + value;
+                break;
+
+            case UINT32:
+            {
+                final long intValue = Long.parseLong(value);
+                literal = "UINT32_C(0x" + Integer.toHexString((int)intValue) + ")";
+                break;
+            }
+            case INT32:
+                final long intValue = Long.parseLong(value);
+                if (intValue == Integer.MIN_VALUE)
+                {
+                    literal = "INT32_MIN";
+                }
+                else
+                {
+                    literal = "INT32_C(" + Long.toString(intValue) + ")";
+                }
+                break;
+
+            case FLOAT:
+                literal = value.endsWith("NaN") ? "SBE_FLOAT_NAN" : value + "f";
+                break;
+
+            case INT64:
+                final long longValue = Long.parseLong(value);
+                if (longValue == Long.MIN_VALUE)
+                {
+                    literal = "INT64_MIN";
+                }
+                else
+                {
+                    literal = "INT64_C(" + String.valueOf(longValue) + ")";
+                }
+                break;
+
+            case UINT64:
+                literal = "UINT64_C(0x" + Long.toHexString(Long.parseLong(value)) + ")";
+                break;
+
+            case DOUBLE:
+                literal = value.endsWith("NaN") ? "SBE_DOUBLE_NAN" : value;
+                break;
+        }
+
+        return literal;
+    }
+
+    public static String jsonString(final String token, final String suffix)
+    {
+        /* "\"color\"" */
+        /* "\"color\": " */
+        /* "\"color\", " */
+        return String.format("\"\\\"%1$s\\\"%2$s\"", token, suffix);
+    }
+
+    private void generateDisplay(
+        final StringBuilder sb,
+        final MessageItem messageItem)
+    {
+        new Formatter(sb).format("\n" +
+            INDENT + "friend std::ostream& operator << (std::ostream& builder, %1$s _writer)\n" +
+            INDENT + "{\n" +
+            INDENT + "    %1$s writer(_writer.m_buffer, _writer.m_offset,\n" +
+            INDENT + "        _writer.m_bufferLength, _writer.sbeBlockLength(), _writer.m_actingVersion);\n" +
+            INDENT + "    builder << '{';\n" +
+            INDENT + "    builder << " + jsonString("Name", ": ") + " << " + jsonString("%2$s", ", ") + ";\n" +
+            INDENT + "    builder << " + jsonString("sbeTemplateId", ": ") + ";\n" +
+            INDENT + "    builder << writer.sbeTemplateId();\n" +
+            INDENT + "    builder << \", \";\n\n" +
+            "%3$s" +
+            INDENT + "    builder << '}';\n\n" +
+            INDENT + "    return builder;\n" +
+            INDENT + "}\n",
+            messageItemFullClassName(messageItem),
+            messageItemClassName(messageItem),
+            appendDisplay(messageItem, INDENT + INDENT));
+    }
+
+    private void generateGroupDisplay(
+        final StringBuilder sb,
+        final MessageItem messageItem,
+        final String indent)
+    {
+        formatter(sb).format("\n" +
+            indent + "friend std::ostream& operator << (std::ostream& builder, %1$s writer)\n" +
+            indent + "{\n" +
+            indent + "    builder << '{';\n" +
+            "%2$s" +
+            indent + "    builder << '}';\n\n" +
+            indent + "    return builder;\n" +
+            indent + "}\n",
+            messageItemFullClassName(messageItem),
+            appendDisplay(messageItem, indent + INDENT));
+    }
+
+    private CharSequence generateCompositeDisplay(final String name, final List<Token> tokens)
+    {
+        return String.format("\n" +
+            INDENT + "friend std::ostream& operator << (std::ostream& builder, %1$s writer)\n" +
+            INDENT + "{\n" +
+            INDENT + "    builder << '{';\n" +
+            INDENT + "%2$s" +
+            INDENT + "    builder << '}';\n\n" +
+            INDENT + "    return builder;\n" +
+            INDENT + "}\n\n",
+            formatClassName(name),
+            appendDisplay(new MessageItem(tokens, new ArrayList<Token>()), INDENT + INDENT)
+        );
+    }
+
+    private CharSequence appendDisplay(
+        final MessageItem messageItem, final String indent)
+    {
+        final StringBuilder sb = new StringBuilder();
+        final boolean[] atLeastOne = { false };
+
+        for (int i = 0, size = messageItem.fields.size(); i < size;)
+        {
+            final Token fieldToken = messageItem.fields.get(i);
+            final Token encodingToken = messageItem.fields.get(fieldToken.signal() == Signal.BEGIN_FIELD ? i + 1 : i);
+
+            writeTokenDisplay(sb, fieldToken.name(), encodingToken, atLeastOne, indent);
+            i += fieldToken.componentTokenCount();
+        }
+
+        for (int i = 0, size = messageItem.children.size(); i < size; i++)
+        {
+            final MessageItem child = messageItem.children.get(i);
+            final Token groupToken = child.rootToken;
+            if (groupToken.signal() != Signal.BEGIN_GROUP)
+            {
+                throw new IllegalStateException("tokens must begin with BEGIN_GROUP: token=" + groupToken);
+            }
+
+            if (atLeastOne[0])
+            {
+                sb.append(indent).append("builder << \", \";\n");
+            }
+            atLeastOne[0] = true;
+
+            new Formatter(sb).format(
+                indent + "{\n" +
+                indent + "    bool atLeastOne = false;\n" +
+                indent + "    builder << " + jsonString("%3$s", ": [") + ";\n" +
+                indent + "    %1$s& %2$s = writer.%2$s();\n" +
+                indent + "    while(%2$s.hasNext())\n" +
+                indent + "    {\n" +
+                indent + "        %2$s.next();\n" +
+                indent + "        if (atLeastOne)\n" +
+                indent + "        {\n" +
+                indent + "            builder << \", \";\n" +
+                indent + "        }\n" +
+                indent + "        atLeastOne = true;\n" +
+                indent + "        builder << %2$s;\n" +
+                indent + "    };\n" +
+                indent + "    builder << ']';\n" +
+                indent + "}\n\n",
+                messageItemFullClassName(child),
+                formatPropertyName(groupToken.name()),
+                groupToken.name());
+        }
+
+        for (int i = 0, size = messageItem.varData.size(); i < size;)
+        {
+            final Token varDataToken = messageItem.varData.get(i);
+            if (varDataToken.signal() != Signal.BEGIN_VAR_DATA)
+            {
+                throw new IllegalStateException("tokens must begin with BEGIN_VAR_DATA: token=" + varDataToken);
+            }
+
+            if (atLeastOne[0])
+            {
+                sb.append(indent).append("builder << \", \";\n");
+            }
+            atLeastOne[0] = true;
+
+            final String characterEncoding = messageItem.varData.get(i + 3).encoding().characterEncoding();
+            sb.append(indent).append("builder << " + jsonString(varDataToken.name(), ": ") + ";\n");
+
+            if (null == characterEncoding)
+            {
+                final String skipFunction = "writer.skip" + toUpperFirstChar(varDataToken.name()) + "()";
+
+                sb.append(indent).append("builder << '\"' <<\n").append(indent).append(INDENT).append(skipFunction)
+                    .append(" << \" bytes of raw data\\\"\";\n");
+            }
+            else
+            {
+                final String getAsStringFunction =
+                    "writer.get" + toUpperFirstChar(varDataToken.name()) + "AsJsonEscapedString().c_str()";
+
+                sb.append(indent).append("builder << '\"' <<\n").append(indent).append(INDENT)
+                    .append(getAsStringFunction).append(" << '\"';\n\n");
+            }
+
+            i += varDataToken.componentTokenCount();
+        }
+
+        return sb;
+    }
+
+    private void writeTokenDisplay(
+        final StringBuilder sb,
+        final String fieldTokenName,
+        final Token typeToken,
+        final boolean[] atLeastOne,
+        final String indent)
+    {
+        if (typeToken.encodedLength() <= 0 || typeToken.isConstantEncoding())
+        {
+            return;
+        }
+
+        if (atLeastOne[0])
+        {
+            sb.append(indent).append("builder << \", \";\n");
+        }
+        else
+        {
+            atLeastOne[0] = true;
+        }
+
+        sb.append(indent).append("builder << ").append(jsonString(fieldTokenName, ": ")).append(";\n");
+        final String fieldName = "writer." + formatPropertyName(fieldTokenName);
+
+        switch (typeToken.signal())
+        {
+            case ENCODING:
+                if (typeToken.arrayLength() > 1)
+                {
+                    if (typeToken.encoding().primitiveType() == PrimitiveType.CHAR)
+                    {
+                        final String getAsStringFunction =
+                            "writer.get" + toUpperFirstChar(fieldTokenName) + "AsJsonEscapedString().c_str()";
+
+                        sb.append(indent).append("builder << '\"' <<\n").append(indent).append(INDENT)
+                            .append(getAsStringFunction).append(" << '\"';\n");
+                    }
+                    else
+                    {
+                        sb.append(
+                            indent + "builder << '[';\n" +
+                            indent + "if (" + fieldName + "Length() > 0)\n" +
+                            indent + "{\n" +
+                            indent + "    for (size_t i = 0, length = static_cast<std::size_t>(" +
+                            fieldName + "Length()); i < length; i++)\n" +
+                            indent + "    {\n" +
+                            indent + "        if (i)\n" +
+                            indent + "        {\n" +
+                            indent + "            builder << ',';\n" +
+                            indent + "        }\n" +
+                            indent + "        builder << +" + fieldName + "(i);\n" +
+                            indent + "    }\n" +
+                            indent + "}\n" +
+                            indent + "builder << ']';\n");
+                    }
+                }
+                else
+                {
+                    if (typeToken.encoding().primitiveType() == PrimitiveType.CHAR)
+                    {
+                        sb.append(
+                            indent + "if (std::isprint(" + fieldName + "()))\n" +
+                            indent + "{\n" +
+                            indent + "    builder << '\"' << (char)" + fieldName + "() << '\"';\n" +
+                            indent + "}\n" +
+                            indent + "else\n" +
+                            indent + "{\n" +
+                            indent + "    builder << (int)" + fieldName + "();\n" +
+                            indent + "}\n");
+                    }
+                    else
+                    {
+                        sb.append(indent).append("builder << +").append(fieldName).append("();\n");
+                    }
+                }
+                break;
+
+            case BEGIN_ENUM:
+                sb.append(indent).append("builder << '\"' << ").append(fieldName).append("() << '\"';\n");
+                break;
+
+            case BEGIN_SET:
+            case BEGIN_COMPOSITE:
+                sb.append(indent).append("builder << ").append(fieldName).append("();\n");
+                break;
+
+            default:
+                break;
+        }
+
+        sb.append('\n');
+    }
+
+    private CharSequence generateChoicesDisplay(final String name, final List<Token> tokens)
+    {
+        final String indent = INDENT;
+        final StringBuilder sb = new StringBuilder();
+        final List<Token> choiceTokens = new ArrayList<>();
+
+        collect(Signal.CHOICE, tokens, 0, choiceTokens);
+
+        new Formatter(sb).format("\n" +
+            indent + "friend std::ostream& operator << (std::ostream& builder, %1$s writer)\n" +
+            indent + "{\n" +
+            indent + "    builder << '[';\n",
+            name);
+
+        if (choiceTokens.size() > 1)
+        {
+            sb.append(indent + "    bool atLeastOne = false;\n");
+        }
+
+        for (int i = 0, size = choiceTokens.size(); i < size; i++)
+        {
+            final Token token = choiceTokens.get(i);
+            final String choiceName = "writer." + formatPropertyName(token.name());
+
+            sb.append(indent + "    if (").append(choiceName).append("())\n")
+                .append(indent).append("    {\n");
+
+            if (i > 0)
+            {
+                sb.append(
+                    indent + "        if (atLeastOne)\n" +
+                    indent + "        {\n" +
+                    indent + "            builder << \",\";\n" +
+                    indent + "        }\n");
+            }
+            sb.append(indent + "        builder << " + jsonString(token.name(), "") + ";\n");
+
+            if (i < (size - 1))
+            {
+                sb.append(indent + "        atLeastOne = true;\n");
+            }
+
+            sb.append(indent + "    }\n");
+        }
+
+        sb.append(
+            indent + "    builder << ']';\n" +
+            indent + "    return builder;\n" +
+            indent + "}\n");
+
+        return sb;
     }
 
-    private CharSequence generateLiteral(final PrimitiveType type, final String value)
+    private CharSequence generateEnumDisplay(final List<Token> tokens, final Token encodingToken)
     {
-        String literal = "";
-
-        final String castType = cppTypeName(type);
-        switch (type)
-        {
-            case CHAR:
-            case UINT8:
-            case UINT16:
-            case INT8:
-            case INT16:
-                literal = "(" + castType + ")" + value;
-                break;
-
-            case UINT32:
-            {
-                final long intValue = Long.parseLong(value);
-                literal = "UINT32_C(0x" + Integer.toHexString((int)intValue) + ")";
-                break;
-            }
-            case INT32:
-                final long intValue = Long.parseLong(value);
-                if (intValue == Integer.MIN_VALUE)
-                {
-                    literal = "INT32_MIN";
-                }
-                else
-                {
-                    literal = "INT32_C(" + Long.toString(intValue) + ")";
-                }
-                break;
+        final String enumName = formatClassName(encodingToken.applicableTypeName());
+        final StringBuilder sb = new StringBuilder();
 
-            case FLOAT:
-                literal = value.endsWith("NaN") ? "SBE_FLOAT_NAN" : value + "f";
-                break;
+        new Formatter(sb).format("\n" +
+            "    static const char* c_str(const %1$s::Value value)\n" +
+            "    {\n" +
+            "        switch (value)\n" +
+            "        {\n",
+            enumName);
 
-            case INT64:
-                final long longValue = Long.parseLong(value);
-                if (longValue == Long.MIN_VALUE)
-                {
-                    literal = "INT64_MIN";
-                }
-                else
-                {
-                    literal = "INT64_C(" + String.valueOf(longValue) + ")";
-                }
-                break;
+        for (final Token token : tokens)
+        {
+            new Formatter(sb).format(
+                "            case %1$s: return \"%1$s\";\n",
+                token.name());
+        }
 
-            case UINT64:
-                literal = "UINT64_C(0x" + Long.toHexString(Long.parseLong(value)) + ")";
-                break;
+        new Formatter(sb).format(
+            "            case NULL_VALUE: return \"NULL_VALUE\";\n" +
+            "        }\n\n" +
+            "        return sbe_throw_errnum(E103, \"unknown value for enum %1$s [E103]:\");\n" +
+            "    }\n\n" +
 
-            case DOUBLE:
-                literal = value.endsWith("NaN") ? "SBE_DOUBLE_NAN" : value;
-                break;
-        }
+            "    friend std::ostream& operator << (std::ostream& os, %1$s::Value m)\n" +
+            "    {\n" +
+            "        return os << %1$s::c_str(m);\n" +
+            "    }\n",
+            enumName);
 
-        return literal;
+        return sb;
     }
 
-    public static String jsonString(final String token, final String suffix)
+    private static String sinkAppend(final String text)
     {
-        /* "\"color\"" */
-        /* "\"color\": " */
-        /* "\"color\", " */
-        return String.format("\"\\\"%1$s\\\"%2$s\"", token, suffix);
+        return "sink.append(\"" + text.replace("\\", "\\\\").replace("\"", "\\\"") + "\", " + text.length() + ");";
     }
 
-    private void generateDisplay(
+    private void generateAppendJson(
         final StringBuilder sb,
         final MessageItem messageItem)
     {
         new Formatter(sb).format("\n" +
-            INDENT + "friend std::ostream& operator << (std::ostream& builder, %1$s _writer)\n" +
+            INDENT + "template <typename Sink>\n" +
+            INDENT + "void appendJson(Sink &sink) const\n" +
             INDENT + "{\n" +
-            INDENT + "    %1$s writer(_writer.m_buffer, _writer.m_offset,\n" +
-            INDENT + "        _writer.m_bufferLength, _writer.sbeBlockLength(), _writer.m_actingVersion);\n" +
-            INDENT + "    builder << '{';\n" +
-            INDENT + "    builder << " + jsonString("Name", ": ") + " << " + jsonString("%2$s", ", ") + ";\n" +
-            INDENT + "    builder << " + jsonString("sbeTemplateId", ": ") + ";\n" +
-            INDENT + "    builder << writer.sbeTemplateId();\n" +
-            INDENT + "    builder << \", \";\n\n" +
+            INDENT + "    %1$s writer(m_buffer, m_offset, m_bufferLength, sbeBlockLength(), m_actingVersion);\n" +
+            INDENT + "    %2$s\n\n" +
             "%3$s" +
-            INDENT + "    builder << '}';\n\n" +
-            INDENT + "    return builder;\n" +
+            INDENT + "    sink.append(\"}\", 1);\n" +
             INDENT + "}\n",
             messageItemFullClassName(messageItem),
-            messageItemClassName(messageItem),
-            appendDisplay(messageItem, INDENT + INDENT));
+            sinkAppend("{\"Name\": \"" + messageItemClassName(messageItem) + "\", \"sbeTemplateId\": " +
+                messageItem.rootToken.id() + ", "),
+            appendJsonBody(messageItem, INDENT + INDENT));
     }
 
-    private void generateGroupDisplay(
+    private void generateGroupAppendJson(
         final StringBuilder sb,
         final MessageItem messageItem,
         final String indent)
     {
+        final CharSequence body = appendJsonBody(messageItem, indent + INDENT);
+
         formatter(sb).format("\n" +
-            indent + "friend std::ostream& operator << (std::ostream& builder, %1$s writer)\n" +
+            indent + "template <typename Sink>\n" +
+            indent + "void appendJson(Sink &sink)\n" +
             indent + "{\n" +
-            indent + "    builder << '{';\n" +
+            "%1$s" +
+            indent + "    sink.append(\"{\", 1);\n" +
             "%2$s" +
-            indent + "    builder << '}';\n\n" +
-            indent + "    return builder;\n" +
+            indent + "    sink.append(\"}\", 1);\n" +
             indent + "}\n",
-            messageItemFullClassName(messageItem),
-            appendDisplay(messageItem, indent + INDENT));
+            body.length() > 0 ? indent + "    " + messageItemFullClassName(messageItem) + " &writer = *this;\n" : "",
+            body);
     }
 
-    private CharSequence generateCompositeDisplay(final String name, final List<Token> tokens)
+    private CharSequence generateCompositeAppendJson(final String name, final List<Token> tokens)
     {
+        final CharSequence body = appendJsonBody(new MessageItem(tokens, new ArrayList<Token>()), INDENT + INDENT);
+
         return String.format("\n" +
-            INDENT + "friend std::ostream& operator << (std::ostream& builder, %1$s writer)\n" +
+            INDENT + "template <typename Sink>\n" +
+            INDENT + "void appendJson(Sink &sink) const\n" +
             INDENT + "{\n" +
-            INDENT + "    builder << '{';\n" +
-            INDENT + "%2$s" +
-            INDENT + "    builder << '}';\n\n" +
-            INDENT + "    return builder;\n" +
+            "%1$s" +
+            INDENT + "    sink.append(\"{\", 1);\n" +
+            "%2$s" +
+            INDENT + "    sink.append(\"}\", 1);\n" +
             INDENT + "}\n\n",
-            formatClassName(name),
-            appendDisplay(new MessageItem(tokens, new ArrayList<Token>()), INDENT + INDENT)
-        );
+            body.length() > 0 ? INDENT + "    " + formatClassName(name) + " writer(*this);\n" : "",
+            body);
     }
 
-    private CharSequence appendDisplay(
-        final MessageItem messageItem, final String indent)
+    private CharSequence appendJsonBody(final MessageItem messageItem, final String indent)
     {
         final StringBuilder sb = new StringBuilder();
         final boolean[] atLeastOne = { false };
@@ -2496,7 +4558,7 @@ public class CppGenerator implements CodeGenerator
             final Token fieldToken = messageItem.fields.get(i);
             final Token encodingToken = messageItem.fields.get(fieldToken.signal() == Signal.BEGIN_FIELD ? i + 1 : i);
 
-            writeTokenDisplay(sb, fieldToken.name(), encodingToken, atLeastOne, indent);
+            writeTokenJson(sb, fieldToken.name(), encodingToken, atLeastOne, indent);
             i += fieldToken.componentTokenCount();
         }
 
@@ -2511,30 +4573,30 @@ public class CppGenerator implements CodeGenerator
 
             if (atLeastOne[0])
             {
-                sb.append(indent).append("builder << \", \";\n");
+                sb.append(indent).append(sinkAppend(", ")).append("\n");
             }
             atLeastOne[0] = true;
 
             new Formatter(sb).format(
                 indent + "{\n" +
                 indent + "    bool atLeastOne = false;\n" +
-                indent + "    builder << " + jsonString("%3$s", ": [") + ";\n" +
-                indent + "    %1$s& %2$s = writer.%2$s();\n" +
-                indent + "    while(%2$s.hasNext())\n" +
+                indent + "    %3$s\n" +
+                indent + "    %1$s &%2$s = writer.%2$s();\n" +
+                indent + "    while (%2$s.hasNext())\n" +
                 indent + "    {\n" +
                 indent + "        %2$s.next();\n" +
                 indent + "        if (atLeastOne)\n" +
                 indent + "        {\n" +
-                indent + "            builder << \", \";\n" +
+                indent + "            sink.append(\", \", 2);\n" +
                 indent + "        }\n" +
                 indent + "        atLeastOne = true;\n" +
-                indent + "        builder << %2$s;\n" +
-                indent + "    };\n" +
-                indent + "    builder << ']';\n" +
+                indent + "        %2$s.appendJson(sink);\n" +
+                indent + "    }\n" +
+                indent + "    sink.append(\"]\", 1);\n" +
                 indent + "}\n\n",
                 messageItemFullClassName(child),
                 formatPropertyName(groupToken.name()),
-                groupToken.name());
+                sinkAppend("\"" + groupToken.name() + "\": ["));
         }
 
         for (int i = 0, size = messageItem.varData.size(); i < size;)
@@ -2547,27 +4609,34 @@ public class CppGenerator implements CodeGenerator
 
             if (atLeastOne[0])
             {
-                sb.append(indent).append("builder << \", \";\n");
+                sb.append(indent).append(sinkAppend(", ")).append("\n");
             }
             atLeastOne[0] = true;
 
             final String characterEncoding = messageItem.varData.get(i + 3).encoding().characterEncoding();
-            sb.append(indent).append("builder << " + jsonString(varDataToken.name(), ": ") + ";\n");
+            final String propertyName = toUpperFirstChar(varDataToken.name());
+            sb.append(indent).append(sinkAppend("\"" + varDataToken.name() + "\": ")).append("\n");
 
             if (null == characterEncoding)
             {
-                final String skipFunction = "writer.skip" + toUpperFirstChar(varDataToken.name()) + "()";
-
-                sb.append(indent).append("builder << '\"' <<\n").append(indent).append(INDENT).append(skipFunction)
-                    .append(" << \" bytes of raw data\\\"\";\n");
+                new Formatter(sb).format(
+                    indent + "sink.append(\"\\\"\", 1);\n" +
+                    indent + "sbe_json_append_uint(sink, writer.%1$sSkip());\n" +
+                    indent + "%2$s\n\n",
+                    propertyName,
+                    sinkAppend(" bytes of raw data\""));
             }
             else
             {
-                final String getAsStringFunction =
-                    "writer.get" + toUpperFirstChar(varDataToken.name()) + "AsJsonEscapedString().c_str()";
-
-                sb.append(indent).append("builder << '\"' <<\n").append(indent).append(INDENT)
-                    .append(getAsStringFunction).append(" << '\"';\n\n");
+                new Formatter(sb).format(
+                    indent + "{\n" +
+                    indent + "    const std::uint64_t length = writer.%1$sLength();\n" +
+                    indent + "    sink.append(\"\\\"\", 1);\n" +
+                    indent + "    sbe_json_append_escaped(sink, writer.%2$s(), length);\n" +
+                    indent + "    sink.append(\"\\\"\", 1);\n" +
+                    indent + "}\n\n",
+                    toLowerFirstChar(propertyName),
+                    formatPropertyName(propertyName));
             }
 
             i += varDataToken.componentTokenCount();
@@ -2576,7 +4645,7 @@ public class CppGenerator implements CodeGenerator
         return sb;
     }
 
-    private void writeTokenDisplay(
+    private void writeTokenJson(
         final StringBuilder sb,
         final String fieldTokenName,
         final Token typeToken,
@@ -2590,76 +4659,61 @@ public class CppGenerator implements CodeGenerator
 
         if (atLeastOne[0])
         {
-            sb.append(indent).append("builder << \", \";\n");
+            sb.append(indent).append(sinkAppend(", ")).append("\n");
         }
         else
         {
             atLeastOne[0] = true;
         }
 
-        sb.append(indent).append("builder << ").append(jsonString(fieldTokenName, ": ")).append(";\n");
+        sb.append(indent).append(sinkAppend("\"" + fieldTokenName + "\": ")).append("\n");
         final String fieldName = "writer." + formatPropertyName(fieldTokenName);
 
         switch (typeToken.signal())
         {
             case ENCODING:
+            {
+                final PrimitiveType primitiveType = typeToken.encoding().primitiveType();
+
                 if (typeToken.arrayLength() > 1)
                 {
-                    if (typeToken.encoding().primitiveType() == PrimitiveType.CHAR)
+                    if (primitiveType == PrimitiveType.CHAR)
                     {
-                        final String getAsStringFunction =
-                            "writer.get" + toUpperFirstChar(fieldTokenName) + "AsJsonEscapedString().c_str()";
-
-                        sb.append(indent).append("builder << '\"' <<\n").append(indent).append(INDENT)
-                            .append(getAsStringFunction).append(" << '\"';\n");
+                        sb.append(indent).append("sbe_json_append_string(sink, ").append(fieldName).append("(), ")
+                            .append(typeToken.arrayLength()).append(");\n");
                     }
                     else
                     {
                         sb.append(
-                            indent + "builder << '[';\n" +
-                            indent + "if (" + fieldName + "Length() > 0)\n" +
+                            indent + "sink.append(\"[\", 1);\n" +
+                            indent + "for (std::uint64_t i = 0, length = " + fieldName + "Length(); " +
+                            "i < length; i++)\n" +
                             indent + "{\n" +
-                            indent + "    for (size_t i = 0, length = static_cast<std::size_t>(" +
-                            fieldName + "Length()); i < length; i++)\n" +
+                            indent + "    if (i)\n" +
                             indent + "    {\n" +
-                            indent + "        if (i)\n" +
-                            indent + "        {\n" +
-                            indent + "            builder << ',';\n" +
-                            indent + "        }\n" +
-                            indent + "        builder << +" + fieldName + "(i);\n" +
+                            indent + "        sink.append(\",\", 1);\n" +
                             indent + "    }\n" +
+                            indent + "    " + jsonAppendFunction(primitiveType) + "(sink, " + fieldName + "(i));\n" +
                             indent + "}\n" +
-                            indent + "builder << ']';\n");
+                            indent + "sink.append(\"]\", 1);\n");
                     }
                 }
                 else
                 {
-                    if (typeToken.encoding().primitiveType() == PrimitiveType.CHAR)
-                    {
-                        sb.append(
-                            indent + "if (std::isprint(" + fieldName + "()))\n" +
-                            indent + "{\n" +
-                            indent + "    builder << '\"' << (char)" + fieldName + "() << '\"';\n" +
-                            indent + "}\n" +
-                            indent + "else\n" +
-                            indent + "{\n" +
-                            indent + "    builder << (int)" + fieldName + "();\n" +
-                            indent + "}\n");
-                    }
-                    else
-                    {
-                        sb.append(indent).append("builder << +").append(fieldName).append("();\n");
-                    }
+                    sb.append(indent).append(jsonAppendFunction(primitiveType))
+                        .append("(sink, ").append(fieldName).append("());\n");
                 }
                 break;
+            }
 
             case BEGIN_ENUM:
-                sb.append(indent).append("builder << '\"' << ").append(fieldName).append("() << '\"';\n");
+                sb.append(indent).append(formatClassName(typeToken.applicableTypeName()))
+                    .append("::appendJson(sink, ").append(fieldName).append("());\n");
                 break;
 
             case BEGIN_SET:
             case BEGIN_COMPOSITE:
-                sb.append(indent).append("builder << ").append(fieldName).append("();\n");
+                sb.append(indent).append(fieldName).append("().appendJson(sink);\n");
                 break;
 
             default:
@@ -2669,7 +4723,29 @@ public class CppGenerator implements CodeGenerator
         sb.append('\n');
     }
 
-    private CharSequence generateChoicesDisplay(final String name, final List<Token> tokens)
+    private static String jsonAppendFunction(final PrimitiveType primitiveType)
+    {
+        switch (primitiveType)
+        {
+            case CHAR:
+                return "sbe_json_append_char";
+
+            case INT8:
+            case INT16:
+            case INT32:
+            case INT64:
+                return "sbe_json_append_int";
+
+            case FLOAT:
+            case DOUBLE:
+                return "sbe_json_append_double";
+
+            default:
+                return "sbe_json_append_uint";
+        }
+    }
+
+    private CharSequence generateChoicesAppendJson(final List<Token> tokens)
     {
         final String indent = INDENT;
         final StringBuilder sb = new StringBuilder();
@@ -2677,11 +4753,11 @@ public class CppGenerator implements CodeGenerator
 
         collect(Signal.CHOICE, tokens, 0, choiceTokens);
 
-        new Formatter(sb).format("\n" +
-            indent + "friend std::ostream& operator << (std::ostream& builder, %1$s writer)\n" +
+        sb.append("\n" +
+            indent + "template <typename Sink>\n" +
+            indent + "void appendJson(Sink &sink) const\n" +
             indent + "{\n" +
-            indent + "    builder << '[';\n",
-            name);
+            indent + "    sink.append(\"[\", 1);\n");
 
         if (choiceTokens.size() > 1)
         {
@@ -2691,9 +4767,8 @@ public class CppGenerator implements CodeGenerator
         for (int i = 0, size = choiceTokens.size(); i < size; i++)
         {
             final Token token = choiceTokens.get(i);
-            final String choiceName = "writer." + formatPropertyName(token.name());
 
-            sb.append(indent + "    if (").append(choiceName).append("())\n")
+            sb.append(indent + "    if (").append(formatPropertyName(token.name())).append("())\n")
                 .append(indent).append("    {\n");
 
             if (i > 0)
@@ -2701,10 +4776,10 @@ public class CppGenerator implements CodeGenerator
                 sb.append(
                     indent + "        if (atLeastOne)\n" +
                     indent + "        {\n" +
-                    indent + "            builder << \",\";\n" +
+                    indent + "            sink.append(\",\", 1);\n" +
                     indent + "        }\n");
             }
-            sb.append(indent + "        builder << " + jsonString(token.name(), "") + ";\n");
+            sb.append(indent + "        ").append(sinkAppend("\"" + token.name() + "\"")).append("\n");
 
             if (i < (size - 1))
             {
@@ -2715,20 +4790,20 @@ public class CppGenerator implements CodeGenerator
         }
 
         sb.append(
-            indent + "    builder << ']';\n" +
-            indent + "    return builder;\n" +
+            indent + "    sink.append(\"]\", 1);\n" +
             indent + "}\n");
 
         return sb;
     }
 
-    private CharSequence generateEnumDisplay(final List<Token> tokens, final Token encodingToken)
+    private CharSequence generateEnumAppendJson(final List<Token> tokens, final Token encodingToken)
     {
         final String enumName = formatClassName(encodingToken.applicableTypeName());
         final StringBuilder sb = new StringBuilder();
 
         new Formatter(sb).format("\n" +
-            "    static const char* c_str(const %1$s::Value value)\n" +
+            "    template <typename Sink>\n" +
+            "    static void appendJson(Sink &sink, const %1$s::Value value)\n" +
             "    {\n" +
             "        switch (value)\n" +
             "        {\n",
@@ -2737,21 +4812,21 @@ public class CppGenerator implements CodeGenerator
         for (final Token token : tokens)
         {
             new Formatter(sb).format(
-                "            case %1$s: return \"%1$s\";\n",
-                token.name());
+                "            case %1$s: %2$s return;\n",
+                token.name(),
+                sinkAppend("\"" + token.name() + "\""));
         }
 
         new Formatter(sb).format(
-            "            case NULL_VALUE: return \"NULL_VALUE\";\n" +
+            "            case NULL_VALUE: %2$s return;\n" +
             "        }\n\n" +
-            "        return sbe_throw_errnum(E103, \"unknown value for enum %1$s [E103]:\");\n" +
-            "    }\n\n" +
-
-            "    friend std::ostream& operator << (std::ostream& os, %1$s::Value m)\n" +
-            "    {\n" +
-            "        return os << %1$s::c_str(m);\n" +
+            "        const char *message = sbe_throw_errnum(E103, \"unknown value for enum %1$s [E103]:\");\n" +
+            "        sink.append(\"\\\"\", 1);\n" +
+            "        sink.append(message, std::strlen(message));\n" +
+            "        sink.append(\"\\\"\", 1);\n" +
             "    }\n",
-            enumName);
+            enumName,
+            sinkAppend("\"NULL_VALUE\""));
 
         return sb;
     }
@@ -2842,21 +4917,32 @@ public class CppGenerator implements CodeGenerator
                     indent + "sbe_vector_view<const %1$sLengthParam> %2$s;\n", memberClassName, propertyName);
             }
 
-            new Formatter(sbSkip).format(
-                indent + "    %1$s& %2$s = this->%2$s();\n" +
-                indent + "    while(%2$s.hasNext())\n" +
-                indent + "    {\n" +
-                indent + "        %2$s.next();\n" +
-                indent + "        %2$s.skip();\n" +
-                indent + "    };\n",
-                memberClassName,
-                formatPropertyName(groupToken.name()),
-                groupToken.name());
+            if (childIsConstant)
+            {
+                new Formatter(sbSkip).format(
+                    indent + "    this->%1$s().elements();\n",
+                    formatPropertyName(groupToken.name()));
+            }
+            else
+            {
+                new Formatter(sbSkip).format(
+                    indent + "    %1$s& %2$s = this->%2$s();\n" +
+                    indent + "    while(%2$s.hasNext())\n" +
+                    indent + "    {\n" +
+                    indent + "        %2$s.next();\n" +
+                    indent + "        %2$s.skip();\n" +
+                    indent + "    };\n",
+                    memberClassName,
+                    formatPropertyName(groupToken.name()),
+                    groupToken.name());
+            }
         }
 
         final String className = messageItemFullClassName(messageItem);
         /* First, fixed size fields */
         generateFields(sb, className, messageItem.fields, parentIndent);
+        generateFieldReflection(sb, messageItem.fields, parentIndent);
+        generateStructOverlay(sb, className, messageItem, parentIndent);
         /* Second, var size groups */
         sb.append(sbGroupProperties);
         /* Third, var size data */
@@ -2897,10 +4983,12 @@ public class CppGenerator implements CodeGenerator
         if (messageItem.rootToken.signal() == Signal.BEGIN_GROUP)
         {
             generateGroupDisplay(sb, messageItem, indent);
+            generateGroupAppendJson(sb, messageItem, indent);
         }
         else
         {
             generateDisplay(sb, messageItem);
+            generateAppendJson(sb, messageItem);
         }
 
         new Formatter(sb).format("\n" +
@@ -48,4 +48,53 @@ TEST(ByteOrder, encoded_data_view_set_get) {
     valDirectOut = *(int16_t*)view_le.data;
     EXPECT_EQ(val == valDirectOut, __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__);
     EXPECT_EQ(valDirectOut, SBE_LITTLE_ENDIAN_ENCODE_16(val));
-}
\ No newline at end of file
+}
+
+TEST(ByteOrder, encoded_data_view_set_get_range) {
+    uint16_t in16[257], out16[257], buffer16[257];
+    uint32_t in32[257], out32[257], buffer32[257];
+    uint64_t in64[257], out64[257], buffer64[257];
+    sbe_uint16_view_be view16;
+    sbe_uint32_view_be view32;
+    sbe_uint64_view_be view64;
+
+    for (uint64_t i = 0; i < 257; i++)
+    {
+        in16[i] = (uint16_t)(i * 0x0103u);
+        in32[i] = (uint32_t)(i * 0x01030507u);
+        in64[i] = i * 0x0103050709111315ull;
+    }
+
+    view16.data = buffer16;
+    view16.length = 257;
+    view32.data = buffer32;
+    view32.length = 257;
+    view64.data = buffer64;
+    view64.length = 257;
+
+    for (uint64_t offset = 0; offset < 9; offset++)
+    {
+        const uint64_t len = 257 - offset;
+
+        memset(out16, 0, sizeof(out16));
+        memset(out32, 0, sizeof(out32));
+        memset(out64, 0, sizeof(out64));
+
+        EXPECT_EQ(sbe_uint16_view_be_set_range(view16, in16, offset, len), true);
+        EXPECT_EQ(sbe_uint32_view_be_set_range(view32, in32, offset, len), true);
+        EXPECT_EQ(sbe_uint64_view_be_set_range(view64, in64, offset, len), true);
+        EXPECT_EQ(sbe_uint16_view_be_get_range(view16, out16, offset, len + 1), len);
+        EXPECT_EQ(sbe_uint32_view_be_get_range(view32, out32, offset, len + 1), len);
+        EXPECT_EQ(sbe_uint64_view_be_get_range(view64, out64, offset, len + 1), len);
+
+        for (uint64_t i = offset; i < 257; i++)
+        {
+            EXPECT_EQ(buffer16[i], SBE_BIG_ENDIAN_ENCODE_16(in16[i]));
+            EXPECT_EQ(buffer32[i], SBE_BIG_ENDIAN_ENCODE_32(in32[i]));
+            EXPECT_EQ(buffer64[i], SBE_BIG_ENDIAN_ENCODE_64(in64[i]));
+            EXPECT_EQ(out16[i], in16[i]);
+            EXPECT_EQ(out32[i], in32[i]);
+            EXPECT_EQ(out64[i], in64[i]);
+        }
+    }
+}
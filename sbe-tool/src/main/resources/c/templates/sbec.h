@@ -37,10 +37,34 @@
 #define SBE_BOUNDS_CHECK_EXPECT(exp, c) (__builtin_expect(exp, c))
 #endif /* !SBE_NO_BOUNDS_CHECK */
 
+/*
+ * Define SBE_NO_EXCEPTIONS for errors to set errno and have the codec return a default rather than throw. A flyweight
+ * which fails to wrap is left empty so later reads fail rather than run past the buffer. The std::error_code
+ * overloads report errors without errno or exceptions in any mode.
+ */
+
+#if defined(__cplusplus) && (defined(__GNUC__) || defined(__clang__))
+#define SBE_COLD __attribute__((cold, noinline))
+#elif defined(__cplusplus) && defined(_MSC_VER)
+#define SBE_COLD __declspec(noinline)
+#else
+#define SBE_COLD
+#endif
+
 #if defined(_MSC_VER)
 #include <intrin.h>
 #endif
 
+/*
+ * Vectorised byte swapping of ranges for x86 GCC and Clang, selected at runtime by CPU support.
+ * Define SBE_NO_SIMD to use only the scalar loops.
+ */
+#if !defined(SBE_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) && !defined(__DCC__) && \
+    ((defined(__clang__) && __clang_major__ >= 4) || (!defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 6))
+#define SBE_SIMD_BYTE_ORDER 1
+#include <immintrin.h>
+#endif
+
 #if (defined(_MSC_VER) && (_MSC_VER < 1800)) || defined(__DCC__)
 #ifndef __bool_true_false_are_defined
 #define __bool_true_false_are_defined 1
@@ -250,17 +274,33 @@ typedef unsigned char _Bool;
 
 /* For byte order buffers */
 
-#define _SBE_BYTE_ORDER_BUFFER_UNSAFE_SET_RANGE(view, data_copy_from, offset, len, byte_order_encode, data_type_encode) \
+#define _SBE_BYTE_ORDER_COPY_RANGE(dst, src, count, byte_order_encode, data_type_encode) \
+    if (byte_order_encode((data_type_encode)1) == (data_type_encode)1) \
+    { \
+        memcpy((void*)(dst), (const void*)(src), (size_t)(count) * sizeof(data_type_encode)); \
+    } \
+    else \
     { \
-        uint64_t i; \
-        for (i = offset; i < offset + len; i += 1) \
+        uint64_t j = sbe_byte_order_swap_bulk((void*)(dst), (const void*)(src), count, sizeof(data_type_encode)); \
+        for (; j < (count); j += 1) \
         { \
-            data_type_encode tmp = ((data_type_encode*)(data_copy_from))[i]; \
+            data_type_encode tmp; \
+            memcpy(&tmp, (const data_type_encode*)(src) + j, sizeof(tmp)); \
             tmp = byte_order_encode(tmp); \
-            memcpy((void*)((data_type_encode*)(view.data) + i), (void*)&tmp, sizeof(tmp)); \
+            memcpy((void*)((data_type_encode*)(dst) + j), (void*)&tmp, sizeof(tmp)); \
         } \
     }
 
+#define _SBE_BYTE_ORDER_BUFFER_UNSAFE_SET_RANGE(view, data_copy_from, offset, len, byte_order_encode, data_type_encode) \
+    { \
+        _SBE_BYTE_ORDER_COPY_RANGE( \
+            (data_type_encode*)(view.data) + offset, \
+            (const data_type_encode*)(data_copy_from) + offset, \
+            len, \
+            byte_order_encode, \
+            data_type_encode) \
+    }
+
 #define _SBE_BYTE_ORDER_BUFFER_SAFE_SET_RANGE(view, data_copy_from, offset, len, byte_order_encode, data_type_encode) \
     if (view.data == NULL || offset + len > view.length || data_copy_from == NULL) \
     { \
@@ -288,13 +328,12 @@ typedef unsigned char _Bool;
     { \
         uint64_t len_capable_copy = view.length - offset; \
         uint64_t len_to_copy = len_capable_copy < len ? len_capable_copy : len; \
-        uint64_t i; \
-        for (i = offset; i < offset + len_to_copy; i += 1) \
-        { \
-            data_type_encode tmp; \
-            memcpy(&tmp, ((data_type_encode*)(view.data)) + i, sizeof(tmp)); \
-            *(data_type_encode*)(data_copy_to + i) = byte_order_encode(tmp); \
-        } \
+        _SBE_BYTE_ORDER_COPY_RANGE( \
+            (data_type_encode*)(data_copy_to + offset), \
+            (const data_type_encode*)(view.data) + offset, \
+            len_to_copy, \
+            byte_order_encode, \
+            data_type_encode) \
         return len_to_copy; \
     } \
 
@@ -324,6 +363,7 @@ typedef unsigned char _Bool;
 
 #include <cctype>
 #include <cstddef>
+#include <cstdio>
 #include <cstring>
 #include <iomanip>
 #include <sstream>
@@ -353,6 +393,10 @@ typedef unsigned char _Bool;
 #include <vector>
 #endif
 
+#if __cplusplus >= 201103L
+#include <system_error>
+#endif
+
 #if defined(_SBE_HAVE_CSTDINT)
 #include <cstdint>
 #endif
@@ -422,6 +466,161 @@ typedef uint64_t uint64_t;
 
 #endif /* !__cplusplus */
 
+#if defined(SBE_SIMD_BYTE_ORDER)
+
+#define SBE_SIMD_KERNEL(isa) static __attribute__((target(isa), unused))
+
+/* pshufb masks reversing each 2, 4, and 8 byte element of a 16 byte lane, indexed by width >> 2 */
+static const uint8_t sbe_byte_order_shuffle[3][16] __attribute__((unused)) =
+{
+    { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 },
+    { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 },
+    { 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 }
+};
+
+SBE_SIMD_KERNEL("ssse3") uint64_t sbe_byte_order_swap_ssse3(
+    uint8_t *dst, const uint8_t *src, uint64_t length, size_t width)
+{
+    const __m128i mask = _mm_loadu_si128((const __m128i*)sbe_byte_order_shuffle[width >> 2]);
+    uint64_t i;
+
+    for (i = 0; i + 16 <= length; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_shuffle_epi8(v, mask));
+    }
+
+    return i;
+}
+
+SBE_SIMD_KERNEL("avx2") uint64_t sbe_byte_order_swap_avx2(
+    uint8_t *dst, const uint8_t *src, uint64_t length, size_t width)
+{
+    const __m256i mask = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i*)sbe_byte_order_shuffle[width >> 2]));
+    uint64_t i;
+
+    for (i = 0; i + 64 <= length; i += 64)
+    {
+        __m256i v0 = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i v1 = _mm256_loadu_si256((const __m256i*)(src + i + 32));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_shuffle_epi8(v0, mask));
+        _mm256_storeu_si256((__m256i*)(dst + i + 32), _mm256_shuffle_epi8(v1, mask));
+    }
+
+    for (; i + 32 <= length; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_shuffle_epi8(v, mask));
+    }
+
+    return i;
+}
+
+SBE_SIMD_KERNEL("avx512f,avx512bw") uint64_t sbe_byte_order_swap_avx512(
+    uint8_t *dst, const uint8_t *src, uint64_t length, size_t width)
+{
+    uint8_t lanes[64];
+    __m512i mask;
+    uint64_t i;
+
+    for (i = 0; i < 64; i += 16)
+    {
+        memcpy(lanes + i, sbe_byte_order_shuffle[width >> 2], 16);
+    }
+    mask = _mm512_loadu_si512((const void*)lanes);
+
+    for (i = 0; i + 64 <= length; i += 64)
+    {
+        __m512i v = _mm512_loadu_si512((const void*)(src + i));
+        _mm512_storeu_si512((void*)(dst + i), _mm512_shuffle_epi8(v, mask));
+    }
+
+    if (i < length)
+    {
+        __mmask64 tail = (__mmask64)(~UINT64_C(0) >> (64 - (length - i)));
+        __m512i v = _mm512_maskz_loadu_epi8(tail, (const void*)(src + i));
+        _mm512_mask_storeu_epi8((void*)(dst + i), tail, _mm512_shuffle_epi8(v, mask));
+        i = length;
+    }
+
+    return i;
+}
+
+static __attribute__((unused)) uint64_t sbe_byte_order_swap_none(
+    uint8_t *dst, const uint8_t *src, uint64_t length, size_t width)
+{
+    (void)dst;
+    (void)src;
+    (void)length;
+    (void)width;
+
+    return 0;
+}
+
+typedef uint64_t (*sbe_byte_order_swap_kernel)(uint8_t *dst, const uint8_t *src, uint64_t length, size_t width);
+
+static __attribute__((unused)) sbe_byte_order_swap_kernel sbe_byte_order_swap_resolve(void)
+{
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512bw"))
+    {
+        return sbe_byte_order_swap_avx512;
+    }
+
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return sbe_byte_order_swap_avx2;
+    }
+
+    if (__builtin_cpu_supports("ssse3"))
+    {
+        return sbe_byte_order_swap_ssse3;
+    }
+
+    return sbe_byte_order_swap_none;
+}
+
+#endif /* SBE_SIMD_BYTE_ORDER */
+
+/*
+ * Byte swap as many leading elements of width 2, 4, or 8 from src into dst as the widest instructions the CPU
+ * supports allow, returning the number of elements swapped. The remainder is left to the caller. Returns 0 when built
+ * without SBE_SIMD_BYTE_ORDER.
+ */
+SBE_ONE_DEF uint64_t sbe_byte_order_swap_bulk(void *dst, const void *src, uint64_t count, size_t width)
+{
+#if defined(SBE_SIMD_BYTE_ORDER)
+    uint64_t length = count * width;
+
+    /* the kernel is resolved once as querying the CPU features costs more than swapping a short array */
+    static sbe_byte_order_swap_kernel resolved_kernel = NULL;
+    sbe_byte_order_swap_kernel kernel;
+
+    if (length < 16)
+    {
+        return 0;
+    }
+
+    kernel = __atomic_load_n(&resolved_kernel, __ATOMIC_RELAXED);
+    if (NULL == kernel)
+    {
+        kernel = sbe_byte_order_swap_resolve();
+        __atomic_store_n(&resolved_kernel, kernel, __ATOMIC_RELAXED);
+    }
+
+    return kernel((uint8_t*)dst, (const uint8_t*)src, length, width) / width;
+#else
+    (void)dst;
+    (void)src;
+    (void)count;
+    (void)width;
+#endif
+
+    return 0;
+}
+
 union sbe_float_as_uint
 {
     float fp_value;
@@ -473,6 +672,56 @@ enum sbe_meta_attribute
 
 typedef enum sbe_meta_attribute sbe_meta_attribute;
 
+enum sbe_primitive_type
+{
+    sbe_primitive_type_NONE,
+    sbe_primitive_type_CHAR,
+    sbe_primitive_type_INT8,
+    sbe_primitive_type_INT16,
+    sbe_primitive_type_INT32,
+    sbe_primitive_type_INT64,
+    sbe_primitive_type_UINT8,
+    sbe_primitive_type_UINT16,
+    sbe_primitive_type_UINT32,
+    sbe_primitive_type_UINT64,
+    sbe_primitive_type_FLOAT,
+    sbe_primitive_type_DOUBLE
+};
+
+typedef enum sbe_primitive_type sbe_primitive_type;
+
+enum sbe_byte_order
+{
+    sbe_byte_order_LITTLE_ENDIAN,
+    sbe_byte_order_BIG_ENDIAN
+};
+
+typedef enum sbe_byte_order sbe_byte_order;
+
+enum sbe_presence
+{
+    sbe_presence_REQUIRED,
+    sbe_presence_OPTIONAL,
+    sbe_presence_CONSTANT
+};
+
+typedef enum sbe_presence sbe_presence;
+
+/* Structure of a field, primitive_type being that of the encoding of enums and sets, or NONE for composites. */
+struct sbe_field_descriptor
+{
+    const char *name;
+    uint16_t id;
+    uint64_t offset;
+    uint64_t encoded_length;
+    sbe_primitive_type primitive_type;
+    sbe_byte_order byte_order;
+    uint64_t since_version;
+    sbe_presence presence;
+};
+
+typedef struct sbe_field_descriptor sbe_field_descriptor;
+
 #define SBE_NULLVALUE_INT8 INT8_MIN
 #define SBE_NULLVALUE_INT16 INT16_MIN
 #define SBE_NULLVALUE_INT32 INT32_MIN
@@ -491,6 +740,8 @@ typedef enum sbe_meta_attribute sbe_meta_attribute;
 #define E108 -50108 /* BUF_SHORT_NXT_GRP_IND */
 #define E109 -50109 /* STR_TOO_LONG_FOR_LEN_TYP */
 #define E110 -50110 /* CNT_OUT_RANGE */
+#define E111 -50111 /* VAL_OUT_RANGE */
+#define E112 -50112 /* IDX_CAPACITY */
 
 SBE_ONE_DEF const char *sbe_strerror(const int errnum)
 {
@@ -514,15 +765,19 @@ SBE_ONE_DEF const char *sbe_strerror(const int errnum)
         return "std::string too long for length type";
     case E110:
         return "count outside of allowed range";
+    case E111:
+        return "value outside of allowed range";
+    case E112:
+        return "offset index capacity exceeded";
     default:
         return "unknown error";
     }
 }
 
-SBE_ONE_DEF const char *sbe_throw_errnum(const int errnum, const char *message)
+SBE_ONE_DEF SBE_COLD const char *sbe_throw_errnum(const int errnum, const char *message)
 {
     errno = errnum;
-#if !defined(__vxworks) && defined(__cplusplus)
+#if !defined(__vxworks) && !defined(SBE_NO_EXCEPTIONS) && defined(__cplusplus)
     throw std::runtime_error(message);
 #endif
     return message;
@@ -679,6 +934,146 @@ size_t sbe_array_size(const T (&)[S])
     return S;
 }
 
+/*
+ * JSON formatting for the generated appendJson methods. A Sink is any character buffer with
+ * append(const char *data, size_t length), such as std::string. Nothing is allocated beyond what the
+ * sink itself allocates to grow, and values are formatted as the generated operator << writes them.
+ */
+template <typename Sink>
+void sbe_json_append_uint(Sink &sink, uint64_t value)
+{
+    static const char digit_pairs[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+    char digits[20];
+    char *end = digits + sizeof(digits);
+    char *start = end;
+
+    while (value >= 100)
+    {
+        const size_t pair = (size_t)(value % 100) * 2;
+        value /= 100;
+        *--start = digit_pairs[pair + 1];
+        *--start = digit_pairs[pair];
+    }
+
+    if (value >= 10)
+    {
+        *--start = digit_pairs[(size_t)value * 2 + 1];
+        *--start = digit_pairs[(size_t)value * 2];
+    }
+    else
+    {
+        *--start = (char)('0' + value);
+    }
+
+    sink.append(start, (size_t)(end - start));
+}
+
+template <typename Sink>
+void sbe_json_append_int(Sink &sink, int64_t value)
+{
+    if (value < 0)
+    {
+        sink.append("-", 1);
+        sbe_json_append_uint(sink, (uint64_t)0 - (uint64_t)value);
+    }
+    else
+    {
+        sbe_json_append_uint(sink, (uint64_t)value);
+    }
+}
+
+/* Same as the default std::ostream formatting of float and double. */
+template <typename Sink>
+void sbe_json_append_double(Sink &sink, double value)
+{
+    char digits[32];
+    const int length = snprintf(digits, sizeof(digits), "%g", value);
+
+    sink.append(digits, (size_t)length);
+}
+
+/* Appends the bytes escaped for a JSON string, without quotes, copying each run needing no escape at once. */
+template <typename Sink>
+void sbe_json_append_escaped(Sink &sink, const char *value, uint64_t length)
+{
+    static const char hex_digits[] = "0123456789abcdef";
+    uint64_t run_start = 0;
+
+    if (0 == length)
+    {
+        return;
+    }
+
+    for (uint64_t i = 0; i < length; i++)
+    {
+        const unsigned char c = (unsigned char)value[i];
+
+        if (c >= 0x20 && c != '"' && c != '\\')
+        {
+            continue;
+        }
+
+        sink.append(value + run_start, (size_t)(i - run_start));
+        run_start = i + 1;
+
+        switch (c)
+        {
+            case '"': sink.append("\\\"", 2); break;
+            case '\\': sink.append("\\\\", 2); break;
+            case '\b': sink.append("\\b", 2); break;
+            case '\f': sink.append("\\f", 2); break;
+            case '\n': sink.append("\\n", 2); break;
+            case '\r': sink.append("\\r", 2); break;
+            case '\t': sink.append("\\t", 2); break;
+
+            default:
+            {
+                const char escaped[6] = { '\\', 'u', '0', '0', hex_digits[c >> 4], hex_digits[c & 0xF] };
+                sink.append(escaped, sizeof(escaped));
+                break;
+            }
+        }
+    }
+
+    sink.append(value + run_start, (size_t)(length - run_start));
+}
+
+/* Appends a fixed length char array up to its first NUL, quoted and escaped. */
+template <typename Sink>
+void sbe_json_append_string(Sink &sink, const char *value, uint64_t max_length)
+{
+    uint64_t length = 0;
+
+    if (NULL != value)
+    {
+        const void *nul = memchr(value, '\0', (size_t)max_length);
+        length = NULL != nul ? (uint64_t)((const char *)nul - value) : max_length;
+    }
+
+    sink.append("\"", 1);
+    sbe_json_append_escaped(sink, value, length);
+    sink.append("\"", 1);
+}
+
+/* Appends a single char quoted if printable, otherwise as its integer value. */
+template <typename Sink>
+void sbe_json_append_char(Sink &sink, char value)
+{
+    if (value >= 0x20 && value < 0x7F)
+    {
+        sink.append("\"", 1);
+        sbe_json_append_escaped(sink, &value, 1);
+        sink.append("\"", 1);
+    }
+    else
+    {
+        sbe_json_append_int(sink, (int64_t)value);
+    }
+}
+
 // the class to wrap a lambda expression
 template <typename TSelf, typename TLambda>
 class __sbe_LambdaWrapper
@@ -703,6 +1098,51 @@ void (*sbeLambda(const TLambda &rFunc))(TSelf, void *)
     return &__sbe_LambdaWrapper<TSelf, TLambda>::Exec;
 }
 
+/*
+ * Offsets of a decoded message filled in by its buildIndex, for reading its groups and var data in any order. The
+ * message and each group element has a record of sbeIndexWidth() entries: its offset and block length, the count and
+ * first element record of each group, then the offset of each var data, or UINT64_MAX when not in the acting version.
+ */
+template <std::size_t Capacity>
+struct sbe_offset_index
+{
+    std::uint64_t offsets[Capacity];
+    std::uint64_t length;
+};
+
+#if __cplusplus >= 201103L
+class sbe_error_category_impl : public std::error_category
+{
+public:
+    const char *name() const SBE_NOEXCEPT override
+    {
+        return "sbe";
+    }
+
+    std::string message(int errnum) const override
+    {
+        return sbe_strerror(errnum);
+    }
+};
+
+inline const std::error_category &sbe_error_category() SBE_NOEXCEPT
+{
+    static const sbe_error_category_impl category;
+    return category;
+}
+
+inline std::error_code sbe_make_error_code(const int errnum) SBE_NOEXCEPT
+{
+    return std::error_code(errnum, sbe_error_category());
+}
+
+/* Out of line so the error path of a std::error_code overload stays off the hot path. */
+SBE_COLD inline void sbe_set_error(std::error_code &ec, const int errnum) SBE_NOEXCEPT
+{
+    ec = sbe_make_error_code(errnum);
+}
+#endif
+
 #endif /* __cplusplus */
 
 /*
@@ -1008,3 +1008,42 @@ TEST_F(CodeGenTest, shouldBeAbleToUseStdStringMethodsForDecode)
 
     EXPECT_EQ(CGT(car_encoded_length)(&carDecoder), expectedCarEncodedLength);
 }
+
+TEST_F(CodeGenTest, shouldEncodeFixedBlockGroupFromColumns)
+{
+    const std::uint16_t mph[] = { perf1aMph, perf1bMph, perf1cMph };
+    const float seconds[] = { perf1aSeconds, perf1bSeconds, perf1cSeconds };
+    char buffer[64];
+    std::uint64_t pos = 0;
+
+    CGT(car_performanceFigures_acceleration) acc;
+    if (!CGT(car_performanceFigures_acceleration_wrap_for_encode)(
+        &acc, buffer, 3, &pos, CGT(car_sbe_schema_version)(), sizeof(buffer)))
+    {
+        throw std::runtime_error(sbe_strerror(errno));
+    }
+    if (!CGT(car_performanceFigures_acceleration_encode_columns)(&acc, mph, seconds))
+    {
+        throw std::runtime_error(sbe_strerror(errno));
+    }
+
+    EXPECT_EQ(pos, CGT(car_performanceFigures_acceleration_sbe_header_size)() +
+        3 * CGT(car_performanceFigures_acceleration_sbe_block_length)());
+    EXPECT_FALSE(CGT(car_performanceFigures_acceleration_has_next)(&acc));
+
+    pos = 0;
+    CGT(car_performanceFigures_acceleration_wrap_for_decode)(
+        &acc, buffer, &pos, CGT(car_sbe_schema_version)(), sizeof(buffer));
+
+    for (int i = 0; i < 3; i++)
+    {
+        ASSERT_TRUE(CGT(car_performanceFigures_acceleration_next)(&acc));
+        EXPECT_EQ(CGT(car_performanceFigures_acceleration_mph)(&acc), mph[i]);
+        EXPECT_EQ(CGT(car_performanceFigures_acceleration_seconds)(&acc), seconds[i]);
+    }
+
+    pos = 0;
+    CGT(car_performanceFigures_acceleration_wrap_for_encode)(
+        &acc, buffer, 3, &pos, CGT(car_sbe_schema_version)(), 20);
+    EXPECT_FALSE(CGT(car_performanceFigures_acceleration_encode_columns)(&acc, mph, seconds));
+}
@@ -281,6 +281,91 @@ public:
     Car m_carDecoder;
 };
 
+TEST_F(BoundsCheckTest, shouldReportErrorCodeWithoutThrowingWhenBufferTooShortForDecode)
+{
+    char buffer[191];
+    encodeCarRoot(buffer, 0, sizeof(buffer));
+    encodeCarFuelFigures();
+    encodeCarPerformanceFigures();
+    encodeCarManufacturerModelAndActivationCode();
+
+    std::error_code ec;
+    m_carDecoder.wrapForDecode(
+        buffer, 0, Car::sbeBlockLength(), Car::sbeSchemaVersion(), Car::sbeBlockLength() - 1, ec);
+    EXPECT_EQ(ec, sbe_make_error_code(E100));
+
+    ec.clear();
+    const std::uint64_t length = Car::sbeBlockLength() + CarGroups::FuelFigures::sbeHeaderSize() +
+        CarGroups::FuelFigures::sbeBlockLength() + 1;
+    m_carDecoder.wrapForDecode(buffer, 0, Car::sbeBlockLength(), Car::sbeSchemaVersion(), length, ec);
+    EXPECT_FALSE(ec);
+
+    CarGroups::FuelFigures fuelFigures;
+    std::uint64_t pos = Car::sbeBlockLength();
+    fuelFigures.wrapForDecode(buffer, &pos, Car::sbeSchemaVersion(), length, ec);
+    EXPECT_FALSE(ec);
+    EXPECT_EQ(fuelFigures.count(), 3u);
+
+    std::uint64_t elements = 0;
+    while (fuelFigures.hasNext())
+    {
+        fuelFigures.next(ec);
+        elements++;
+    }
+
+    EXPECT_EQ(elements, 2u);
+    EXPECT_EQ(fuelFigures.count(), 1u);
+    EXPECT_EQ(ec, sbe_make_error_code(E108));
+    EXPECT_STREQ(ec.category().name(), "sbe");
+
+    ec.clear();
+    pos = length - 1;
+    fuelFigures.wrapForDecode(buffer, &pos, Car::sbeSchemaVersion(), length, ec);
+    EXPECT_EQ(ec, sbe_make_error_code(E108));
+    EXPECT_FALSE(fuelFigures.hasNext());
+}
+
+TEST_F(BoundsCheckTest, shouldDecodeWholeMessageWithErrorCodeOverloads)
+{
+    char buffer[191];
+    encodeCarRoot(buffer, 0, sizeof(buffer));
+    encodeCarFuelFigures();
+    encodeCarPerformanceFigures();
+    encodeCarManufacturerModelAndActivationCode();
+
+    std::error_code ec;
+    m_carDecoder.wrapForDecode(buffer, 0, Car::sbeBlockLength(), Car::sbeSchemaVersion(), sizeof(buffer), ec);
+
+    CarGroups::FuelFigures &fuelFigures = m_carDecoder.fuelFigures(ec);
+    EXPECT_EQ(fuelFigures.count(), 3u);
+    fuelFigures.next(ec);
+    EXPECT_EQ(fuelFigures.usageDescriptionLength(ec), 11u);
+    EXPECT_EQ(fuelFigures.getUsageDescriptionAsString(ec), "Urban Cycle");
+    fuelFigures.next(ec);
+    EXPECT_EQ(fuelFigures.getUsageDescriptionAsString(ec), "Combined Cycle");
+    fuelFigures.next(ec);
+    EXPECT_EQ(fuelFigures.getUsageDescriptionAsString(ec), "Highway Cycle");
+
+    CarGroups::PerformanceFigures &performanceFigures = m_carDecoder.performanceFigures(ec);
+    while (performanceFigures.hasNext())
+    {
+        performanceFigures.next(ec);
+        CarGroups::PerformanceFiguresGroups::Acceleration &acceleration = performanceFigures.acceleration(ec);
+        EXPECT_EQ(acceleration.count(), 3u);
+        while (acceleration.hasNext())
+        {
+            acceleration.next(ec);
+        }
+    }
+
+    EXPECT_EQ(m_carDecoder.getManufacturerAsString(ec), MANUFACTURER);
+    EXPECT_EQ(m_carDecoder.modelLength(ec), 9u);
+    EXPECT_EQ(std::string(m_carDecoder.model(ec), 9), MODEL);
+    EXPECT_EQ(m_carDecoder.getActivationCodeAsString(ec), ACTIVATION_CODE);
+    EXPECT_EQ(m_carDecoder.encodedLength(), encodedCarSz);
+    EXPECT_FALSE(ec);
+}
+
 class HeaderBoundsCheckTest : public BoundsCheckTest, public ::testing::WithParamInterface<int>
 {
 };
@@ -355,6 +440,52 @@ TEST_P(MessageBoundsCheckTest, shouldExceptionWhenBufferTooShortForDecodeOfMessa
     }, std::runtime_error);
 }
 
+TEST_P(MessageBoundsCheckTest, shouldReportErrorCodeWithoutThrowingWhenBufferTooShortForDecodeOfMessage)
+{
+    const int length = GetParam();
+    char encodeBuffer[191];
+    std::unique_ptr<char[]> buffer(new char[length]);
+
+    encodeCarRoot(encodeBuffer, 0, sizeof(encodeBuffer));
+    encodeCarFuelFigures();
+    encodeCarPerformanceFigures();
+    encodeCarManufacturerModelAndActivationCode();
+    std::memcpy(buffer.get(), encodeBuffer, length);
+
+    std::error_code ec;
+    EXPECT_NO_THROW(
+    {
+        m_carDecoder.wrapForDecode(buffer.get(), 0, Car::sbeBlockLength(), Car::sbeSchemaVersion(), length, ec);
+
+        CarGroups::FuelFigures &fuelFigures = m_carDecoder.fuelFigures(ec);
+        while (fuelFigures.hasNext())
+        {
+            fuelFigures.next(ec);
+            const std::string usageDescription = fuelFigures.getUsageDescriptionAsString(ec);
+        }
+
+        CarGroups::PerformanceFigures &performanceFigures = m_carDecoder.performanceFigures(ec);
+        while (performanceFigures.hasNext())
+        {
+            performanceFigures.next(ec);
+            CarGroups::PerformanceFiguresGroups::Acceleration &acceleration = performanceFigures.acceleration(ec);
+            while (acceleration.hasNext())
+            {
+                acceleration.next(ec);
+            }
+        }
+
+        const std::string manufacturer = m_carDecoder.getManufacturerAsString(ec);
+        const std::uint64_t modelLength = m_carDecoder.modelLength(ec);
+        const char *model = m_carDecoder.model(ec);
+        EXPECT_TRUE(nullptr == model || modelLength <= static_cast<std::uint64_t>(length - (model - buffer.get())));
+        const std::string activationCode = m_carDecoder.getActivationCodeAsString(ec);
+    });
+
+    EXPECT_TRUE(ec);
+    EXPECT_EQ(&ec.category(), &sbe_error_category());
+}
+
 INSTANTIATE_TEST_CASE_P(
     MessageLengthTest,
     MessageBoundsCheckTest,
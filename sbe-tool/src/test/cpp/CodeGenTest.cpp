@@ -15,6 +15,8 @@
  */
 #include <iostream>
 #include <cstring>
+#include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "code_generation_test/code_generation_test_cpp.h"
@@ -934,3 +936,261 @@ TEST_F(CodeGenTest, shouldPrintFullDecodedFlyweightRegardlessOfReadPosition)
 
     EXPECT_EQ(carDecoder.encodedLength(), expectedCarEncodedLength);
 }
+
+TEST_F(CodeGenTest, shouldAppendJsonMatchingDisplayString)
+{
+    char buffer[2048];
+    memset(buffer, 0, 2048);
+    Car carEncoder(buffer, sizeof(buffer));
+
+    std::uint64_t carEncodedLength = encodeCar(carEncoder);
+
+    EXPECT_EQ(carEncodedLength, expectedCarEncodedLength);
+
+    Car carDecoder(buffer, carEncodedLength, Car::sbeBlockLength(), Car::sbeSchemaVersion());
+
+    std::stringstream displayStream;
+    displayStream << carDecoder;
+
+    std::string json;
+    carDecoder.appendJson(json);
+    EXPECT_EQ(json, displayStream.str());
+
+    CarGroups::FuelFigures &fuelFigures = carDecoder.fuelFigures();
+    fuelFigures.next();
+
+    const std::size_t capacity = json.capacity();
+    json.clear();
+    carDecoder.appendJson(json);
+    EXPECT_EQ(json, displayStream.str());
+    EXPECT_EQ(json.capacity(), capacity);
+
+    json.clear();
+    Model::appendJson(json, Model::B);
+    carDecoder.extras().appendJson(json);
+    EXPECT_EQ(json, "\"B\"[\"sportsPack\",\"cruiseControl\"]");
+}
+
+TEST_F(CodeGenTest, shouldIndexFixedBlockGroupElementsAndSkipPastThem)
+{
+    char buffer[2048];
+    memset(buffer, 0, 2048);
+    Car carEncoder(buffer, sizeof(buffer));
+
+    std::uint64_t carEncodedLength = encodeCar(carEncoder);
+
+    EXPECT_EQ(carEncodedLength, expectedCarEncodedLength);
+
+    Car carDecoder(buffer, carEncodedLength, Car::sbeBlockLength(), Car::sbeSchemaVersion());
+
+    CarGroups::FuelFigures &fuelFigures = carDecoder.fuelFigures();
+    while (fuelFigures.hasNext())
+    {
+        fuelFigures.next().skip();
+    }
+
+    CarGroups::PerformanceFigures &perfFigures = carDecoder.performanceFigures();
+
+    perfFigures.next();
+    CarGroups::PerformanceFiguresGroups::Acceleration &acceleration = perfFigures.acceleration();
+    CarGroups::PerformanceFiguresGroups::Acceleration::Elements elements = acceleration.elements();
+    EXPECT_FALSE(acceleration.hasNext());
+    ASSERT_EQ(elements.size(), ACCELERATION_COUNT);
+    EXPECT_EQ(elements.stride(), CarGroups::PerformanceFiguresGroups::Acceleration::sbeBlockLength());
+    EXPECT_EQ(elements[0].mph(), perf1aMph);
+    EXPECT_EQ(elements[2].mph(), perf1cMph);
+    EXPECT_EQ(elements[1].seconds(), perf1bSeconds);
+
+    CarGroups::PerformanceFiguresGroups::Acceleration element = elements[1];
+    EXPECT_FALSE(element.hasNext());
+    EXPECT_EQ(element.sbePosition(), acceleration.sbePosition());
+    EXPECT_THROW(element.next(), std::runtime_error);
+
+    perfFigures.next();
+    std::uint64_t mphSum = 0;
+    for (CarGroups::PerformanceFiguresGroups::Acceleration element : perfFigures.acceleration().elements())
+    {
+        mphSum += element.mph();
+    }
+    EXPECT_EQ(mphSum, static_cast<std::uint64_t>(perf2aMph + perf2bMph + perf2cMph));
+
+    EXPECT_EQ(carDecoder.getManufacturerAsString(), MANUFACTURER);
+    EXPECT_EQ(carDecoder.getModelAsString(), MODEL);
+    EXPECT_EQ(carDecoder.decodeLength(), expectedCarEncodedLength);
+}
+
+TEST_F(CodeGenTest, shouldEncodeFixedBlockGroupFromColumns)
+{
+    const std::uint16_t mph[] = { perf1aMph, perf1bMph, perf1cMph };
+    const float seconds[] = { perf1aSeconds, perf1bSeconds, perf1cSeconds };
+    char buffer[64];
+    std::uint64_t pos = 0;
+
+    CarGroups::PerformanceFiguresGroups::Acceleration acceleration;
+    acceleration.wrapForEncode(buffer, 3, &pos, Car::sbeSchemaVersion(), sizeof(buffer));
+    acceleration.next().mph(perf1aMph).seconds(perf1aSeconds);
+    acceleration.encodeColumns(mph + 1, seconds + 1);
+
+    EXPECT_EQ(pos, acceleration.sbeHeaderSize() + 3 * acceleration.sbeBlockLength());
+    EXPECT_FALSE(acceleration.hasNext());
+
+    pos = 0;
+    acceleration.wrapForDecode(buffer, &pos, Car::sbeSchemaVersion(), sizeof(buffer));
+    for (int i = 0; i < 3; i++)
+    {
+        ASSERT_TRUE(acceleration.hasNext());
+        acceleration.next();
+        EXPECT_EQ(acceleration.mph(), mph[i]);
+        EXPECT_EQ(acceleration.seconds(), seconds[i]);
+    }
+
+    pos = 0;
+    acceleration.wrapForEncode(buffer, 3, &pos, Car::sbeSchemaVersion(), sizeof(buffer));
+    char *elements = acceleration.reserveElements();
+    CarGroups::PerformanceFiguresGroups::Acceleration::encodeColumnRange(elements, 2, 3, mph, seconds);
+    CarGroups::PerformanceFiguresGroups::Acceleration::encodeColumnRange(elements, 0, 2, mph, seconds);
+
+    pos = 0;
+    acceleration.wrapForDecode(buffer, &pos, Car::sbeSchemaVersion(), sizeof(buffer));
+    EXPECT_EQ(acceleration.elements()[2].mph(), perf1cMph);
+
+    pos = 0;
+    acceleration.wrapForEncode(buffer, 3, &pos, Car::sbeSchemaVersion(), 20);
+    EXPECT_THROW(
+    {
+        acceleration.encodeColumns(mph, seconds);
+    }, std::runtime_error);
+}
+
+struct CarFieldVisitor
+{
+    std::vector<std::string> names;
+    std::vector<std::uint16_t> ids;
+    std::uint64_t serialNumber = 0;
+
+    void operator()(const sbe_field_descriptor &descriptor, std::uint64_t value)
+    {
+        names.push_back(descriptor.name);
+        ids.push_back(descriptor.id);
+        serialNumber = value;
+    }
+
+    template<typename T>
+    void operator()(const sbe_field_descriptor &descriptor, T &&)
+    {
+        names.push_back(descriptor.name);
+        ids.push_back(descriptor.id);
+    }
+};
+
+TEST_F(CodeGenTest, shouldVisitFieldsWithCompileTimeDescriptors)
+{
+    static_assert(Car::modelYearDescriptor().offset == 8, "modelYear offset");
+    static_assert(Car::modelYearDescriptor().primitive_type == sbe_primitive_type_UINT16, "modelYear type");
+    static_assert(Car::sbeFieldCount() == 9, "Car field count");
+
+    EXPECT_EQ(Car::discountedModelDescriptor().presence, sbe_presence_CONSTANT);
+    EXPECT_EQ(Car::discountedModelDescriptor().encoded_length, 0u);
+    EXPECT_EQ(Car::engineDescriptor().primitive_type, sbe_primitive_type_NONE);
+    EXPECT_EQ(Car::sbeFieldDescriptors()[8].id, 9u);
+    EXPECT_STREQ(Car::sbeFieldDescriptors()[6].name, "extras");
+
+    char buffer[2048];
+    memset(buffer, 0, 2048);
+    Car carEncoder(buffer, sizeof(buffer));
+    encodeCar(carEncoder);
+
+    Car carDecoder(buffer, sizeof(buffer), Car::sbeBlockLength(), Car::sbeSchemaVersion());
+    CarFieldVisitor visitor;
+    carDecoder.forEachField(visitor);
+
+    ASSERT_EQ(visitor.names.size(), Car::sbeFieldCount());
+    for (std::size_t i = 0; i < Car::sbeFieldCount(); i++)
+    {
+        EXPECT_STREQ(visitor.names[i].c_str(), Car::sbeFieldDescriptors()[i].name);
+        EXPECT_EQ(visitor.ids[i], i + 1);
+    }
+    EXPECT_EQ(visitor.serialNumber, SERIAL_NUMBER);
+}
+
+TEST_F(CodeGenTest, shouldValidateOnceAndReadThroughValidatedView)
+{
+    char buffer[2048];
+    memset(buffer, 0, 2048);
+    Car carEncoder(buffer, sizeof(buffer));
+    const std::uint64_t encodedLength = encodeCar(carEncoder);
+
+    std::error_code ec;
+    validated::Car view = validated::Car::validate(
+        buffer, 0, Car::sbeBlockLength(), Car::sbeSchemaVersion(), encodedLength, ec);
+
+    ASSERT_FALSE(ec);
+    EXPECT_EQ(view.serialNumber(), SERIAL_NUMBER);
+    EXPECT_EQ(view.code(), CODE);
+
+    validated::CarGroups::FuelFigures &fuelFigures = view.fuelFigures();
+    ASSERT_EQ(fuelFigures.count(), FUEL_FIGURES_COUNT);
+    EXPECT_EQ(fuelFigures.next().speed(), fuel1Speed);
+
+    (void)validated::Car::validate(
+        buffer, 0, Car::sbeBlockLength(), Car::sbeSchemaVersion(), encodedLength - 1, ec);
+    EXPECT_EQ(ec.value(), E100);
+
+    ec.clear();
+    (void)validated::Car::validate(
+        buffer, 0, Car::sbeBlockLength() - 1, Car::sbeSchemaVersion(), encodedLength, ec);
+    EXPECT_EQ(ec.value(), E107);
+
+    buffer[Car::codeDescriptor().offset] = 'Z';
+    ec.clear();
+    (void)validated::Car::validate(
+        buffer, 0, Car::sbeBlockLength(), Car::sbeSchemaVersion(), encodedLength, ec);
+    EXPECT_EQ(ec.value(), E103);
+    EXPECT_EQ(ec.category().name(), std::string("sbe"));
+}
+
+TEST_F(CodeGenTest, shouldReadGroupsAndVarDataInAnyOrderThroughOffsetIndex)
+{
+    char buffer[2048];
+    memset(buffer, 0, 2048);
+    Car carEncoder(buffer, sizeof(buffer));
+    const std::uint64_t encodedLength = encodeCar(carEncoder);
+
+    Car carDecoder(buffer, encodedLength, Car::sbeBlockLength(), Car::sbeSchemaVersion());
+    sbe_offset_index<64> index;
+    carDecoder.buildIndex(index);
+    ASSERT_GT(index.length, 0u);
+
+    EXPECT_EQ(std::string(carDecoder.colorIndexed(index), carDecoder.colorIndexedLength(index)), COLOR);
+    EXPECT_EQ(
+        std::string(carDecoder.manufacturerIndexed(index), carDecoder.manufacturerIndexedLength(index)),
+        MANUFACTURER);
+
+    ASSERT_EQ(carDecoder.performanceFiguresIndexedCount(index), PERFORMANCE_FIGURES_COUNT);
+    const std::uint64_t perfRecord = Car::performanceFiguresIndexedRecord(index, 1);
+    CarGroups::PerformanceFigures perfFigs;
+    perfFigs.wrapIndexed(buffer, index, perfRecord, Car::sbeSchemaVersion(), encodedLength);
+    EXPECT_EQ(perfFigs.octaneRating(), perf2Octane);
+
+    ASSERT_EQ(perfFigs.accelerationIndexedCount(index, perfRecord), ACCELERATION_COUNT);
+    CarGroups::PerformanceFiguresGroups::Acceleration acceleration;
+    const std::uint64_t accelerationRecord = perfFigs.accelerationIndexedRecord(index, perfRecord, 2);
+    acceleration.wrapIndexed(buffer, index, accelerationRecord, Car::sbeSchemaVersion(), encodedLength);
+    EXPECT_EQ(acceleration.mph(), perf2cMph);
+    EXPECT_FALSE(acceleration.hasNext());
+    EXPECT_EQ(
+        acceleration.sbePosition(), index.offsets[accelerationRecord] + index.offsets[accelerationRecord + 1]);
+
+    const std::uint64_t fuelRecord = Car::fuelFiguresIndexedRecord(index, 0);
+    CarGroups::FuelFigures fuelFigures;
+    fuelFigures.wrapIndexed(buffer, index, fuelRecord, Car::sbeSchemaVersion(), encodedLength);
+    EXPECT_EQ(fuelFigures.speed(), fuel1Speed);
+    EXPECT_EQ(
+        std::string(fuelFigures.usageDescriptionIndexed(index, fuelRecord),
+            fuelFigures.usageDescriptionIndexedLength(index, fuelRecord)),
+        FUEL_FIGURES_1_USAGE_DESCRIPTION);
+    EXPECT_EQ(fuelFigures.usageDescriptionLength(), FUEL_FIGURES_1_USAGE_DESCRIPTION_LENGTH);
+
+    sbe_offset_index<8> tooSmall;
+    EXPECT_THROW(carDecoder.buildIndex(tooSmall), std::runtime_error);
+}
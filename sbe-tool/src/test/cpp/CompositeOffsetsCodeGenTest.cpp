@@ -154,3 +154,47 @@ TEST_F(CompositeOffsetsCodeGenTest, shouldBeAbleToDecodeHeaderAndMsgCorrectly)
 
     EXPECT_EQ(m_msgDecoder.encodedLength(), 40u);
 }
+
+TEST_F(CompositeOffsetsCodeGenTest, shouldDecodeLengthOfFixedBlockGroupsFromDimensions)
+{
+    char buffer[2048];
+    std::uint64_t hdrSz = encodeHdr(buffer, 0, sizeof(buffer));
+    std::uint64_t sz = encodeMsg(buffer, hdrSz, sizeof(buffer));
+
+    m_msgDecoder.wrapForDecode(buffer, hdrSz, TestMessage1::sbeBlockLength(), TestMessage1::sbeSchemaVersion(), hdrSz + sz);
+
+    EXPECT_EQ(m_msgDecoder.decodeLength(), 40u);
+    EXPECT_EQ(m_msgDecoder.sbePosition(), hdrSz + TestMessage1::sbeBlockLength());
+
+    m_msgDecoder.wrapForDecode(
+        buffer, hdrSz, TestMessage1::sbeBlockLength(), TestMessage1::sbeSchemaVersion(), hdrSz + sz - 1);
+
+    EXPECT_THROW(
+    {
+        static_cast<void>(m_msgDecoder.decodeLength());
+    }, std::runtime_error);
+}
+
+TEST_F(CompositeOffsetsCodeGenTest, shouldCopyGroupBlockWholeAsStruct)
+{
+    char buffer[2048];
+    std::uint64_t sz = encodeMsg(buffer, 0, sizeof(buffer));
+
+    m_msgDecoder.wrapForDecode(buffer, 0, TestMessage1::sbeBlockLength(), TestMessage1::sbeSchemaVersion(), sz);
+
+    TestMessage1Groups::Entries &entries = m_msgDecoder.entries();
+    entries.next();
+    TestMessage1Groups::Entries::Block block = entries.asStruct();
+    EXPECT_EQ(block.tagGroup1, 10u);
+    EXPECT_EQ(block.tagGroup2, 20);
+
+    entries.next();
+    block = entries.asStruct();
+    EXPECT_EQ(block.tagGroup1, 30u);
+    EXPECT_EQ(block.tagGroup2, 40);
+
+    block.tagGroup2 = -40;
+    entries.fromStruct(block);
+    EXPECT_EQ(entries.tagGroup1(), 30u);
+    EXPECT_EQ(entries.tagGroup2(), -40);
+}
@@ -13,7 +13,10 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <cstring>
 #include <iostream>
+#include <fstream>
+#include <iterator>
 
 #include "gtest/gtest.h"
 #include "code_generation_test/code_generation_test_cpp.h"
@@ -21,6 +24,14 @@
 #include "otf/IrDecoder.h"
 #include "otf/OtfHeaderDecoder.h"
 #include "otf/OtfMessageDecoder.h"
+#include "otf/OtfStreamDecoder.h"
+#include "otf/FieldProjection.h"
+#include "otf/ColumnarExporter.h"
+#include "otf/OtfParallelDecoder.h"
+#include "otf/FieldAccessor.h"
+#include "otf/BitSetDecoder.h"
+#include "otf/EnumIndex.h"
+#include "otf/OtfJsonPrinter.h"
 
 using namespace code::generation::test;
 
@@ -1137,6 +1148,82 @@ TEST_F(Rc3OtfFullIrTest, shouldHandleDecodingOfMessageHeaderCorrectly)
     EXPECT_EQ(headerDecoder.getSchemaVersion(m_buffer), Car::sbeSchemaVersion());
 }
 
+TEST_F(Rc3OtfFullIrTest, shouldDecodeAllFieldsOfStandardMessageHeaderTogether)
+{
+    ASSERT_EQ(encodeHdrAndCar(), encodedCarAndHdrLength);
+
+    ASSERT_GE(m_irDecoder.decode(SCHEMA_FILENAME), 0);
+
+    OtfHeaderDecoder headerDecoder(m_irDecoder.header());
+
+    EXPECT_TRUE(headerDecoder.isPackedUInt16());
+
+    const OtfHeaderFields fields = headerDecoder.getFields(m_buffer);
+
+    EXPECT_EQ(fields.templateId, Car::sbeTemplateId());
+    EXPECT_EQ(fields.blockLength, Car::sbeBlockLength());
+    EXPECT_EQ(fields.schemaId, Car::sbeSchemaId());
+    EXPECT_EQ(fields.schemaVersion, Car::sbeSchemaVersion());
+}
+
+TEST_F(Rc3OtfFullIrTest, shouldFindMessageTokensByTemplateIdAndVersion)
+{
+    ASSERT_GE(m_irDecoder.decode(SCHEMA_FILENAME), 0);
+
+    const std::shared_ptr<std::vector<Token>> *messageTokens = m_irDecoder.findMessage(Car::sbeTemplateId());
+
+    ASSERT_TRUE(messageTokens != nullptr);
+    EXPECT_EQ((*messageTokens)->at(0).fieldId(), Car::sbeTemplateId());
+    EXPECT_EQ(m_irDecoder.findMessage(Car::sbeTemplateId(), Car::sbeSchemaVersion()), messageTokens);
+    EXPECT_EQ(m_irDecoder.message(Car::sbeTemplateId()), *messageTokens);
+    EXPECT_TRUE(m_irDecoder.findMessage(Car::sbeTemplateId(), Car::sbeSchemaVersion() + 1) == nullptr);
+    EXPECT_TRUE(m_irDecoder.findMessage(60000) == nullptr);
+    EXPECT_TRUE(m_irDecoder.message(-1) == nullptr);
+}
+
+TEST_F(Rc3OtfFullIrTest, shouldDecodeIrInPlaceSameAsFromFile)
+{
+    ASSERT_GE(m_irDecoder.decode(SCHEMA_FILENAME), 0);
+
+    std::ifstream irFile(SCHEMA_FILENAME, std::ios::binary);
+    const std::vector<char> irBuffer((std::istreambuf_iterator<char>(irFile)), std::istreambuf_iterator<char>());
+    IrDecoder inPlaceDecoder;
+
+    ASSERT_GE(inPlaceDecoder.decodeInPlace(irBuffer.data(), irBuffer.size()), 0);
+
+    std::shared_ptr<std::vector<Token>> fileTokens = m_irDecoder.message(Car::sbeTemplateId());
+    std::shared_ptr<std::vector<Token>> inPlaceTokens = inPlaceDecoder.message(Car::sbeTemplateId());
+
+    ASSERT_TRUE(fileTokens != nullptr);
+    ASSERT_TRUE(inPlaceTokens != nullptr);
+    ASSERT_EQ(inPlaceTokens->size(), fileTokens->size());
+    EXPECT_EQ(inPlaceDecoder.messages().size(), m_irDecoder.messages().size());
+
+    for (std::size_t i = 0; i < fileTokens->size(); i++)
+    {
+        EXPECT_EQ(inPlaceTokens->at(i).signal(), fileTokens->at(i).signal());
+        EXPECT_EQ(inPlaceTokens->at(i).name(), fileTokens->at(i).name());
+        EXPECT_EQ(inPlaceTokens->at(i).description(), fileTokens->at(i).description());
+        EXPECT_EQ(inPlaceTokens->at(i).offset(), fileTokens->at(i).offset());
+    }
+}
+
+TEST_F(Rc3OtfFullIrTest, shouldMoveDecoderWithMappedIr)
+{
+    IrDecoder fileDecoder;
+    ASSERT_GE(fileDecoder.decode(SCHEMA_FILENAME), 0);
+
+    IrDecoder movedDecoder(std::move(fileDecoder));
+    std::shared_ptr<std::vector<Token>> tokens = movedDecoder.message(Car::sbeTemplateId());
+
+    ASSERT_TRUE(tokens != nullptr);
+    EXPECT_EQ(tokens->at(0).signal(), Signal::BEGIN_MESSAGE);
+
+    m_irDecoder = std::move(movedDecoder);
+    EXPECT_EQ(m_irDecoder.message(Car::sbeTemplateId())->size(), tokens->size());
+    EXPECT_FALSE(m_irDecoder.messages().empty());
+}
+
 TEST_F(Rc3OtfFullIrTest, shouldHandleAllEventsCorrectlyAndInOrder)
 {
     ASSERT_EQ(encodeHdrAndCar(), encodedCarAndHdrLength);
@@ -1163,6 +1250,604 @@ TEST_F(Rc3OtfFullIrTest, shouldHandleAllEventsCorrectlyAndInOrder)
     EXPECT_EQ(result, static_cast<std::size_t>(encodedCarAndHdrLength - MessageHeader::encodedLength()));
 }
 
+TEST_F(Rc3OtfFullIrTest, shouldHandleAllEventsCorrectlyAndInOrderWithDecodePlan)
+{
+    ASSERT_EQ(encodeHdrAndCar(), encodedCarAndHdrLength);
+
+    ASSERT_GE(m_irDecoder.decode(SCHEMA_FILENAME), 0);
+
+    std::shared_ptr<std::vector<Token>> headerTokens = m_irDecoder.header();
+    std::shared_ptr<std::vector<Token>> messageTokens = m_irDecoder.message(
+        Car::sbeTemplateId(), Car::sbeSchemaVersion());
+
+    ASSERT_TRUE(headerTokens != nullptr);
+    ASSERT_TRUE(messageTokens!= nullptr);
+
+    OtfHeaderDecoder headerDecoder(headerTokens);
+    const DecodePlan plan(messageTokens);
+
+    EXPECT_EQ(plan.templateId(), Car::sbeTemplateId());
+    const char *messageBuffer = m_buffer + headerDecoder.encodedLength();
+    std::size_t length = static_cast<std::size_t>(encodedCarAndHdrLength - headerDecoder.encodedLength());
+    std::uint64_t actingVersion = headerDecoder.getSchemaVersion(m_buffer);
+    std::uint64_t blockLength = headerDecoder.getBlockLength(m_buffer);
+
+    const std::size_t result = OtfMessageDecoder::decode(
+        messageBuffer, length, actingVersion, static_cast<std::size_t>(blockLength), plan, *this);
+    EXPECT_EQ(result, static_cast<std::size_t>(encodedCarAndHdrLength - MessageHeader::encodedLength()));
+    EXPECT_EQ(m_eventNumber, EN_endMessage + 1);
+}
+
+TEST_F(Rc3OtfFullIrTest, shouldInternTokenNamesSharedByHeaderAndMessage)
+{
+    ASSERT_GE(m_irDecoder.decode(SCHEMA_FILENAME), 0);
+
+    std::shared_ptr<std::vector<Token>> headerTokens = m_irDecoder.header();
+    std::shared_ptr<std::vector<Token>> messageTokens = m_irDecoder.message(
+        Car::sbeTemplateId(), Car::sbeSchemaVersion());
+
+    ASSERT_TRUE(messageTokens != nullptr);
+
+    const Token& headerBlockLength = headerTokens->at(1);
+    ASSERT_EQ(headerBlockLength.name(), "blockLength");
+
+    std::size_t groupIndex = 0;
+    while (Signal::BEGIN_GROUP != messageTokens->at(groupIndex).signal())
+    {
+        groupIndex++;
+    }
+
+    const Token& groupBlockLength = messageTokens->at(groupIndex + 2);
+    ASSERT_EQ(groupBlockLength.name(), "blockLength");
+    EXPECT_EQ(&groupBlockLength.name(), &headerBlockLength.name());
+
+    EXPECT_EQ(sizeof(DecodeInstruction), 32u);
+}
+
+class MessageCountingListener : public OtfMessageDecoder::BasicTokenListener
+{
+public:
+    int m_beginMessageCount = 0;
+    int m_endMessageCount = 0;
+
+    void onBeginMessage(Token& token) override
+    {
+        m_beginMessageCount++;
+    }
+
+    void onEndMessage(Token& token) override
+    {
+        m_endMessageCount++;
+    }
+};
+
+TEST_F(Rc3OtfFullIrTest, shouldDecodeStreamOfMessagesAndReportTruncatedTail)
+{
+    ASSERT_EQ(encodeHdrAndCar(), encodedCarAndHdrLength);
+
+    ASSERT_GE(m_irDecoder.decode(SCHEMA_FILENAME), 0);
+
+    const std::size_t carLength = static_cast<std::size_t>(encodedCarAndHdrLength);
+    std::vector<char> stream;
+    for (int i = 0; i < 3; i++)
+    {
+        stream.insert(stream.end(), m_buffer, m_buffer + carLength);
+    }
+
+    DecodePlanRegistry registry(m_irDecoder);
+    MessageCountingListener listener;
+
+    StreamDecodeResult result = OtfMessageDecoder::decodeStream(stream.data(), stream.size(), registry, listener);
+
+    EXPECT_EQ(result.status, STREAM_COMPLETE);
+    EXPECT_EQ(result.messageCount, 3u);
+    EXPECT_EQ(result.consumedLength, stream.size());
+    EXPECT_EQ(result.remainingLength, 0u);
+    EXPECT_EQ(listener.m_endMessageCount, 3);
+
+    MessageCountingListener truncatedListener;
+    result = OtfMessageDecoder::decodeStream(stream.data(), stream.size() - 1, registry, truncatedListener);
+
+    EXPECT_EQ(result.status, STREAM_TRUNCATED);
+    EXPECT_EQ(result.messageCount, 2u);
+    EXPECT_EQ(result.consumedLength, 2 * carLength);
+    EXPECT_EQ(result.remainingLength, carLength - 1);
+    EXPECT_EQ(truncatedListener.m_beginMessageCount, 2);
+}
+
+class EncodingCollectingListener : public OtfMessageDecoder::BasicTokenListener
+{
+public:
+    std::vector<std::string> m_names;
+    std::vector<std::uint64_t> m_values;
+    std::uint64_t m_groupElementCount = 0;
+
+    void onEncoding(Token& fieldToken, const char *buffer, Token& typeToken, std::uint64_t actingVersion) override
+    {
+        m_names.push_back(fieldToken.name());
+        m_values.push_back(typeToken.encoding().getAsUInt(buffer));
+    }
+
+    void onBeginGroup(Token& token, std::uint64_t groupIndex, std::uint64_t numInGroup) override
+    {
+        m_groupElementCount++;
+    }
+};
+
+TEST_F(Rc3OtfFullIrTest, shouldDecodeOnlyProjectedFields)
+{
+    ASSERT_EQ(encodeHdrAndCar(), encodedCarAndHdrLength);
+
+    ASSERT_GE(m_irDecoder.decode(SCHEMA_FILENAME), 0);
+
+    std::shared_ptr<std::vector<Token>> messageTokens = m_irDecoder.message(
+        Car::sbeTemplateId(), Car::sbeSchemaVersion());
+
+    ASSERT_TRUE(messageTokens != nullptr);
+
+    const DecodePlan plan(messageTokens);
+    const FieldProjection projection(
+        plan, { "Car.modelYear", "engine.capacity", "performanceFigures.acceleration.mph" });
+    EncodingCollectingListener listener;
+
+    const char *messageBuffer = m_buffer + MessageHeader::encodedLength();
+    std::size_t length = static_cast<std::size_t>(encodedCarAndHdrLength - MessageHeader::encodedLength());
+
+    OtfMessageDecoder::decode(
+        messageBuffer, length, Car::sbeSchemaVersion(), Car::sbeBlockLength(), projection, listener);
+
+    const std::vector<std::string> expectedNames =
+        { "modelYear", "capacity", "mph", "mph", "mph", "mph", "mph", "mph" };
+    const std::vector<std::uint64_t> expectedValues =
+        { MODEL_YEAR, engineCapacity, perf1aMph, perf1bMph, perf1cMph, perf2aMph, perf2bMph, perf2cMph };
+
+    EXPECT_EQ(listener.m_names, expectedNames);
+    EXPECT_EQ(listener.m_values, expectedValues);
+    EXPECT_EQ(listener.m_groupElementCount, static_cast<std::uint64_t>(
+        PERFORMANCE_FIGURES_COUNT + PERFORMANCE_FIGURES_COUNT * ACCELERATION_COUNT));
+
+    EXPECT_THROW(FieldProjection(plan, { "engine.noSuchField" }), std::runtime_error);
+}
+
+class EncodingCountingListener : public OtfMessageDecoder::StaticTokenListener<EncodingCountingListener>
+{
+public:
+    std::size_t m_encodingCount = 0;
+
+    void onEncoding(Token& fieldToken, const char *buffer, Token& typeToken, std::uint64_t actingVersion)
+    {
+        m_encodingCount++;
+    }
+};
+
+class VirtualEncodingCountingListener : public OtfMessageDecoder::BasicTokenListener
+{
+public:
+    std::size_t m_encodingCount = 0;
+
+    void onEncoding(Token& fieldToken, const char *buffer, Token& typeToken, std::uint64_t actingVersion) override
+    {
+        m_encodingCount++;
+    }
+};
+
+class DeclaredInterestListener : public OtfMessageDecoder::BasicTokenListener
+{
+public:
+    static const std::uint32_t tokenListenerInterest = OtfMessageDecoder::INTEREST_ENCODING;
+
+    std::size_t m_encodingCount = 0;
+    std::size_t m_otherCount = 0;
+
+    void onEncoding(Token& fieldToken, const char *buffer, Token& typeToken, std::uint64_t actingVersion) override
+    {
+        m_encodingCount++;
+    }
+
+    void onBeginComposite(Token& fieldToken, std::vector<Token>& tokens, std::size_t fromIndex, std::size_t toIndex) override
+    {
+        m_otherCount++;
+    }
+
+    void onBeginGroup(Token& token, std::uint64_t groupIndex, std::uint64_t numInGroup) override
+    {
+        m_otherCount++;
+    }
+};
+
+TEST_F(Rc3OtfFullIrTest, shouldRaiseOnlyEventsOfInterestToListener)
+{
+    ASSERT_EQ(encodeHdrAndCar(), encodedCarAndHdrLength);
+
+    ASSERT_GE(m_irDecoder.decode(SCHEMA_FILENAME), 0);
+
+    std::shared_ptr<std::vector<Token>> messageTokens = m_irDecoder.message(
+        Car::sbeTemplateId(), Car::sbeSchemaVersion());
+
+    ASSERT_TRUE(messageTokens != nullptr);
+
+    static_assert(
+        OtfMessageDecoder::TokenListenerTraits<EncodingCountingListener>::interest ==
+            OtfMessageDecoder::INTEREST_ENCODING,
+        "interest should be detected from declared callbacks");
+    static_assert(
+        OtfMessageDecoder::TokenListenerTraits<VirtualEncodingCountingListener>::interest ==
+            OtfMessageDecoder::INTEREST_ALL,
+        "virtual listeners should receive all events");
+
+    const DecodePlan plan(messageTokens);
+    const char *messageBuffer = m_buffer + MessageHeader::encodedLength();
+    std::size_t length = static_cast<std::size_t>(encodedCarAndHdrLength - MessageHeader::encodedLength());
+
+    VirtualEncodingCountingListener allEventsListener;
+    EncodingCountingListener countingListener;
+    DeclaredInterestListener declaredListener;
+
+    const std::size_t result = OtfMessageDecoder::decode(
+        messageBuffer, length, Car::sbeSchemaVersion(), Car::sbeBlockLength(), plan, allEventsListener);
+    EXPECT_EQ(OtfMessageDecoder::decode(
+        messageBuffer, length, Car::sbeSchemaVersion(), Car::sbeBlockLength(), plan, countingListener), result);
+    EXPECT_EQ(OtfMessageDecoder::decode(
+        messageBuffer, length, Car::sbeSchemaVersion(), Car::sbeBlockLength(), messageTokens, declaredListener), result);
+
+    EXPECT_EQ(countingListener.m_encodingCount, allEventsListener.m_encodingCount);
+    EXPECT_EQ(declaredListener.m_encodingCount, allEventsListener.m_encodingCount);
+    EXPECT_EQ(declaredListener.m_otherCount, 0u);
+}
+
+TEST_F(Rc3OtfFullIrTest, shouldExportMessagesToColumns)
+{
+    ASSERT_EQ(encodeHdrAndCar(), encodedCarAndHdrLength);
+
+    ASSERT_GE(m_irDecoder.decode(SCHEMA_FILENAME), 0);
+
+    std::shared_ptr<std::vector<Token>> messageTokens = m_irDecoder.message(
+        Car::sbeTemplateId(), Car::sbeSchemaVersion());
+
+    ASSERT_TRUE(messageTokens != nullptr);
+
+    ColumnarExporter exporter((DecodePlan(messageTokens)));
+    const char *messageBuffer = m_buffer + MessageHeader::encodedLength();
+    std::size_t length = static_cast<std::size_t>(encodedCarAndHdrLength - MessageHeader::encodedLength());
+
+    for (int i = 0; i < 2; i++)
+    {
+        EXPECT_EQ(exporter.append(messageBuffer, length, Car::sbeSchemaVersion(), Car::sbeBlockLength()), length);
+    }
+
+    const ColumnTable *car = exporter.table("Car");
+    const ColumnTable *fuelFigures = exporter.table("fuelFigures");
+    const ColumnTable *acceleration = exporter.table("performanceFigures.acceleration");
+
+    ASSERT_TRUE(car != nullptr && fuelFigures != nullptr && acceleration != nullptr);
+    EXPECT_EQ(car->rowCount(), 2u);
+    EXPECT_EQ(fuelFigures->rowCount(), 2u * FUEL_FIGURES_COUNT);
+    EXPECT_EQ(acceleration->rowCount(), 2u * PERFORMANCE_FIGURES_COUNT * ACCELERATION_COUNT);
+    EXPECT_EQ(exporter.tables()[static_cast<std::size_t>(acceleration->parentTableIndex())].name(), "performanceFigures");
+    EXPECT_TRUE(car->column("discountedModel") == nullptr);
+
+    const Column *modelYear = car->column("modelYear");
+    const Column *capacity = car->column("engine.capacity");
+    const Column *vehicleCode = car->column("vehicleCode");
+    const Column *manufacturer = car->column("manufacturer");
+
+    ASSERT_TRUE(modelYear != nullptr && capacity != nullptr && vehicleCode != nullptr && manufacturer != nullptr);
+    EXPECT_EQ(modelYear->values<std::uint16_t>()[1], MODEL_YEAR);
+    EXPECT_EQ(capacity->values<std::uint16_t>()[1], engineCapacity);
+    EXPECT_EQ(vehicleCode->valueWidth(), static_cast<std::size_t>(VEHICLE_CODE_LENGTH));
+    EXPECT_EQ(std::string(reinterpret_cast<const char *>(vehicleCode->data()) + VEHICLE_CODE_LENGTH, VEHICLE_CODE_LENGTH),
+        std::string(VEHICLE_CODE, VEHICLE_CODE_LENGTH));
+    EXPECT_EQ(manufacturer->layout(), COLUMN_BINARY);
+    EXPECT_EQ(std::string(reinterpret_cast<const char *>(manufacturer->data()) + manufacturer->offsets()[1],
+        static_cast<std::size_t>(manufacturer->offsets()[2] - manufacturer->offsets()[1])), MANUFACTURER);
+
+    const Column *mph = acceleration->column("mph");
+    const Column *usageDescription = fuelFigures->column("usageDescription");
+
+    ASSERT_TRUE(mph != nullptr && usageDescription != nullptr);
+    EXPECT_EQ(mph->values<std::uint16_t>()[0], perf1aMph);
+    EXPECT_EQ(mph->values<std::uint16_t>()[5], perf2cMph);
+    EXPECT_EQ(acceleration->parentRowIndices()[5], 1);
+    EXPECT_EQ(fuelFigures->parentRowIndices()[FUEL_FIGURES_COUNT], 1);
+    EXPECT_EQ(usageDescription->offsets()[1], static_cast<std::int64_t>(std::strlen(FUEL_FIGURES_1_USAGE_DESCRIPTION)));
+
+    exporter.clear();
+    EXPECT_EQ(car->rowCount(), 0u);
+    EXPECT_EQ(acceleration->rowCount(), 0u);
+    EXPECT_THROW(
+        exporter.append(messageBuffer, length - 1, Car::sbeSchemaVersion(), Car::sbeBlockLength()), std::runtime_error);
+    EXPECT_EQ(car->rowCount(), 0u);
+}
+
+TEST_F(Rc3OtfFullIrTest, shouldIndexStreamAndDecodeInParallelInOrder)
+{
+    ASSERT_EQ(encodeHdrAndCar(), encodedCarAndHdrLength);
+
+    ASSERT_GE(m_irDecoder.decode(SCHEMA_FILENAME), 0);
+
+    const std::size_t messageCount = 100;
+    std::vector<char> stream;
+    for (std::size_t i = 0; i < messageCount; i++)
+    {
+        stream.insert(stream.end(), m_buffer, m_buffer + encodedCarAndHdrLength);
+    }
+
+    DecodePlanRegistry registry(m_irDecoder);
+    MessageIndex index;
+
+    StreamDecodeResult result = index.build(stream.data(), stream.size(), registry);
+    EXPECT_EQ(result.status, STREAM_COMPLETE);
+    ASSERT_EQ(index.size(), messageCount);
+    EXPECT_EQ(index[1].offset, encodedCarAndHdrLength);
+    EXPECT_EQ(index[1].templateId, static_cast<std::uint32_t>(Car::sbeTemplateId()));
+    EXPECT_EQ(index[1].length, encodedCarAndHdrLength - MessageHeader::encodedLength());
+
+    std::vector<int> mergedCounts;
+    OtfMessageDecoder::decodeParallel<MessageCountingListener>(
+        stream.data(),
+        index,
+        []() { return std::unique_ptr<MessageCountingListener>(new MessageCountingListener()); },
+        [&](MessageCountingListener& listener) { mergedCounts.push_back(listener.m_beginMessageCount); },
+        4,
+        7);
+
+    ASSERT_EQ(mergedCounts.size(), (messageCount + 6) / 7);
+    EXPECT_EQ(mergedCounts.front(), 7);
+    EXPECT_EQ(mergedCounts.back(), static_cast<int>(messageCount % 7));
+
+    EXPECT_THROW(
+        OtfMessageDecoder::decodeParallel<MessageCountingListener>(
+            stream.data(),
+            index,
+            []() -> std::unique_ptr<MessageCountingListener> { throw std::runtime_error("listener"); },
+            [](MessageCountingListener& listener) {},
+            4,
+            7),
+        std::runtime_error);
+}
+
+TEST_F(Rc3OtfFullIrTest, shouldReadFieldsThroughResolvedAccessors)
+{
+    ASSERT_EQ(encodeHdrAndCar(), encodedCarAndHdrLength);
+
+    ASSERT_GE(m_irDecoder.decode(SCHEMA_FILENAME), 0);
+
+    std::shared_ptr<std::vector<Token>> messageTokens = m_irDecoder.message(
+        Car::sbeTemplateId(), Car::sbeSchemaVersion());
+
+    ASSERT_TRUE(messageTokens != nullptr);
+
+    FieldAccessor serialNumber;
+    FieldAccessor modelYear;
+
+    for (std::size_t i = 0; i + 1 < messageTokens->size(); i++)
+    {
+        const Token& fieldToken = messageTokens->at(i);
+
+        if (Signal::BEGIN_FIELD == fieldToken.signal() && "serialNumber" == fieldToken.name())
+        {
+            serialNumber = FieldAccessor(messageTokens->at(i + 1));
+        }
+        else if (Signal::BEGIN_FIELD == fieldToken.signal() && "modelYear" == fieldToken.name())
+        {
+            modelYear = FieldAccessor(messageTokens->at(i + 1));
+        }
+    }
+
+    const char *messageBuffer = m_buffer + MessageHeader::encodedLength();
+
+    EXPECT_EQ(serialNumber.primitiveType(), PrimitiveType::UINT64);
+    EXPECT_EQ(serialNumber.getAsUInt(messageBuffer), static_cast<std::uint64_t>(SERIAL_NUMBER));
+    EXPECT_EQ(modelYear.getAsUInt(messageBuffer), static_cast<std::uint64_t>(MODEL_YEAR));
+    EXPECT_THROW(serialNumber.getAsInt(messageBuffer), std::runtime_error);
+    EXPECT_THROW(modelYear.getAsDouble(messageBuffer), std::runtime_error);
+}
+
+TEST_F(Rc3OtfFullIrTest, shouldDecodeAllChoicesOfSetTogether)
+{
+    ASSERT_EQ(encodeHdrAndCar(), encodedCarAndHdrLength);
+
+    ASSERT_GE(m_irDecoder.decode(SCHEMA_FILENAME), 0);
+
+    std::shared_ptr<std::vector<Token>> messageTokens = m_irDecoder.message(
+        Car::sbeTemplateId(), Car::sbeSchemaVersion());
+
+    ASSERT_TRUE(messageTokens != nullptr);
+
+    std::size_t beginSetIndex = 0;
+    std::size_t endSetIndex = 0;
+
+    for (std::size_t i = 0; i < messageTokens->size(); i++)
+    {
+        if (Signal::BEGIN_SET == messageTokens->at(i).signal() && 0 == beginSetIndex)
+        {
+            beginSetIndex = i;
+        }
+        else if (Signal::END_SET == messageTokens->at(i).signal() && 0 == endSetIndex)
+        {
+            endSetIndex = i;
+        }
+    }
+
+    ASSERT_LT(beginSetIndex, endSetIndex);
+
+    const BitSetDecoder extras(*messageTokens, beginSetIndex, endSetIndex);
+    const char *setBuffer = m_buffer + MessageHeader::encodedLength() + messageTokens->at(beginSetIndex).offset();
+    const std::uint64_t expectedMask =
+        (SUNROOF ? 0x1u : 0u) | (SPORTS_PACK ? 0x2u : 0u) | (CRUISE_CONTROL ? 0x4u : 0u);
+
+    ASSERT_EQ(extras.choiceCount(), static_cast<std::size_t>(3));
+    EXPECT_TRUE(extras.isSingleBit());
+    EXPECT_EQ(extras.choiceToken(2).name(), "cruiseControl");
+    EXPECT_EQ(extras.choiceMask(setBuffer), expectedMask);
+    EXPECT_EQ(extras.encode(expectedMask), extras.getEncodedValue(setBuffer));
+
+    std::uint64_t values[3];
+    extras.decode(extras.getEncodedValue(setBuffer), values);
+
+    for (std::size_t i = 0; i < extras.choiceCount(); i++)
+    {
+        EXPECT_EQ(values[i], extras.choiceToken(i).encoding().getBits(extras.getEncodedValue(setBuffer)));
+    }
+
+    const std::uint8_t lsb = 7;
+    const std::uint8_t msb = 4;
+    const Encoding reversedField(
+        PrimitiveType::UINT8, Presence::SBE_REQUIRED, ByteOrder::SBE_LITTLE_ENDIAN,
+        PrimitiveValue(PrimitiveType::UINT8, 0, nullptr),
+        PrimitiveValue(PrimitiveType::UINT8, 0, nullptr),
+        PrimitiveValue(PrimitiveType::UINT8, 0, nullptr),
+        PrimitiveValue(PrimitiveType::UINT8, 0, nullptr),
+        PrimitiveValue(PrimitiveType::UINT8, 1, reinterpret_cast<const char *>(&lsb)),
+        PrimitiveValue(PrimitiveType::UINT8, 1, reinterpret_cast<const char *>(&msb)),
+        "", "", "", "");
+
+    EXPECT_TRUE(reversedField.isBitReversed());
+    EXPECT_EQ(reversedField.bitLength(), static_cast<std::uint32_t>(4));
+    EXPECT_EQ(reversedField.getBits(0xA0), static_cast<std::uint64_t>(0x5));
+}
+
+class EnumNameListener : public OtfMessageDecoder::BasicTokenListener
+{
+public:
+    std::vector<std::string> m_names;
+
+    void onEnum(
+        Token& fieldToken,
+        const char *buffer,
+        std::vector<Token>& tokens,
+        std::size_t fromIndex,
+        std::size_t toIndex,
+        std::uint64_t actingVersion) override
+    {
+        const EnumIndex *enumIndex = tokens.at(fromIndex).enumIndex();
+
+        ASSERT_TRUE(enumIndex != nullptr);
+        EXPECT_EQ(enumIndex->toIndex(), toIndex);
+
+        if (!fieldToken.isConstantEncoding())
+        {
+            const Token *validValue = enumIndex->find(tokens, buffer);
+
+            ASSERT_TRUE(validValue != nullptr);
+            m_names.push_back(validValue->name());
+        }
+    }
+};
+
+TEST_F(Rc3OtfFullIrTest, shouldResolveEnumValuesThroughIndex)
+{
+    ASSERT_EQ(encodeHdrAndCar(), encodedCarAndHdrLength);
+
+    ASSERT_GE(m_irDecoder.decode(SCHEMA_FILENAME), 0);
+
+    std::shared_ptr<std::vector<Token>> messageTokens = m_irDecoder.message(
+        Car::sbeTemplateId(), Car::sbeSchemaVersion());
+
+    ASSERT_TRUE(messageTokens != nullptr);
+
+    EnumNameListener listener;
+    const char *messageBuffer = m_buffer + MessageHeader::encodedLength();
+    std::size_t length = static_cast<std::size_t>(encodedCarAndHdrLength - MessageHeader::encodedLength());
+
+    OtfMessageDecoder::decode(
+        messageBuffer, length, Car::sbeSchemaVersion(), Car::sbeBlockLength(), messageTokens, listener);
+
+    const std::vector<std::string> expectedNames = { "T", "A", "NITROUS" };
+    EXPECT_EQ(listener.m_names, expectedNames);
+
+    for (std::size_t i = 0; i < messageTokens->size(); i++)
+    {
+        const Token& token = messageTokens->at(i);
+
+        if (Signal::BEGIN_ENUM == token.signal())
+        {
+            const EnumIndex *enumIndex = token.enumIndex();
+
+            ASSERT_TRUE(enumIndex != nullptr);
+            EXPECT_EQ(enumIndex->find(-1), enumIndex->toIndex());
+
+            for (std::size_t j = i + 1; j < enumIndex->toIndex(); j++)
+            {
+                EXPECT_EQ(enumIndex->find(messageTokens->at(j).encoding().constValue().getAsInt()), j);
+            }
+        }
+    }
+}
+
+TEST_F(Rc3OtfFullIrTest, shouldPrintMessageAsSingleLineOfJson)
+{
+    ASSERT_EQ(encodeHdrAndCar(), encodedCarAndHdrLength);
+
+    ASSERT_GE(m_irDecoder.decode(SCHEMA_FILENAME), 0);
+
+    std::shared_ptr<std::vector<Token>> messageTokens = m_irDecoder.message(
+        Car::sbeTemplateId(), Car::sbeSchemaVersion());
+
+    ASSERT_TRUE(messageTokens != nullptr);
+
+    std::string output;
+    OtfJsonPrinter printer(output);
+    const char *messageBuffer = m_buffer + MessageHeader::encodedLength();
+    std::size_t length = static_cast<std::size_t>(encodedCarAndHdrLength - MessageHeader::encodedLength());
+
+    OtfMessageDecoder::decode(
+        messageBuffer, length, Car::sbeSchemaVersion(), Car::sbeBlockLength(), messageTokens, printer);
+
+    const std::string json = output;
+
+    ASSERT_FALSE(json.empty());
+    EXPECT_EQ(json.find('\n'), json.size() - 1);
+    EXPECT_EQ(json.compare(0, 16, "{\"serialNumber\":"), 0);
+    EXPECT_NE(json.find("\"available\":\"T\",\"code\":\"A\""), std::string::npos);
+    EXPECT_NE(json.find("\"someNumbers\":[0,1,2,3,4],\"vehicleCode\":\"abcdef\""), std::string::npos);
+    EXPECT_NE(json.find("\"extras\":{\"sunRoof\":false,\"sportsPack\":true,\"cruiseControl\":true}"), std::string::npos);
+    EXPECT_NE(json.find("\"discountedModel\":\"C\""), std::string::npos);
+    EXPECT_NE(json.find("\"maxRpm\":9000,\"manufacturerCode\":\"123\",\"fuel\":\"Petrol\""), std::string::npos);
+    EXPECT_NE(json.find("\"booster\":{\"BoostType\":\"NITROUS\""), std::string::npos);
+    EXPECT_NE(json.find("\"fuelFigures\":[{\"speed\":30,"), std::string::npos);
+    EXPECT_NE(json.find("\"usageDescription\":\"Highway Cycle\"}],\"performanceFigures\":[{"), std::string::npos);
+    EXPECT_NE(json.find("\"manufacturer\":\"Honda\",\"model\":\"Civic VTi\""), std::string::npos);
+    EXPECT_EQ(json.compare(json.size() - 15, 15, "\"color\":\"red\"}\n"), 0);
+
+    const std::size_t capacity = output.capacity();
+    output.clear();
+
+    OtfMessageDecoder::decode(
+        messageBuffer, length, Car::sbeSchemaVersion(), Car::sbeBlockLength(), messageTokens, printer);
+
+    EXPECT_EQ(output, json);
+    EXPECT_EQ(output.capacity(), capacity);
+
+    output.assign("prefix ");
+    OtfMessageDecoder::decode(
+        messageBuffer, length, Car::sbeSchemaVersion(), Car::sbeBlockLength(), messageTokens, printer);
+
+    EXPECT_EQ(output, "prefix " + json);
+
+    std::shared_ptr<std::vector<Token>> unindexedTokens = std::make_shared<std::vector<Token>>(*messageTokens);
+    for (std::size_t i = 0; i < unindexedTokens->size(); i++)
+    {
+        unindexedTokens->at(i).enumIndex(nullptr);
+    }
+
+    output.clear();
+    OtfMessageDecoder::decode(
+        messageBuffer, length, Car::sbeSchemaVersion(), Car::sbeBlockLength(), unindexedTokens, printer);
+
+    EXPECT_EQ(output, json);
+
+    output.clear();
+    printer.appendString("a\"b\\c\n\x01", 6);
+    printer.appendInt(INT64_MIN);
+    EXPECT_EQ(output, "\"a\\\"b\\\\c\\n\\u0001\"-9223372036854775808");
+
+    output.clear();
+    printer.appendString("caf\xe9", 4, true);
+    printer.appendHex("\x00\x7f\xff", 3);
+    EXPECT_EQ(output, "\"caf\\u00e9\"\"007fff\"");
+}
+
 TEST_P(Rc3OtfFullIrLengthTest, shouldExceptionIfLengthTooShort)
 {
     ASSERT_EQ(encodeHdrAndCar(), encodedCarAndHdrLength);
@@ -1194,6 +1879,35 @@ TEST_P(Rc3OtfFullIrLengthTest, shouldExceptionIfLengthTooShort)
     }, std::runtime_error);
 }
 
+TEST_P(Rc3OtfFullIrLengthTest, shouldExceptionIfLengthTooShortWithDecodePlan)
+{
+    ASSERT_EQ(encodeHdrAndCar(), encodedCarAndHdrLength);
+
+    ASSERT_GE(m_irDecoder.decode(SCHEMA_FILENAME), 0);
+
+    std::shared_ptr<std::vector<Token>> headerTokens = m_irDecoder.header();
+    std::shared_ptr<std::vector<Token>> messageTokens = m_irDecoder.message(
+        Car::sbeTemplateId(), Car::sbeSchemaVersion());
+
+    ASSERT_TRUE(headerTokens != nullptr);
+    ASSERT_TRUE(messageTokens!= nullptr);
+
+    OtfHeaderDecoder headerDecoder(headerTokens);
+    const DecodePlan plan(messageTokens);
+
+    std::size_t length = static_cast<std::size_t>(GetParam());
+    std::uint64_t actingVersion = headerDecoder.getSchemaVersion(m_buffer);
+    std::uint64_t blockLength = headerDecoder.getBlockLength(m_buffer);
+
+    EXPECT_THROW(
+    {
+        std::unique_ptr<char[]> decodeBuffer(new char[length]);
+
+        ::memcpy(decodeBuffer.get(), m_buffer + headerDecoder.encodedLength(), length);
+        OtfMessageDecoder::decode(decodeBuffer.get(), length, actingVersion, static_cast<std::size_t>(blockLength), plan, *this);
+    }, std::runtime_error);
+}
+
 INSTANTIATE_TEST_CASE_P(
     LengthUpToHdrAndCar,
     Rc3OtfFullIrLengthTest,
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2013-2020 Real Logic Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstring>
+#include <type_traits>
+
+#include "gtest/gtest.h"
+#include "version_pinned/version_pinned_cpp.h"
+
+using namespace version_pinned;
+
+static const std::uint64_t ORDER_ID = 17;
+static const std::uint32_t QUANTITY = 100;
+static const std::int64_t PRICE = -25;
+static const std::uint16_t VENUE = 7;
+static const char *NOTE = "partial";
+
+class VersionPinnedTest : public testing::Test
+{
+public:
+
+    std::uint64_t encodeOrder(char *buffer, std::uint64_t bufferLength)
+    {
+        Order order;
+        order.wrapForEncode(buffer, 0, bufferLength)
+            .orderId(ORDER_ID)
+            .quantity(QUANTITY);
+
+        order.fillsCount(1)
+            .next()
+            .price(PRICE)
+            .venue(VENUE);
+
+        order.putNote(NOTE, static_cast<std::uint8_t>(std::strlen(NOTE)));
+
+        return order.encodedLength();
+    }
+};
+
+struct OrderVisitor
+{
+    bool isPinned = false;
+    std::uint32_t quantity = 0;
+
+    template<typename Decoder>
+    void operator()(Decoder &decoder)
+    {
+        isPinned = std::is_same<Decoder, current_version::Order>::value;
+        quantity = decoder.quantity();
+    }
+};
+
+TEST_F(VersionPinnedTest, shouldDecodeCurrentVersionWithPinnedCodec)
+{
+    char buffer[64];
+    const std::uint64_t length = encodeOrder(buffer, sizeof(buffer));
+
+    OrderVisitor visitor;
+    current_version::Order::wrapForDecodeWith(
+        buffer, 0, Order::sbeBlockLength(), Order::sbeSchemaVersion(), length, visitor);
+
+    EXPECT_TRUE(visitor.isPinned);
+    EXPECT_EQ(visitor.quantity, QUANTITY);
+
+    current_version::Order decoder(buffer, length, Order::sbeBlockLength(), Order::sbeSchemaVersion());
+    EXPECT_EQ(decoder.orderId(), ORDER_ID);
+
+    current_version::OrderGroups::Fills &fills = decoder.fills();
+    ASSERT_TRUE(fills.hasNext());
+    fills.next();
+    EXPECT_EQ(fills.price(), PRICE);
+    EXPECT_EQ(fills.venue(), VENUE);
+    EXPECT_EQ(decoder.getNoteAsString(), NOTE);
+    EXPECT_EQ(decoder.encodedLength(), length);
+}
+
+TEST_F(VersionPinnedTest, shouldDecodeOlderVersionWithCheckedCodec)
+{
+    char buffer[64];
+    const std::uint64_t length = encodeOrder(buffer, sizeof(buffer));
+
+    OrderVisitor visitor;
+    current_version::Order::wrapForDecodeWith(buffer, 0, Order::sbeBlockLength(), 0, length, visitor);
+
+    EXPECT_FALSE(visitor.isPinned);
+    EXPECT_EQ(visitor.quantity, Order::quantityNullValue());
+}